@@ -195,6 +195,9 @@ public class CesiumRuntime : ModuleRules
                     "MaterialEditor"
                 }
             );
+
+            // Used by the performance tests to serve tiles from a local server.
+            PrivateDependencyModuleNames.Add("HTTPServer");
         }
 
         DynamicallyLoadedModuleNames.AddRange(
@@ -24,11 +24,14 @@
 #include "CesiumGltfPointsSceneProxyUpdater.h"
 #include "CesiumGltfPrimitiveComponent.h"
 #include "CesiumLifetime.h"
+#include "CesiumPhysicsMeshCache.h"
+#include "CesiumPhysicsMeshes.h"
 #include "CesiumRasterOverlay.h"
 #include "CesiumRuntime.h"
 #include "CesiumRuntimeSettings.h"
 #include "CesiumTextureUtility.h"
 #include "CesiumTileExcluder.h"
+#include "CesiumTilesetTransformComponent.h"
 #include "CesiumViewExtension.h"
 #include "Components/SceneCaptureComponent2D.h"
 #include "CreateGltfOptions.h"
@@ -45,9 +48,12 @@
 #include "LevelSequenceActor.h"
 #include "LevelSequencePlayer.h"
 #include "Math/UnrealMathUtility.h"
+#include "PhysicsEngine/BodySetup.h"
 #include "PixelFormat.h"
 #include "StereoRendering.h"
+#include "UnrealTaskProcessor.h"
 #include "VecMath.h"
+#include <algorithm>
 #include <glm/gtc/matrix_inverse.hpp>
 #include <memory>
 #include <glm/gtx/matrix_decompose.hpp>
@@ -63,6 +69,19 @@ FCesium3DTilesetLoadFailure OnCesium3DTilesetLoadFailure{};
 #include "LevelEditorViewport.h"
 #endif
 
+DECLARE_DWORD_COUNTER_STAT(
+  TEXT("Tile Component State Changes"),
+  STAT_CesiumTileStateChanges,
+  STATGROUP_Cesium);
+DECLARE_DWORD_COUNTER_STAT(
+  TEXT("Tile Primitives Created"),
+  STAT_CesiumTilePrimitivesCreated,
+  STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+  TEXT("Tiles Pending Creation"),
+  STAT_CesiumTilesPendingCreation,
+  STATGROUP_Cesium);
+
 // Avoid complaining about the deprecated metadata struct
 PRAGMA_DISABLE_DEPRECATION_WARNINGS
 
@@ -122,6 +141,10 @@ void ACesium3DTileset::SetMobility(EComponentMobility::Type NewMobility)
   if (NewMobility != this->RootComponent->Mobility)
   {
     this->RootComponent->SetMobility(NewMobility);
+    if (this->TilesetTransformComponent)
+    {
+      this->TilesetTransformComponent->SetMobility(NewMobility);
+    }
     DestroyTileset();
   }
 }
@@ -437,6 +460,16 @@ void ACesium3DTileset::SetCreatePhysicsMeshes(bool bCreatePhysicsMeshes)
   }
 }
 
+void ACesium3DTileset::SetCreatePhysicsMeshesOnDemand(
+  bool bCreatePhysicsMeshesOnDemand)
+{
+  if (this->CreatePhysicsMeshesOnDemand != bCreatePhysicsMeshesOnDemand)
+  {
+    this->CreatePhysicsMeshesOnDemand = bCreatePhysicsMeshesOnDemand;
+    this->DestroyTileset();
+  }
+}
+
 void ACesium3DTileset::SetCreateNavCollision(bool bCreateNavCollision)
 {
   if (this->CreateNavCollision != bCreateNavCollision)
@@ -464,6 +497,21 @@ void ACesium3DTileset::SetGenerateSmoothNormals(bool bGenerateSmoothNormals)
   }
 }
 
+void ACesium3DTileset::SetNativeTileCullingCallback(
+  FNativeTileCullingCallback Callback)
+{
+  this->_nativeTileCullingCallback = MoveTemp(Callback);
+}
+
+void ACesium3DTileset::SetWeldGeneratedVertices(bool bWeldGeneratedVertices)
+{
+  if (this->WeldGeneratedVertices != bWeldGeneratedVertices)
+  {
+    this->WeldGeneratedVertices = bWeldGeneratedVertices;
+    this->DestroyTileset();
+  }
+}
+
 void ACesium3DTileset::SetEnableWaterMask(bool bEnableMask)
 {
   if (this->EnableWaterMask != bEnableMask)
@@ -483,6 +531,16 @@ void ACesium3DTileset::SetIgnoreKhrMaterialsUnlit(
   }
 }
 
+void ACesium3DTileset::SetUseSharedTilesetTransform(
+  bool bUseSharedTilesetTransform)
+{
+  if (this->UseSharedTilesetTransform != bUseSharedTilesetTransform)
+  {
+    this->UseSharedTilesetTransform = bUseSharedTilesetTransform;
+    this->DestroyTileset();
+  }
+}
+
 void ACesium3DTileset::SetMaterial(UMaterialInterface* InMaterial)
 {
   if (this->Material != InMaterial)
@@ -678,16 +736,66 @@ ACesium3DTileset::GetCesiumTilesetToUnrealRelativeWorldTransform() const
     ->GetCesiumTilesetToUnrealRelativeWorldTransform();
 }
 
+const glm::dmat4& ACesium3DTileset::GetCesiumTilesetToGltfTransform() const
+{
+  static const glm::dmat4 identity(1.0);
+  return this->UseSharedTilesetTransform
+    ? identity
+    : this->GetCesiumTilesetToUnrealRelativeWorldTransform();
+}
+
+USceneComponent* ACesium3DTileset::GetGltfAttachParent()
+{
+  if (!this->UseSharedTilesetTransform)
+  {
+    return this->RootComponent;
+  }
+
+  if (!IsValid(this->TilesetTransformComponent))
+  {
+    this->TilesetTransformComponent =
+      NewObject<UCesiumTilesetTransformComponent>(
+        this,
+        TEXT("TilesetTransform"));
+    this->TilesetTransformComponent->SetFlags(
+      RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+    this->TilesetTransformComponent->SetMobility(
+      this->RootComponent->Mobility);
+    this->TilesetTransformComponent->SetupAttachment(this->RootComponent);
+    this->TilesetTransformComponent->RegisterComponent();
+    this->TilesetTransformComponent->UpdateTransformFromCesium(
+      this->GetCesiumTilesetToUnrealRelativeWorldTransform());
+  }
+
+  return this->TilesetTransformComponent;
+}
+
 void ACesium3DTileset::UpdateTransformFromCesium()
 {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateTransformFromCesium)
+
   const glm::dmat4& CesiumToUnreal =
     this->GetCesiumTilesetToUnrealRelativeWorldTransform();
-  TArray<UCesiumGltfComponent*> gltfComponents;
-  this->GetComponents<UCesiumGltfComponent>(gltfComponents);
 
-  for (UCesiumGltfComponent* pGltf : gltfComponents)
+  if (this->UseSharedTilesetTransform)
   {
-    pGltf->UpdateTransformFromCesium(CesiumToUnreal);
+    // The primitives are positioned relative to the shared transform, so
+    // moving it moves all of them.
+    if (IsValid(this->TilesetTransformComponent))
+    {
+      this->TilesetTransformComponent->UpdateTransformFromCesium(
+        CesiumToUnreal);
+    }
+  }
+  else
+  {
+    TArray<UCesiumGltfComponent*> gltfComponents;
+    this->GetComponents<UCesiumGltfComponent>(gltfComponents);
+
+    for (UCesiumGltfComponent* pGltf : gltfComponents)
+    {
+      pGltf->UpdateTransformFromCesium(CesiumToUnreal);
+    }
   }
 
   if (this->BoundingVolumePoolComponent)
@@ -816,7 +924,10 @@ public:
     CreateGltfOptions::CreateModelOptions options;
     options.pModel = pModel;
     options.alwaysIncludeTangents = this->_pActor->GetAlwaysIncludeTangents();
+    options.weldGeneratedVertices = this->_pActor->GetWeldGeneratedVertices();
     options.createPhysicsMeshes = this->_pActor->GetCreatePhysicsMeshes();
+    options.createPhysicsMeshesOnDemand =
+      this->_pActor->GetCreatePhysicsMeshesOnDemand();
 
     options.ignoreKhrMaterialsUnlit =
       this->_pActor->GetIgnoreKhrMaterialsUnlit();
@@ -853,17 +964,24 @@ public:
           pLoadThreadResult));
       const Cesium3DTilesSelection::TileRenderContent& renderContent =
         *content.getRenderContent();
-      return UCesiumGltfComponent::CreateOnGameThread(
+      // The primitives are created later, within the per-frame limits.
+      UCesiumGltfComponent* pGltf = UCesiumGltfComponent::CreateOnGameThread(
         renderContent.getModel(),
         this->_pActor,
         std::move(pHalf),
-        _pActor->GetCesiumTilesetToUnrealRelativeWorldTransform(),
+        this->_pActor->GetCesiumTilesetToGltfTransform(),
         this->_pActor->GetMaterial(),
         this->_pActor->GetTranslucentMaterial(),
         this->_pActor->GetWaterMaterial(),
         this->_pActor->GetCustomDepthParameters(),
         tile,
-        this->_pActor->GetCreateNavCollision());
+        this->_pActor->GetCreateNavCollision(),
+        true);
+      if (!pGltf->IsCreationComplete())
+      {
+        this->_pActor->_pendingGltfCreations.emplace_back(pGltf);
+      }
+      return pGltf;
     }
     // UE_LOG(LogCesium, VeryVerbose, TEXT("No content for tile"));
     return nullptr;
@@ -1052,9 +1170,11 @@ void ACesium3DTileset::UpdateLoadStatus()
     return;
   }
 
-  // If we have tiles to hide next frame, we haven't completely finished loading
-  // yet. We need to tick once more. We're really close to done.
-  if (!this->_tilesToHideNextFrame.empty())
+  // If we have tiles to hide next frame, or tiles that are still being
+  // created, we haven't completely finished loading yet. We need to tick once
+  // more. We're really close to done.
+  if (!this->_tilesToHideNextFrame.empty() ||
+    !this->_pendingGltfCreations.empty())
   {
     this->LoadProgress = glm::min(this->LoadProgress, 99.9999f);
     return;
@@ -1267,7 +1387,9 @@ void ACesium3DTileset::LoadTileset()
     };
 
   // Generous per-frame time limits for loading / unloading on main thread.
-  options.mainThreadLoadingTimeLimit = 5.0;
+  // Creating the Unreal components of loaded tiles is limited separately, see
+  // createPendingTiles.
+  options.mainThreadLoadingTimeLimit = this->MainThreadLoadingTimeLimit;
   options.tileCacheUnloadTimeLimit = 5.0;
 
   options.contentOptions.generateMissingNormalsSmooth =
@@ -1452,6 +1574,15 @@ void ACesium3DTileset::DestroyTileset()
   this->_pTileset->getAsyncDestructionCompleteEvent().thenInMainThread(
     [this]() { --this->_tilesetsBeingDestroyed; });
   this->_pTileset.Reset();
+  this->_pendingGltfCreations.clear();
+  this->_substituteTiles.clear();
+  this->_previousSubstituteTiles.clear();
+  this->_tilesReplacedBySubstitutes.clear();
+
+  if (this->_pPhysicsMeshCache)
+  {
+    this->_pPhysicsMeshCache->reset();
+  }
 
   switch (this->TilesetSource)
   {
@@ -1899,21 +2030,25 @@ namespace
 {
   void removeVisibleTilesFromList(
     std::vector<Cesium3DTilesSelection::Tile*>& list,
-    const std::vector<Cesium3DTilesSelection::Tile*>& visibleTiles)
+    const std::vector<Cesium3DTilesSelection::Tile*>& visibleTiles,
+    std::unordered_set<Cesium3DTilesSelection::Tile*>& visibleTileSet)
   {
     if (list.empty())
     {
       return;
     }
 
-    for (Cesium3DTilesSelection::Tile* pTile : visibleTiles)
-    {
-      auto it = std::find(list.begin(), list.end(), pTile);
-      if (it != list.end())
-      {
-        list.erase(it);
-      }
-    }
+    visibleTileSet.clear();
+    visibleTileSet.insert(visibleTiles.begin(), visibleTiles.end());
+    list.erase(
+      std::remove_if(
+        list.begin(),
+        list.end(),
+        [&visibleTileSet](Cesium3DTilesSelection::Tile* pTile)
+        {
+          return visibleTileSet.find(pTile) != visibleTileSet.end();
+        }),
+      list.end());
   }
 
   /**
@@ -1924,8 +2059,11 @@ namespace
    * are made invisible by this call.
    *
    * @param tiles The tiles to hide
+   * @param hide Called with the visible glTF of each tile to hide
    */
-  void hideTiles(const std::vector<Cesium3DTilesSelection::Tile*>& tiles)
+  void hideTiles(
+    const std::vector<Cesium3DTilesSelection::Tile*>& tiles,
+    TFunctionRef<void(UCesiumGltfComponent*)> hide)
   {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::HideTiles)
     for (Cesium3DTilesSelection::Tile* pTile : tiles)
@@ -1947,8 +2085,7 @@ namespace
         pRenderContent->getRenderResources());
       if (Gltf && Gltf->IsVisible())
       {
-        TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetVisibilityFalse)
-        Gltf->SetVisibility(false, true);
+        hide(Gltf);
       }
       else
       {
@@ -1986,10 +2123,12 @@ namespace
 
       UCesiumGltfComponent* Gltf = static_cast<UCesiumGltfComponent*>(
         pRenderContent->getRenderResources());
-      if (Gltf)
+      if (Gltf &&
+        Gltf->RenderState.collisionEnabled != ECollisionEnabled::NoCollision)
       {
         TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetCollisionDisabled)
         Gltf->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+        INC_DWORD_STAT(STAT_CesiumTileStateChanges);
       }
     }
   }
@@ -1998,9 +2137,11 @@ namespace
    * @brief Applies the actor collision settings for a newly created glTF
    * component
    *
-   * TODO Add details here what that means
-   * @param BodyInstance ...
-   * @param Gltf ...
+   * The collision object type and channel responses of the tileset's
+   * BodyInstance are copied to each primitive of the glTF.
+   *
+   * @param BodyInstance The tileset's body instance.
+   * @param Gltf The glTF component to update.
    */
   void applyActorCollisionSettings(
     const FBodyInstance& BodyInstance,
@@ -2061,6 +2202,7 @@ void ACesium3DTileset::updateTilesetOptionsFromProperties()
     this->CulledScreenSpaceError;
   options.enableLodTransitionPeriod = this->UseLodTransitions;
   options.lodTransitionLength = this->LodTransitionLength;
+  options.mainThreadLoadingTimeLimit = this->MainThreadLoadingTimeLimit;
   // options.kickDescendantsWhileFadingIn = false;
 }
 
@@ -2128,6 +2270,24 @@ void ACesium3DTileset::showTilesToRender(
 {
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ShowTilesToRender)
 
+  // Only tiles whose collision settings are out of date need to be updated,
+  // so detect changes to the actor's settings once for all tiles.
+  const ECollisionChannel CollisionObjectType = BodyInstance.GetObjectType();
+  const FCollisionResponseContainer& CollisionResponses =
+    BodyInstance.GetResponseToChannels();
+  if (this->_collisionSettingsVersion == 0 ||
+    CollisionObjectType != this->_appliedCollisionObjectType ||
+    !(CollisionResponses == this->_appliedCollisionResponses))
+  {
+    ++this->_collisionSettingsVersion;
+    this->_appliedCollisionObjectType = CollisionObjectType;
+    this->_appliedCollisionResponses = CollisionResponses;
+  }
+
+  const ECollisionEnabled::Type CollisionEnabled =
+    this->CreatePhysicsMeshes ? ECollisionEnabled::QueryAndPhysics
+                              : ECollisionEnabled::NoCollision;
+
   for (Cesium3DTilesSelection::Tile* pTile : tiles)
   {
     if (pTile->getState() != Cesium3DTilesSelection::TileLoadState::Done)
@@ -2162,14 +2322,29 @@ void ACesium3DTileset::showTilesToRender(
       continue;
     }
 
-    applyActorCollisionSettings(BodyInstance, Gltf);
+    if (!Gltf->IsCreationComplete())
+    {
+      // Some of the primitives have not been created yet. Showing the tile
+      // now would show only part of it, so its nearest complete ancestor is
+      // shown instead, see substituteIncompleteTiles.
+      continue;
+    }
+
+    if (Gltf->RenderState.collisionSettingsVersion !=
+      this->_collisionSettingsVersion)
+    {
+      applyActorCollisionSettings(BodyInstance, Gltf);
+      Gltf->RenderState.collisionSettingsVersion =
+        this->_collisionSettingsVersion;
+      INC_DWORD_STAT(STAT_CesiumTileStateChanges);
+    }
 
     if (Gltf->GetAttachParent() == nullptr)
     {
       // The AttachToComponent method is ridiculously complex,
       // so print a warning if attaching fails for some reason
       bool attached = Gltf->AttachToComponent(
-        this->RootComponent,
+        this->GetGltfAttachParent(),
         FAttachmentTransformRules::KeepRelativeTransform);
       if (!attached)
       {
@@ -2185,22 +2360,228 @@ void ACesium3DTileset::showTilesToRender(
       }
     }
 
-    if (!Gltf->IsVisible())
+    this->queueTileVisibility(Gltf, true);
+
+    if (Gltf->RenderState.collisionEnabled != CollisionEnabled)
+    {
+      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetCollisionEnabled)
+      Gltf->SetCollisionEnabled(CollisionEnabled);
+      INC_DWORD_STAT(STAT_CesiumTileStateChanges);
+    }
+  }
+}
+
+void ACesium3DTileset::createPendingTiles()
+{
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CreatePendingTiles)
+
+  double timeLimitSeconds = this->MainThreadLoadingTimeLimit / 1000.0;
+  if (this->MainThreadLoadingTargetFrameRate > 0.0f &&
+    this->_averageFrameSeconds > 0.0f)
+  {
+    const double targetFrameSeconds =
+      1.0 / this->MainThreadLoadingTargetFrameRate;
+    timeLimitSeconds *= FMath::Clamp(
+      targetFrameSeconds / this->_averageFrameSeconds,
+      0.25,
+      1.0);
+  }
+
+  const double endTimeSeconds = timeLimitSeconds > 0.0
+                                  ? FPlatformTime::Seconds() + timeLimitSeconds
+                                  : TNumericLimits<double>::Max();
+
+  int32 tilesCreated = 0;
+  int32 primitivesCreated = 0;
+  while (!this->_pendingGltfCreations.empty())
+  {
+    UCesiumGltfComponent* pGltf = this->_pendingGltfCreations.front().Get();
+    if (!pGltf || pGltf->IsCreationComplete())
     {
-      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetVisibilityTrue)
-      Gltf->SetVisibility(true, true);
+      // The tile was unloaded before it was completely created.
+      this->_pendingGltfCreations.pop_front();
+      continue;
     }
 
+    const bool overBudget =
+      (this->MaximumTilesCreatedPerFrame > 0 &&
+        tilesCreated >= this->MaximumTilesCreatedPerFrame) ||
+      (this->MaximumPrimitivesCreatedPerFrame > 0 &&
+        primitivesCreated >= this->MaximumPrimitivesCreatedPerFrame) ||
+      FPlatformTime::Seconds() >= endTimeSeconds;
+    // Create at least one primitive per frame, so that loading progresses
+    // even with a tiny budget.
+    if (overBudget && primitivesCreated > 0)
     {
-      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetCollisionEnabled)
-      Gltf->SetCollisionEnabled(this->CreatePhysicsMeshes
-                                  ? ECollisionEnabled::QueryAndPhysics
-                                  : ECollisionEnabled::NoCollision);
+      break;
+    }
+
+    const int32 maximumPrimitives =
+      this->MaximumPrimitivesCreatedPerFrame > 0
+        ? FMath::Max(
+            this->MaximumPrimitivesCreatedPerFrame - primitivesCreated,
+            1)
+        : 0;
+    primitivesCreated +=
+      pGltf->ContinueCreation(maximumPrimitives, endTimeSeconds);
+
+    if (!pGltf->IsCreationComplete())
+    {
+      break;
+    }
+
+    this->_pendingGltfCreations.pop_front();
+    ++tilesCreated;
+  }
+
+  INC_DWORD_STAT_BY(STAT_CesiumTilePrimitivesCreated, primitivesCreated);
+  SET_DWORD_STAT(
+    STAT_CesiumTilesPendingCreation,
+    this->_pendingGltfCreations.size());
+}
+
+namespace
+{
+  /**
+   * @brief Gets the glTF of the given tile, if the tile is loaded and all
+   * of its primitives have been created.
+   */
+  UCesiumGltfComponent*
+  getCompleteGltf(const Cesium3DTilesSelection::Tile& tile)
+  {
+    if (tile.getState() != Cesium3DTilesSelection::TileLoadState::Done)
+    {
+      return nullptr;
+    }
+
+    const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
+      tile.getContent().getRenderContent();
+    if (!pRenderContent)
+    {
+      return nullptr;
+    }
+
+    UCesiumGltfComponent* pGltf = static_cast<UCesiumGltfComponent*>(
+      pRenderContent->getRenderResources());
+    return pGltf && pGltf->IsCreationComplete() ? pGltf : nullptr;
+  }
+} // namespace
+
+void ACesium3DTileset::substituteIncompleteTiles(
+  Cesium3DTilesSelection::ViewUpdateResult& result)
+{
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SubstituteIncompleteTiles)
+
+  std::swap(this->_substituteTiles, this->_previousSubstituteTiles);
+  this->_substituteTiles.clear();
+  this->_tilesReplacedBySubstitutes.clear();
+
+  std::vector<Cesium3DTilesSelection::Tile*>& tiles =
+    result.tilesToRenderThisFrame;
+  for (Cesium3DTilesSelection::Tile* pTile : tiles)
+  {
+    const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
+      pTile->getContent().getRenderContent();
+    const UCesiumGltfComponent* pGltf =
+      pRenderContent ? static_cast<const UCesiumGltfComponent*>(
+                         pRenderContent->getRenderResources())
+                     : nullptr;
+    if (!pGltf || pGltf->IsCreationComplete())
+    {
+      continue;
+    }
+
+    // Without a complete ancestor, nothing can be shown until the tile is
+    // created.
+    for (Cesium3DTilesSelection::Tile* pAncestor = pTile->getParent();
+         pAncestor;
+         pAncestor = pAncestor->getParent())
+    {
+      if (getCompleteGltf(*pAncestor))
+      {
+        this->_substituteTiles.insert(pAncestor);
+        break;
+      }
+    }
+  }
+
+  if (!this->_substituteTiles.empty())
+  {
+    // A substitute replaces all of its descendants, so that complete
+    // siblings of the incomplete tiles do not overlap it.
+    auto isReplaced = [this](Cesium3DTilesSelection::Tile* pTile)
+    {
+      for (Cesium3DTilesSelection::Tile* pAncestor = pTile->getParent();
+           pAncestor;
+           pAncestor = pAncestor->getParent())
+      {
+        if (this->_substituteTiles.count(pAncestor))
+        {
+          return true;
+        }
+      }
+      return false;
+    };
+
+    auto replacedBegin = std::stable_partition(
+      tiles.begin(),
+      tiles.end(),
+      [&isReplaced](Cesium3DTilesSelection::Tile* pTile)
+      {
+        return !isReplaced(pTile);
+      });
+    this->_tilesReplacedBySubstitutes.assign(replacedBegin, tiles.end());
+    tiles.erase(replacedBegin, tiles.end());
+
+    for (Cesium3DTilesSelection::Tile* pSubstitute : this->_substituteTiles)
+    {
+      result.tilesFadingOut.erase(pSubstitute);
+      if (isReplaced(pSubstitute))
+      {
+        // An ancestor of this substitute is a substitute, too.
+        this->_tilesReplacedBySubstitutes.push_back(pSubstitute);
+      }
+      else
+      {
+        tiles.push_back(pSubstitute);
+      }
+    }
+  }
+
+  for (Cesium3DTilesSelection::Tile* pTile : this->_previousSubstituteTiles)
+  {
+    if (!this->_substituteTiles.count(pTile))
+    {
+      this->_tilesReplacedBySubstitutes.push_back(pTile);
     }
   }
 }
 
-static void updateTileFade(Cesium3DTilesSelection::Tile* pTile, bool fadingIn)
+ACesium3DTileset::PendingTileRenderState&
+ACesium3DTileset::getPendingTileRenderState(UCesiumGltfComponent* pGltf)
+{
+  auto [it, added] = this->_pendingTileRenderStateIndices.try_emplace(
+    pGltf,
+    this->_pendingTileRenderStates.size());
+  if (added)
+  {
+    this->_pendingTileRenderStates.push_back({pGltf});
+  }
+  return this->_pendingTileRenderStates[it->second];
+}
+
+void ACesium3DTileset::queueTileVisibility(
+  UCesiumGltfComponent* pGltf,
+  bool visible)
+{
+  PendingTileRenderState& pending = this->getPendingTileRenderState(pGltf);
+  pending.hasVisible = true;
+  pending.visible = visible;
+}
+
+void ACesium3DTileset::queueTileFade(
+  Cesium3DTilesSelection::Tile* pTile,
+  bool fadingIn)
 {
   if (!pTile || !pTile->getContent().isRenderContent())
   {
@@ -2227,10 +2608,42 @@ static void updateTileFade(Cesium3DTilesSelection::Tile* pTile, bool fadingIn)
     return;
   }
 
-  float percentage =
-    pTile->getContent().getRenderContent()->getLodTransitionFadePercentage();
+  PendingTileRenderState& pending = this->getPendingTileRenderState(pGltf);
+  pending.hasFade = true;
+  // A substitute for incomplete tiles is shown completely, even if it had
+  // started fading out.
+  pending.fadePercentage =
+    fadingIn && this->_substituteTiles.count(pTile)
+      ? 1.0f
+      : pRenderContent->getLodTransitionFadePercentage();
+  pending.fadingIn = fadingIn;
+}
+
+void ACesium3DTileset::flushTileRenderStates()
+{
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::FlushTileRenderStates)
 
-  pGltf->UpdateFade(percentage, fadingIn);
+  // Visibility first, because fades are only applied to visible tiles.
+  for (const PendingTileRenderState& pending : this->_pendingTileRenderStates)
+  {
+    if (pending.hasVisible && pending.pGltf->IsVisible() != pending.visible)
+    {
+      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetVisibility)
+      pending.pGltf->SetVisibility(pending.visible, true);
+      INC_DWORD_STAT(STAT_CesiumTileStateChanges);
+    }
+  }
+
+  for (const PendingTileRenderState& pending : this->_pendingTileRenderStates)
+  {
+    if (pending.hasFade)
+    {
+      pending.pGltf->UpdateFade(pending.fadePercentage, pending.fadingIn);
+    }
+  }
+
+  this->_pendingTileRenderStates.clear();
+  this->_pendingTileRenderStateIndices.clear();
 }
 
 FBoxSphereBounds GetTileBounds(const glm::dmat4& Matrix, Cesium3DTilesSelection::Tile* pTile, bool& HasRenderContent)
@@ -2244,35 +2657,10 @@ FBoxSphereBounds GetTileBounds(const glm::dmat4& Matrix, Cesium3DTilesSelection:
     const auto Gltf = static_cast<UCesiumGltfComponent*>(pRenderContent->getRenderResources());
     if (Gltf)
     {
-      FBoxSphereBounds CombinedBounds;
-      bool FoundBounds = false;
-      for (const auto& Child : Gltf->GetAttachChildren())
+      const FBoxSphereBounds* pGltfBounds = Gltf->GetWorldBounds();
+      if (pGltfBounds)
       {
-        if (Child->IsA<UCesiumGltfPrimitiveComponent>())
-        {
-          const auto Primitive = Cast<UCesiumGltfPrimitiveComponent>(Child);
-          if (Primitive && Primitive->IsVisible())
-          {
-            const auto& PrimitiveBounds = Primitive->CalcBounds(Primitive->GetComponentTransform());
-            if (PrimitiveBounds.SphereRadius > 0)
-            {
-              if (FoundBounds)
-              {
-                CombinedBounds = CombinedBounds + PrimitiveBounds;
-              }
-              else
-              {
-                CombinedBounds = PrimitiveBounds;
-              }
-              FoundBounds = true;
-            }
-          }
-        }
-      }
-
-      if (FoundBounds)
-      {
-        return CombinedBounds;
+        return *pGltfBounds;
       }
     }
   }
@@ -2350,6 +2738,15 @@ void ACesium3DTileset::Tick(float DeltaTime)
 
   updateTilesetOptionsFromProperties();
 
+  if (DeltaTime > 0.0f)
+  {
+    // An exponential moving average over roughly the last ten frames.
+    this->_averageFrameSeconds =
+      this->_averageFrameSeconds > 0.0f
+        ? FMath::Lerp(this->_averageFrameSeconds, DeltaTime, 0.1f)
+        : DeltaTime;
+  }
+
   std::vector<FCesiumCamera> cameras = this->GetCameras();
   if (cameras.empty())
   {
@@ -2379,18 +2776,26 @@ void ACesium3DTileset::Tick(float DeltaTime)
       CreateViewStateFromViewParameters(camera, unrealWorldToCesiumTileset));
   }
 
+  // The tile loads started by the view update are for the current view, so
+  // they are decoded ahead of other background work.
   const Cesium3DTilesSelection::ViewUpdateResult* pResult;
   if (this->_captureMovieMode)
   {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::updateViewOffline)
+    UnrealTaskProcessor::ScopedLane taskLane(UnrealTaskProcessor::Lane::High);
     pResult = &this->_pTileset->updateViewOffline(frustums);
   }
   else
   {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::updateView)
+    UnrealTaskProcessor::ScopedLane taskLane(UnrealTaskProcessor::Lane::High);
     pResult = &this->_pTileset->updateView(frustums, DeltaTime);
   }
 
+  // Create the tiles that were loaded by this or earlier view updates, before
+  // deciding which tiles to show.
+  this->createPendingTiles();
+
   /// BEGIN FF CHANGES
   if (EvaluateCustomTileCulling || EvaluateTileCullingIntersection)
   {
@@ -2416,63 +2821,89 @@ void ACesium3DTileset::Tick(float DeltaTime)
     TileBoundsMax = FVector(FLT_MIN, FLT_MIN, FLT_MIN);
     TileBoundsMin = FVector(FLT_MAX, FLT_MAX, FLT_MAX);
 
-    for (const auto Tile : pResult->tilesToRenderThisFrame)
+    // Gather the bounds of all candidate tiles first, so that they can be
+    // tested as one batch.
     {
-      if (Tile != nullptr)
+      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::GatherTileCullingBounds)
+      const int32 CandidateCount = int32(pResult->tilesToRenderThisFrame.size());
+      this->_tileCullingCandidates.clear();
+      this->_tileCullingCandidates.reserve(CandidateCount);
+      this->_tileCullingBounds.Reset(CandidateCount);
+      this->_tileCullingHasRenderContent.Reset(CandidateCount);
+
+      for (const auto Tile : pResult->tilesToRenderThisFrame)
       {
-        bool IsCulled = false;
-        bool HasRenderContent = false;
-        const auto& UnrealTileBounds = GetTileBounds(CombinedMatrix, Tile, HasRenderContent);
-        if (EvaluateCustomTileCulling)
+        if (Tile != nullptr)
         {
-          IsCulled = this->CustomIsTileCulled(UnrealTileBounds.Origin, UnrealTileBounds.BoxExtent);
-
-          if (DrawTileCullingDebug)
-          {
-            DrawDebugBox(
-              this->GetWorld(),
-              UnrealTileBounds.Origin,
-              UnrealTileBounds.BoxExtent,
-              IsCulled ? FColor::Red : FColor::Green,
-              false,
-              0,
-              1,
-              IsCulled ? 0.25 : 0.5);
-          }
+          bool HasRenderContent = false;
+          this->_tileCullingBounds.Add(GetTileBounds(CombinedMatrix, Tile, HasRenderContent));
+          this->_tileCullingHasRenderContent.Add(HasRenderContent);
+          this->_tileCullingCandidates.push_back(Tile);
         }
-        else if (EvaluateTileCullingIntersection)
-        {
-          IsCulled = !TileCullingIntersectionBox.Intersect(UnrealTileBounds.GetBox());
+      }
+    }
 
-          if (DrawTileCullingDebug)
-          {
-            DrawDebugBox(
-              this->GetWorld(),
-              UnrealTileBounds.GetBox().GetCenter(),
-              UnrealTileBounds.GetBox().GetExtent(),
-              IsCulled ? FColor::Red : FColor::Green,
-              false,
-              0,
-              1,
-              IsCulled ? 0.25 : 0.5);
-          }
-        }
+    const FCesiumTileBoundsBatch& Bounds = this->_tileCullingBounds;
+    TArray<bool>& Culled = this->_tileCullingCulled;
+    Culled.Init(false, Bounds.Num());
 
-        if (!IsCulled)
+    {
+      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::EvaluateTileCulling)
+      if (EvaluateCustomTileCulling)
+      {
+        if (this->_nativeTileCullingCallback)
         {
-          TileBoundsMin = FVector::Min(TileBoundsMin, UnrealTileBounds.Origin - UnrealTileBounds.BoxExtent);
-          TileBoundsMax = FVector::Max(TileBoundsMax, UnrealTileBounds.Origin + UnrealTileBounds.BoxExtent);
-          ChangedRenderEntries.push_back(Tile);
+          this->_nativeTileCullingCallback(Bounds, Culled);
         }
         else
         {
-          if (HasRenderContent)
+          for (int32 i = 0; i < Bounds.Num(); ++i)
           {
-            ChangedTilesFadingOut.insert(Tile);
+            Culled[i] = this->CustomIsTileCulled(Bounds.GetCenter(i), Bounds.GetExtent(i));
           }
-          TilesCulled++;
         }
       }
+      else if (EvaluateTileCullingIntersection)
+      {
+        CesiumTileCulling::cullOutsideBox(Bounds, TileCullingIntersectionBox, Culled);
+      }
+    }
+
+    ChangedRenderEntries.reserve(this->_tileCullingCandidates.size());
+    for (int32 i = 0; i < Bounds.Num(); ++i)
+    {
+      const bool IsCulled = Culled[i];
+      const FVector Center = Bounds.GetCenter(i);
+      const FVector Extent = Bounds.GetExtent(i);
+
+      if (DrawTileCullingDebug)
+      {
+        DrawDebugBox(
+          this->GetWorld(),
+          Center,
+          Extent,
+          IsCulled ? FColor::Red : FColor::Green,
+          false,
+          0,
+          1,
+          IsCulled ? 0.25 : 0.5);
+      }
+
+      Cesium3DTilesSelection::Tile* Tile = this->_tileCullingCandidates[i];
+      if (!IsCulled)
+      {
+        TileBoundsMin = FVector::Min(TileBoundsMin, Center - Extent);
+        TileBoundsMax = FVector::Max(TileBoundsMax, Center + Extent);
+        ChangedRenderEntries.push_back(Tile);
+      }
+      else
+      {
+        if (this->_tileCullingHasRenderContent[i])
+        {
+          ChangedTilesFadingOut.insert(Tile);
+        }
+        TilesCulled++;
+      }
     }
 
     if (DrawTileCullingDebug)
@@ -2498,12 +2929,22 @@ void ACesium3DTileset::Tick(float DeltaTime)
 
   updateLastViewUpdateResultState(*pResult);
 
+  // The result is changed in place, like the culling above does.
+  this->substituteIncompleteTiles(
+    *const_cast<Cesium3DTilesSelection::ViewUpdateResult*>(pResult));
+
   removeCollisionForTiles(pResult->tilesFadingOut);
 
   removeVisibleTilesFromList(
     _tilesToHideNextFrame,
-    pResult->tilesToRenderThisFrame);
-  hideTiles(_tilesToHideNextFrame);
+    pResult->tilesToRenderThisFrame,
+    _tilesRenderedThisFrame);
+  hideTiles(
+    _tilesToHideNextFrame,
+    [this](UCesiumGltfComponent* Gltf)
+    {
+      this->queueTileVisibility(Gltf, false);
+    });
 
   _tilesToHideNextFrame.clear();
   for (Cesium3DTilesSelection::Tile* pTile : pResult->tilesFadingOut)
@@ -2517,9 +2958,18 @@ void ACesium3DTileset::Tick(float DeltaTime)
       _tilesToHideNextFrame.push_back(pTile);
     }
   }
+  _tilesToHideNextFrame.insert(
+    _tilesToHideNextFrame.end(),
+    this->_tilesReplacedBySubstitutes.begin(),
+    this->_tilesReplacedBySubstitutes.end());
 
   showTilesToRender(pResult->tilesToRenderThisFrame);
 
+  if (this->CreatePhysicsMeshes && this->CreatePhysicsMeshesOnDemand)
+  {
+    this->updatePhysicsMeshCache(pResult->tilesToRenderThisFrame);
+  }
+
   if (this->UseLodTransitions)
   {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateTileFades)
@@ -2527,18 +2977,171 @@ void ACesium3DTileset::Tick(float DeltaTime)
     for (Cesium3DTilesSelection::Tile* pTile :
          pResult->tilesToRenderThisFrame)
     {
-      updateTileFade(pTile, true);
+      queueTileFade(pTile, true);
     }
 
     for (Cesium3DTilesSelection::Tile* pTile : pResult->tilesFadingOut)
     {
-      updateTileFade(pTile, false);
+      queueTileFade(pTile, false);
     }
   }
 
+  this->flushTileRenderStates();
+
   this->UpdateLoadStatus();
 }
 
+void ACesium3DTileset::updatePhysicsMeshCache(
+  const std::vector<Cesium3DTilesSelection::Tile*>& tiles)
+{
+  this->_physicsMeshCandidates.Reset();
+  for (Cesium3DTilesSelection::Tile* pTile : tiles)
+  {
+    const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
+      pTile->getContent().getRenderContent();
+    if (!pRenderContent)
+    {
+      continue;
+    }
+
+    UCesiumGltfComponent* Gltf = static_cast<UCesiumGltfComponent*>(
+      pRenderContent->getRenderResources());
+    if (!Gltf || !Gltf->IsCreationComplete())
+    {
+      continue;
+    }
+
+    for (USceneComponent* pChild : Gltf->GetAttachChildren())
+    {
+      UCesiumGltfPrimitiveComponent* pPrimitive =
+        Cast<UCesiumGltfPrimitiveComponent>(pChild);
+      if (pPrimitive)
+      {
+        this->_physicsMeshCandidates.Add(pPrimitive);
+      }
+    }
+  }
+
+  if (!this->_pPhysicsMeshCache)
+  {
+    this->_pPhysicsMeshCache =
+      MakeShared<FCesiumPhysicsMeshCache, ESPMode::ThreadSafe>();
+  }
+
+  this->_pPhysicsMeshCache->update(
+    this->GetWorld(),
+    this->_physicsMeshCandidates,
+    this->MaximumPhysicsMeshBuildsPerFrame,
+    this->MaximumCachedPhysicsMeshes);
+}
+
+bool ACesium3DTileset::LineTraceTiles(
+  const FVector& Start,
+  const FVector& End,
+  FHitResult& OutHit)
+{
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LineTraceTiles)
+
+  const FVector direction = End - Start;
+  const FCollisionQueryParams params(
+    SCENE_QUERY_STAT(CesiumLineTraceTiles),
+    true);
+  bool found = false;
+
+  // Unlike GetGltfAttachParent, this must not create the shared transform
+  // component. Without it, no tile has been attached to it yet.
+  const USceneComponent* pGltfParent =
+    this->UseSharedTilesetTransform &&
+        IsValid(this->TilesetTransformComponent)
+      ? this->TilesetTransformComponent
+      : this->RootComponent;
+  if (!pGltfParent)
+  {
+    return false;
+  }
+
+  for (USceneComponent* pGltfChild : pGltfParent->GetAttachChildren())
+  {
+    UCesiumGltfComponent* Gltf = Cast<UCesiumGltfComponent>(pGltfChild);
+    if (!Gltf || !Gltf->IsVisible())
+    {
+      continue;
+    }
+
+    for (USceneComponent* pChild : Gltf->GetAttachChildren())
+    {
+      UCesiumGltfPrimitiveComponent* pPrimitive =
+        Cast<UCesiumGltfPrimitiveComponent>(pChild);
+      if (!pPrimitive || !pPrimitive->IsVisible() ||
+        !CollisionEnabledHasQuery(pPrimitive->GetCollisionEnabled()) ||
+        !FMath::LineBoxIntersection(
+          pPrimitive->Bounds.GetBox(),
+          Start,
+          End,
+          direction))
+      {
+        continue;
+      }
+
+      FHitResult hit;
+      UBodySetup* pBodySetup = pPrimitive->GetBodySetup();
+      if (pBodySetup && !pBodySetup->ChaosTriMeshes.IsEmpty())
+      {
+        if (!pPrimitive->LineTraceComponent(hit, Start, End, params))
+        {
+          continue;
+        }
+      }
+      else if (pPrimitive->pPhysicsMeshSource)
+      {
+        // Trace against the triangles directly rather than building a
+        // physics mesh for a single trace.
+        const FTransform& transform = pPrimitive->GetComponentTransform();
+        CesiumPhysicsMeshes::LineTraceHit localHit;
+        if (!CesiumPhysicsMeshes::lineTrace(
+              *pPrimitive->pPhysicsMeshSource,
+              transform.InverseTransformPosition(Start),
+              transform.InverseTransformPosition(End),
+              localHit))
+        {
+          continue;
+        }
+
+        // Normals transform by the inverse transpose, in case of non-uniform
+        // scale.
+        const FVector normal = transform.ToMatrixWithScale()
+                                 .InverseFast()
+                                 .GetTransposed()
+                                 .TransformVector(localHit.normal)
+                                 .GetSafeNormal();
+        hit = FHitResult(
+          this,
+          pPrimitive,
+          Start + direction * localHit.time,
+          normal);
+        hit.bBlockingHit = true;
+        hit.Time = localHit.time;
+        hit.Distance = direction.Size() * localHit.time;
+        hit.TraceStart = Start;
+        hit.TraceEnd = End;
+        hit.FaceIndex = localHit.faceIndex;
+      }
+      else
+      {
+        continue;
+      }
+
+      if (!found || hit.Time < OutHit.Time)
+      {
+        OutHit = hit;
+        found = true;
+      }
+    }
+  }
+
+  return found;
+}
+
 void ACesium3DTileset::HideAllTiles()
 {
   if (!IsValid(GetWorld()))
@@ -2557,7 +3160,13 @@ void ACesium3DTileset::HideAllTiles()
 
   removeCollisionForTiles(AllTilesSet);
   std::vector<Cesium3DTilesSelection::Tile*> AllTilesVector(AllTilesSet.begin(), AllTilesSet.end());
-  hideTiles(AllTilesVector);
+  hideTiles(
+    AllTilesVector,
+    [this](UCesiumGltfComponent* Gltf)
+    {
+      this->queueTileVisibility(Gltf, false);
+    });
+  this->flushTileRenderStates();
 }
 
 void ACesium3DTileset::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -2630,14 +3239,20 @@ void ACesium3DTileset::PostEditChangeProperty(
     PropName ==
     GET_MEMBER_NAME_CHECKED(ACesium3DTileset, CreatePhysicsMeshes) ||
     PropName ==
+    GET_MEMBER_NAME_CHECKED(ACesium3DTileset, CreatePhysicsMeshesOnDemand) ||
+    PropName ==
     GET_MEMBER_NAME_CHECKED(ACesium3DTileset, CreateNavCollision) ||
     PropName ==
     GET_MEMBER_NAME_CHECKED(ACesium3DTileset, AlwaysIncludeTangents) ||
     PropName ==
     GET_MEMBER_NAME_CHECKED(ACesium3DTileset, GenerateSmoothNormals) ||
+    PropName ==
+    GET_MEMBER_NAME_CHECKED(ACesium3DTileset, WeldGeneratedVertices) ||
     PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, EnableWaterMask) ||
     PropName ==
     GET_MEMBER_NAME_CHECKED(ACesium3DTileset, IgnoreKhrMaterialsUnlit) ||
+    PropName ==
+    GET_MEMBER_NAME_CHECKED(ACesium3DTileset, UseSharedTilesetTransform) ||
     PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, Material) ||
     PropName ==
     GET_MEMBER_NAME_CHECKED(ACesium3DTileset, TranslucentMaterial) ||
@@ -0,0 +1,419 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "Cesium3tzArchive.h"
+#include "CesiumMappedFile.h"
+#include "CesiumRuntime.h"
+#include "Misc/Compression.h"
+#include "Misc/SecureHash.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace {
+
+const std::string IndexFilename = "@3dtilesIndex1@";
+
+constexpr uint32_t LocalFileHeaderSignature = 0x04034b50;
+constexpr uint32_t CentralDirectoryHeaderSignature = 0x02014b50;
+constexpr uint32_t EndOfCentralDirectorySignature = 0x06054b50;
+constexpr uint32_t Zip64EndOfCentralDirectorySignature = 0x06064b50;
+constexpr uint32_t Zip64LocatorSignature = 0x07064b50;
+constexpr uint16_t Zip64ExtraFieldId = 0x0001;
+
+constexpr size_t LocalFileHeaderSize = 30;
+constexpr size_t CentralDirectoryHeaderSize = 46;
+constexpr size_t EndOfCentralDirectorySize = 22;
+constexpr size_t Zip64EndOfCentralDirectorySize = 56;
+constexpr size_t Zip64LocatorSize = 20;
+constexpr size_t MaximumCommentSize = 0xffff;
+
+constexpr uint16_t MethodStored = 0;
+constexpr uint16_t MethodDeflated = 8;
+constexpr uint16_t FlagDataDescriptor = 0x0008;
+
+// Negative window bits make zlib inflate a raw deflate stream, which is how
+// ZIP files store deflated data.
+constexpr int32 RawDeflateWindowBits = -15;
+
+template <typename T> T readLittleEndian(const std::byte* pData) {
+  T value;
+  std::memcpy(&value, pData, sizeof(T));
+  return value;
+}
+
+void computeHash(const std::string& path, std::byte hash[16]) {
+  FMD5 md5;
+  md5.Update(reinterpret_cast<const uint8*>(path.data()), path.size());
+  md5.Final(reinterpret_cast<uint8*>(hash));
+}
+
+// The 3TZ index is sorted by hash, comparing the two halves of the hash as
+// little-endian 64-bit integers, the second half first.
+bool hashLess(const std::byte* pLeft, const std::byte* pRight) {
+  const uint64_t leftHigh = readLittleEndian<uint64_t>(pLeft + 8);
+  const uint64_t rightHigh = readLittleEndian<uint64_t>(pRight + 8);
+  if (leftHigh != rightHigh) {
+    return leftHigh < rightHigh;
+  }
+  return readLittleEndian<uint64_t>(pLeft) <
+         readLittleEndian<uint64_t>(pRight);
+}
+
+} // namespace
+
+/*static*/ std::shared_ptr<Cesium3tzArchive>
+Cesium3tzArchive::open(const FString& filename) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::Open3tzArchive)
+
+  std::shared_ptr<const CesiumMappedFile> pFile =
+      CesiumMappedFile::open(filename);
+  if (!pFile) {
+    return nullptr;
+  }
+
+  std::shared_ptr<Cesium3tzArchive> pArchive(
+      new Cesium3tzArchive(std::move(pFile)));
+  if (!pArchive->readCentralDirectory()) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT("%s is not a valid 3D Tiles archive."),
+        *filename);
+    return nullptr;
+  }
+
+  return pArchive;
+}
+
+/*static*/ bool Cesium3tzArchive::splitArchivePath(
+    const std::string& filename,
+    std::string& archiveFilename,
+    std::string& pathInArchive) {
+  std::string lowercase = filename;
+  std::transform(
+      lowercase.begin(),
+      lowercase.end(),
+      lowercase.begin(),
+      [](unsigned char c) { return char(std::tolower(c)); });
+
+  size_t extension = 0;
+  while ((extension = lowercase.find(".3tz", extension)) != std::string::npos) {
+    const size_t separator = extension + 4;
+    if (separator < lowercase.size() &&
+        (lowercase[separator] == '/' || lowercase[separator] == '\\')) {
+      archiveFilename = filename.substr(0, separator);
+      pathInArchive = filename.substr(separator + 1);
+      std::replace(pathInArchive.begin(), pathInArchive.end(), '\\', '/');
+      return true;
+    }
+    extension = separator;
+  }
+
+  return false;
+}
+
+Cesium3tzArchive::Cesium3tzArchive(
+    std::shared_ptr<const CesiumMappedFile>&& pFile) noexcept
+    : _pFile(std::move(pFile)),
+      _pIndex(nullptr),
+      _entryCount(0),
+      _ownedIndex() {}
+
+std::optional<CesiumResponseBuffer>
+Cesium3tzArchive::read(const std::string& path) const {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::Read3tzFile)
+
+  IndexRecord key;
+  computeHash(path, key.hash);
+
+  const IndexRecord* pEnd = this->_pIndex + this->_entryCount;
+  const IndexRecord* pFound = std::lower_bound(
+      this->_pIndex,
+      pEnd,
+      key,
+      [](const IndexRecord& left, const IndexRecord& right) {
+        return hashLess(left.hash, right.hash);
+      });
+  if (pFound == pEnd ||
+      std::memcmp(pFound->hash, key.hash, sizeof(key.hash)) != 0) {
+    return std::nullopt;
+  }
+
+  std::optional<FileData> fileData = this->findFileData(
+      readLittleEndian<uint64_t>(pFound->localHeaderOffset),
+      path);
+  if (!fileData) {
+    return std::nullopt;
+  }
+
+  if (fileData->compressionMethod == MethodStored) {
+    return CesiumResponseBuffer(
+        std::shared_ptr<const CesiumMappedFile>(this->_pFile),
+        fileData->data);
+  }
+
+  if (fileData->compressionMethod == MethodDeflated &&
+      fileData->uncompressedSize <= uint64_t(MAX_int32) &&
+      fileData->data.size() <= size_t(MAX_int32)) {
+    std::vector<std::byte> inflated(size_t(fileData->uncompressedSize));
+    if (FCompression::UncompressMemory(
+            NAME_Zlib,
+            inflated.data(),
+            int32(inflated.size()),
+            fileData->data.data(),
+            int32(fileData->data.size()),
+            COMPRESS_NoFlags,
+            RawDeflateWindowBits)) {
+      return CesiumResponseBuffer(std::move(inflated));
+    }
+  }
+
+  UE_LOG(
+      LogCesium,
+      Warning,
+      TEXT("Cannot read %s from a 3D Tiles archive: compression method %d."),
+      UTF8_TO_TCHAR(path.c_str()),
+      int32(fileData->compressionMethod));
+  return std::nullopt;
+}
+
+bool Cesium3tzArchive::readCentralDirectory() {
+  const gsl::span<const std::byte> file = this->_pFile->span();
+  const std::byte* pFile = file.data();
+  if (file.size() < EndOfCentralDirectorySize) {
+    return false;
+  }
+
+  // The end of central directory record is followed only by a comment of up
+  // to 64 KiB, so search backward for its signature from the end.
+  const size_t lastCandidate = file.size() - EndOfCentralDirectorySize;
+  const size_t firstCandidate =
+      lastCandidate > MaximumCommentSize ? lastCandidate - MaximumCommentSize
+                                         : 0;
+  std::optional<size_t> endOfCentralDirectory;
+  for (size_t i = lastCandidate + 1; i-- > firstCandidate;) {
+    if (readLittleEndian<uint32_t>(pFile + i) ==
+        EndOfCentralDirectorySignature) {
+      endOfCentralDirectory = i;
+      break;
+    }
+  }
+  if (!endOfCentralDirectory) {
+    return false;
+  }
+
+  const std::byte* pEnd = pFile + *endOfCentralDirectory;
+  uint64_t entryCount = readLittleEndian<uint16_t>(pEnd + 10);
+  uint64_t directorySize = readLittleEndian<uint32_t>(pEnd + 12);
+  uint64_t directoryOffset = readLittleEndian<uint32_t>(pEnd + 16);
+
+  // Archives larger than 4 GiB, or with more than 65535 files, store the
+  // real values in the ZIP64 end of central directory record.
+  if ((entryCount == 0xffff || directorySize == 0xffffffff ||
+       directoryOffset == 0xffffffff) &&
+      *endOfCentralDirectory >= Zip64LocatorSize) {
+    const std::byte* pLocator = pEnd - Zip64LocatorSize;
+    if (readLittleEndian<uint32_t>(pLocator) == Zip64LocatorSignature) {
+      const uint64_t zip64Offset = readLittleEndian<uint64_t>(pLocator + 8);
+      if (file.size() >= Zip64EndOfCentralDirectorySize &&
+          zip64Offset <= file.size() - Zip64EndOfCentralDirectorySize &&
+          readLittleEndian<uint32_t>(pFile + zip64Offset) ==
+              Zip64EndOfCentralDirectorySignature) {
+        const std::byte* pZip64End = pFile + zip64Offset;
+        entryCount = readLittleEndian<uint64_t>(pZip64End + 32);
+        directorySize = readLittleEndian<uint64_t>(pZip64End + 40);
+        directoryOffset = readLittleEndian<uint64_t>(pZip64End + 48);
+      }
+    }
+  }
+
+  if (directoryOffset > file.size() ||
+      directorySize > file.size() - directoryOffset) {
+    return false;
+  }
+
+  // Walk the central directory, remembering the local header offset of every
+  // file in case the archive has no index of its own.
+  std::vector<std::pair<std::string, uint64_t>> files;
+  std::optional<uint64_t> indexOffset;
+
+  const std::byte* pHeader = pFile + directoryOffset;
+  const std::byte* pDirectoryEnd = pHeader + directorySize;
+  for (uint64_t i = 0; i < entryCount; ++i) {
+    if (size_t(pDirectoryEnd - pHeader) < CentralDirectoryHeaderSize ||
+        readLittleEndian<uint32_t>(pHeader) !=
+            CentralDirectoryHeaderSignature) {
+      return false;
+    }
+
+    const uint32_t compressedSize = readLittleEndian<uint32_t>(pHeader + 20);
+    const uint32_t uncompressedSize = readLittleEndian<uint32_t>(pHeader + 24);
+    const uint16_t nameLength = readLittleEndian<uint16_t>(pHeader + 28);
+    const uint16_t extraLength = readLittleEndian<uint16_t>(pHeader + 30);
+    const uint16_t commentLength = readLittleEndian<uint16_t>(pHeader + 32);
+    uint64_t localHeaderOffset = readLittleEndian<uint32_t>(pHeader + 42);
+
+    const size_t headerSize = CentralDirectoryHeaderSize + nameLength +
+                              extraLength + commentLength;
+    if (size_t(pDirectoryEnd - pHeader) < headerSize) {
+      return false;
+    }
+
+    if (localHeaderOffset == 0xffffffff) {
+      // The ZIP64 extra field holds, in order, only the values that did not
+      // fit in their 32-bit fields.
+      const std::byte* pExtra =
+          pHeader + CentralDirectoryHeaderSize + nameLength;
+      const std::byte* pExtraEnd = pExtra + extraLength;
+      while (pExtraEnd - pExtra >= 4) {
+        const uint16_t id = readLittleEndian<uint16_t>(pExtra);
+        const uint16_t size = readLittleEndian<uint16_t>(pExtra + 2);
+        if (size_t(pExtraEnd - pExtra - 4) < size) {
+          break;
+        }
+        if (id == Zip64ExtraFieldId) {
+          size_t position = (uncompressedSize == 0xffffffff ? 8 : 0) +
+                            (compressedSize == 0xffffffff ? 8 : 0);
+          if (position + 8 <= size) {
+            localHeaderOffset =
+                readLittleEndian<uint64_t>(pExtra + 4 + position);
+          }
+          break;
+        }
+        pExtra += 4 + size;
+      }
+    }
+
+    std::string name(
+        reinterpret_cast<const char*>(pHeader + CentralDirectoryHeaderSize),
+        nameLength);
+    if (name == IndexFilename) {
+      indexOffset = localHeaderOffset;
+    } else if (!name.empty() && name.back() != '/') {
+      files.emplace_back(std::move(name), localHeaderOffset);
+    }
+
+    pHeader += headerSize;
+  }
+
+  if (indexOffset) {
+    std::optional<FileData> index =
+        this->findFileData(*indexOffset, IndexFilename);
+    if (index && index->compressionMethod == MethodStored &&
+        index->data.size() % sizeof(IndexRecord) == 0) {
+      const IndexRecord* pRecords =
+          reinterpret_cast<const IndexRecord*>(index->data.data());
+      const size_t recordCount = index->data.size() / sizeof(IndexRecord);
+      const bool sorted = std::is_sorted(
+          pRecords,
+          pRecords + recordCount,
+          [](const IndexRecord& left, const IndexRecord& right) {
+            return hashLess(left.hash, right.hash);
+          });
+      if (sorted) {
+        this->_pIndex = pRecords;
+        this->_entryCount = recordCount;
+        return true;
+      }
+    }
+
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT(
+            "The index of a 3D Tiles archive is invalid, so it will be rebuilt from the ZIP central directory."));
+  }
+
+  this->_ownedIndex.resize(files.size());
+  for (size_t i = 0; i < files.size(); ++i) {
+    IndexRecord& record = this->_ownedIndex[i];
+    computeHash(files[i].first, record.hash);
+    std::memcpy(
+        record.localHeaderOffset,
+        &files[i].second,
+        sizeof(record.localHeaderOffset));
+  }
+  std::sort(
+      this->_ownedIndex.begin(),
+      this->_ownedIndex.end(),
+      [](const IndexRecord& left, const IndexRecord& right) {
+        return hashLess(left.hash, right.hash);
+      });
+
+  this->_pIndex = this->_ownedIndex.data();
+  this->_entryCount = this->_ownedIndex.size();
+  return true;
+}
+
+std::optional<Cesium3tzArchive::FileData> Cesium3tzArchive::findFileData(
+    uint64_t localHeaderOffset,
+    const std::string& path) const {
+  const gsl::span<const std::byte> file = this->_pFile->span();
+  if (localHeaderOffset > file.size() ||
+      file.size() - localHeaderOffset < LocalFileHeaderSize) {
+    return std::nullopt;
+  }
+
+  const std::byte* pHeader = file.data() + localHeaderOffset;
+  if (readLittleEndian<uint32_t>(pHeader) != LocalFileHeaderSignature) {
+    return std::nullopt;
+  }
+
+  const uint16_t flags = readLittleEndian<uint16_t>(pHeader + 6);
+  const uint16_t compressionMethod = readLittleEndian<uint16_t>(pHeader + 8);
+  uint64_t compressedSize = readLittleEndian<uint32_t>(pHeader + 18);
+  uint64_t uncompressedSize = readLittleEndian<uint32_t>(pHeader + 22);
+  const uint16_t nameLength = readLittleEndian<uint16_t>(pHeader + 26);
+  const uint16_t extraLength = readLittleEndian<uint16_t>(pHeader + 28);
+
+  const uint64_t dataOffset =
+      localHeaderOffset + LocalFileHeaderSize + nameLength + extraLength;
+  if (dataOffset > file.size()) {
+    return std::nullopt;
+  }
+
+  // The name in the local header guards against hash collisions and a
+  // corrupt index.
+  if (path.size() != nameLength ||
+      std::memcmp(pHeader + LocalFileHeaderSize, path.data(), nameLength) !=
+          0) {
+    return std::nullopt;
+  }
+
+  if (compressedSize == 0xffffffff || uncompressedSize == 0xffffffff) {
+    // Unlike in the central directory, a ZIP64 extra field in a local header
+    // always holds both sizes.
+    const std::byte* pExtra = pHeader + LocalFileHeaderSize + nameLength;
+    const std::byte* pExtraEnd = pExtra + extraLength;
+    while (pExtraEnd - pExtra >= 4) {
+      const uint16_t id = readLittleEndian<uint16_t>(pExtra);
+      const uint16_t size = readLittleEndian<uint16_t>(pExtra + 2);
+      if (size_t(pExtraEnd - pExtra - 4) < size) {
+        break;
+      }
+      if (id == Zip64ExtraFieldId && size >= 16) {
+        uncompressedSize = readLittleEndian<uint64_t>(pExtra + 4);
+        compressedSize = readLittleEndian<uint64_t>(pExtra + 12);
+        break;
+      }
+      pExtra += 4 + size;
+    }
+  }
+
+  // Files written with a trailing data descriptor may not have their sizes in
+  // the local header. 3TZ writers know the sizes up front, so these are not
+  // supported.
+  if ((flags & FlagDataDescriptor) != 0 && compressedSize == 0 &&
+      uncompressedSize == 0) {
+    return std::nullopt;
+  }
+
+  if (compressedSize > file.size() - dataOffset) {
+    return std::nullopt;
+  }
+
+  return FileData{
+      compressionMethod,
+      file.subspan(size_t(dataOffset), size_t(compressedSize)),
+      uncompressedSize};
+}
@@ -0,0 +1,95 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumResponseBuffer.h"
+#include "Containers/UnrealString.h"
+#include <cstddef>
+#include <cstdint>
+#include <gsl/span>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+class CesiumMappedFile;
+
+/**
+ * @brief Reads files out of a packed 3D Tiles archive (3TZ).
+ *
+ * A 3TZ archive is a ZIP file whose last entry, `@3dtilesIndex1@`, is an
+ * index of 24-byte records: the MD5 hash of each file's path followed by the
+ * 64-bit offset of its local file header. The archive is memory-mapped once
+ * and the index is used in place, so reading a file is a hash, a binary
+ * search, and a view of the mapping, without any per-file system calls.
+ * Archives without an index are indexed from the ZIP central directory when
+ * they are opened.
+ */
+class Cesium3tzArchive {
+public:
+  /**
+   * @brief Opens and indexes the archive with the given filename.
+   *
+   * @return The archive, or `nullptr` if it cannot be mapped or is not a
+   * valid ZIP file.
+   */
+  static std::shared_ptr<Cesium3tzArchive> open(const FString& filename);
+
+  /**
+   * @brief Splits a filename that points into an archive, such as
+   * `C:/data/city.3tz/tiles/0/0.glb`, into the archive filename and the path
+   * of the file within it.
+   *
+   * @return Whether the filename contains a `.3tz` path segment.
+   */
+  static bool splitArchivePath(
+      const std::string& filename,
+      std::string& archiveFilename,
+      std::string& pathInArchive);
+
+  /**
+   * @brief Reads the file with the given path from the archive.
+   *
+   * Stored files are returned as a view of the mapping. Deflated files are
+   * inflated into a new buffer.
+   *
+   * @return The contents of the file, or `std::nullopt` if the archive does
+   * not contain it or it cannot be read.
+   */
+  std::optional<CesiumResponseBuffer> read(const std::string& path) const;
+
+  /**
+   * @brief Gets the number of files in the index.
+   */
+  size_t size() const noexcept { return this->_entryCount; }
+
+private:
+  // A record of the `@3dtilesIndex1@` index, in the archive's byte layout.
+  struct IndexRecord {
+    std::byte hash[16];
+    std::byte localHeaderOffset[8];
+  };
+  static_assert(sizeof(IndexRecord) == 24);
+
+  // The location of a file's data within the mapping.
+  struct FileData {
+    uint16_t compressionMethod;
+    gsl::span<const std::byte> data;
+    uint64_t uncompressedSize;
+  };
+
+  explicit Cesium3tzArchive(
+      std::shared_ptr<const CesiumMappedFile>&& pFile) noexcept;
+
+  bool readCentralDirectory();
+  std::optional<FileData>
+  findFileData(uint64_t localHeaderOffset, const std::string& path) const;
+
+  std::shared_ptr<const CesiumMappedFile> _pFile;
+
+  // Points either into the mapping, when the archive's own index is usable
+  // as-is, or into _ownedIndex.
+  const IndexRecord* _pIndex;
+  size_t _entryCount;
+  std::vector<IndexRecord> _ownedIndex;
+};
@@ -0,0 +1,359 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumBatchTransforms.h"
+#include "CesiumGeospatial/Cartographic.h"
+#include "CesiumGeospatial/Ellipsoid.h"
+#include "CesiumRuntime.h"
+#include "CesiumUtility/Math.h"
+#include "Math/VectorRegister.h"
+#include <cmath>
+#include <optional>
+
+using namespace CesiumGeospatial;
+using namespace CesiumUtility;
+
+namespace CesiumBatchTransforms {
+
+namespace {
+
+// The number of positions converted together in one vector register.
+constexpr int32 Lanes = 4;
+
+// Ranges are large enough that handing one to a worker thread costs little
+// compared to converting it.
+constexpr int32 PositionsPerRange = 8192;
+
+// The default center tolerance of CesiumGeospatial::Ellipsoid. Closer to the
+// center, the geodetic position is not well-defined.
+constexpr double CenterToleranceSquared = Math::Epsilon1;
+
+struct VectorLanes {
+  VectorRegister4Double x;
+  VectorRegister4Double y;
+  VectorRegister4Double z;
+};
+
+VectorRegister4Double splat(double value) {
+  return MakeVectorRegisterDouble(value, value, value, value);
+}
+
+int32 laneCount(int32 count, int32 first) {
+  return FMath::Min(Lanes, count - first);
+}
+
+// Lanes past the end of the view repeat its last position, so that a partial
+// group is computed the same way as a full one.
+VectorLanes gather(TArrayView<const FVector> values, int32 first) {
+  const int32 last = values.Num() - 1;
+  const FVector& a = values[first];
+  const FVector& b = values[FMath::Min(first + 1, last)];
+  const FVector& c = values[FMath::Min(first + 2, last)];
+  const FVector& d = values[FMath::Min(first + 3, last)];
+  return VectorLanes{
+      MakeVectorRegisterDouble(a.X, b.X, c.X, d.X),
+      MakeVectorRegisterDouble(a.Y, b.Y, c.Y, d.Y),
+      MakeVectorRegisterDouble(a.Z, b.Z, c.Z, d.Z)};
+}
+
+void scatter(
+    const VectorLanes& lanes,
+    TArrayView<FVector> values,
+    int32 first) {
+  double x[Lanes];
+  double y[Lanes];
+  double z[Lanes];
+  VectorStore(lanes.x, x);
+  VectorStore(lanes.y, y);
+  VectorStore(lanes.z, z);
+  for (int32 lane = 0; lane < laneCount(values.Num(), first); ++lane) {
+    values[first + lane] = FVector(x[lane], y[lane], z[lane]);
+  }
+}
+
+VectorRegister4Double dot(const VectorLanes& a, const VectorLanes& b) {
+  return VectorMultiplyAdd(
+      a.z,
+      b.z,
+      VectorMultiplyAdd(a.y, b.y, VectorMultiply(a.x, b.x)));
+}
+
+VectorRegister4Double length(const VectorLanes& v) {
+  return VectorSqrt(dot(v, v));
+}
+
+FVector ecefToLongitudeLatitudeHeightScalar(
+    const Ellipsoid& ellipsoid,
+    const FVector& ecef) {
+  std::optional<Cartographic> result = ellipsoid.cartesianToCartographic(
+      glm::dvec3(ecef.X, ecef.Y, ecef.Z));
+  if (!result) {
+    return FVector(0.0, 0.0, 0.0);
+  }
+  return FVector(
+      Math::radiansToDegrees(result->longitude),
+      Math::radiansToDegrees(result->latitude),
+      result->height);
+}
+
+} // namespace
+
+void longitudeLatitudeHeightToEcef(
+    const Ellipsoid& ellipsoid,
+    TArrayView<const FVector> longitudeLatitudeHeights,
+    TArrayView<FVector> ecefPositions) {
+  check(longitudeLatitudeHeights.Num() == ecefPositions.Num());
+
+  const glm::dvec3& radii = ellipsoid.getRadii();
+  const VectorLanes radiiSquared{
+      splat(radii.x * radii.x),
+      splat(radii.y * radii.y),
+      splat(radii.z * radii.z)};
+
+  const int32 count = longitudeLatitudeHeights.Num();
+  for (int32 i = 0; i < count; i += Lanes) {
+    const VectorLanes llh = gather(longitudeLatitudeHeights, i);
+
+    // The trigonometry has no vector form on every platform, so it is done per
+    // lane; everything after it is vectorized.
+    double longitudes[Lanes];
+    double latitudes[Lanes];
+    VectorStore(llh.x, longitudes);
+    VectorStore(llh.y, latitudes);
+    double cosLongitude[Lanes];
+    double sinLongitude[Lanes];
+    double cosLatitude[Lanes];
+    double sinLatitude[Lanes];
+    for (int32 lane = 0; lane < Lanes; ++lane) {
+      const double longitude = Math::degreesToRadians(longitudes[lane]);
+      const double latitude = Math::degreesToRadians(latitudes[lane]);
+      cosLongitude[lane] = std::cos(longitude);
+      sinLongitude[lane] = std::sin(longitude);
+      cosLatitude[lane] = std::cos(latitude);
+      sinLatitude[lane] = std::sin(latitude);
+    }
+
+    // The same steps as Ellipsoid::cartographicToCartesian.
+    const VectorRegister4Double cosLat = VectorLoad(cosLatitude);
+    VectorLanes normal{
+        VectorMultiply(cosLat, VectorLoad(cosLongitude)),
+        VectorMultiply(cosLat, VectorLoad(sinLongitude)),
+        VectorLoad(sinLatitude)};
+    const VectorRegister4Double normalLength = length(normal);
+    normal.x = VectorDivide(normal.x, normalLength);
+    normal.y = VectorDivide(normal.y, normalLength);
+    normal.z = VectorDivide(normal.z, normalLength);
+
+    VectorLanes k{
+        VectorMultiply(radiiSquared.x, normal.x),
+        VectorMultiply(radiiSquared.y, normal.y),
+        VectorMultiply(radiiSquared.z, normal.z)};
+    const VectorRegister4Double gamma = VectorSqrt(dot(normal, k));
+
+    const VectorLanes ecef{
+        VectorMultiplyAdd(normal.x, llh.z, VectorDivide(k.x, gamma)),
+        VectorMultiplyAdd(normal.y, llh.z, VectorDivide(k.y, gamma)),
+        VectorMultiplyAdd(normal.z, llh.z, VectorDivide(k.z, gamma))};
+    scatter(ecef, ecefPositions, i);
+  }
+}
+
+void ecefToLongitudeLatitudeHeight(
+    const Ellipsoid& ellipsoid,
+    TArrayView<const FVector> ecefPositions,
+    TArrayView<FVector> longitudeLatitudeHeights) {
+  check(ecefPositions.Num() == longitudeLatitudeHeights.Num());
+
+  const glm::dvec3 oneOverRadii = 1.0 / ellipsoid.getRadii();
+  const glm::dvec3 oneOverRadiiSquared = oneOverRadii * oneOverRadii;
+  const VectorLanes oneOverRadiiLanes{
+      splat(oneOverRadii.x),
+      splat(oneOverRadii.y),
+      splat(oneOverRadii.z)};
+  const VectorLanes oneOverRadiiSquaredLanes{
+      splat(oneOverRadiiSquared.x),
+      splat(oneOverRadiiSquared.y),
+      splat(oneOverRadiiSquared.z)};
+  const VectorRegister4Double one = splat(1.0);
+  const VectorRegister4Double epsilon = splat(Math::Epsilon12);
+
+  const int32 count = ecefPositions.Num();
+  for (int32 i = 0; i < count; i += Lanes) {
+    const VectorLanes position = gather(ecefPositions, i);
+
+    // The same steps as Ellipsoid::scaleToGeodeticSurface.
+    const VectorLanes scaled{
+        VectorMultiply(position.x, oneOverRadiiLanes.x),
+        VectorMultiply(position.y, oneOverRadiiLanes.y),
+        VectorMultiply(position.z, oneOverRadiiLanes.z)};
+    const VectorLanes squared{
+        VectorMultiply(scaled.x, scaled.x),
+        VectorMultiply(scaled.y, scaled.y),
+        VectorMultiply(scaled.z, scaled.z)};
+    const VectorRegister4Double squaredNorm =
+        VectorAdd(VectorAdd(squared.x, squared.y), squared.z);
+
+    // Positions near the center take a special path, which is rare enough to
+    // leave to the scalar conversion.
+    if (VectorMaskBits(
+            VectorCompareGT(splat(CenterToleranceSquared), squaredNorm))) {
+      for (int32 lane = 0; lane < laneCount(count, i); ++lane) {
+        longitudeLatitudeHeights[i + lane] =
+            ecefToLongitudeLatitudeHeightScalar(
+                ellipsoid,
+                ecefPositions[i + lane]);
+      }
+      continue;
+    }
+
+    const VectorRegister4Double ratio =
+        VectorSqrt(VectorDivide(one, squaredNorm));
+    const VectorLanes gradient{
+        VectorMultiply(
+            VectorMultiply(VectorMultiply(position.x, ratio), splat(2.0)),
+            oneOverRadiiSquaredLanes.x),
+        VectorMultiply(
+            VectorMultiply(VectorMultiply(position.y, ratio), splat(2.0)),
+            oneOverRadiiSquaredLanes.y),
+        VectorMultiply(
+            VectorMultiply(VectorMultiply(position.z, ratio), splat(2.0)),
+            oneOverRadiiSquaredLanes.z)};
+    VectorRegister4Double lambda = VectorDivide(
+        VectorMultiply(VectorSubtract(one, ratio), length(position)),
+        VectorMultiply(splat(0.5), length(gradient)));
+
+    // Newton's method, run until every lane has converged. A lane that has
+    // converged keeps the multipliers of its last step.
+    VectorRegister4Double correction = VectorZeroDouble();
+    VectorRegister4Double active = VectorCompareEQ(one, one);
+    VectorLanes multiplier{one, one, one};
+    do {
+      lambda = VectorSubtract(lambda, correction);
+      const VectorLanes step{
+          VectorDivide(
+              one,
+              VectorMultiplyAdd(lambda, oneOverRadiiSquaredLanes.x, one)),
+          VectorDivide(
+              one,
+              VectorMultiplyAdd(lambda, oneOverRadiiSquaredLanes.y, one)),
+          VectorDivide(
+              one,
+              VectorMultiplyAdd(lambda, oneOverRadiiSquaredLanes.z, one))};
+      multiplier.x = VectorSelect(active, step.x, multiplier.x);
+      multiplier.y = VectorSelect(active, step.y, multiplier.y);
+      multiplier.z = VectorSelect(active, step.z, multiplier.z);
+
+      const VectorLanes step2{
+          VectorMultiply(step.x, step.x),
+          VectorMultiply(step.y, step.y),
+          VectorMultiply(step.z, step.z)};
+      const VectorLanes step3{
+          VectorMultiply(step2.x, step.x),
+          VectorMultiply(step2.y, step.y),
+          VectorMultiply(step2.z, step.z)};
+      const VectorRegister4Double func =
+          VectorSubtract(dot(squared, step2), one);
+      const VectorRegister4Double denominator = VectorMultiplyAdd(
+          VectorMultiply(squared.z, step3.z),
+          oneOverRadiiSquaredLanes.z,
+          VectorMultiplyAdd(
+              VectorMultiply(squared.y, step3.y),
+              oneOverRadiiSquaredLanes.y,
+              VectorMultiply(
+                  VectorMultiply(squared.x, step3.x),
+                  oneOverRadiiSquaredLanes.x)));
+      correction =
+          VectorDivide(func, VectorMultiply(splat(-2.0), denominator));
+
+      // NaN compares false, so a lane that cannot converge stops too.
+      active =
+          VectorBitwiseAnd(active, VectorCompareGT(VectorAbs(func), epsilon));
+    } while (VectorMaskBits(active));
+
+    const VectorLanes surface{
+        VectorMultiply(position.x, multiplier.x),
+        VectorMultiply(position.y, multiplier.y),
+        VectorMultiply(position.z, multiplier.z)};
+
+    // The same steps as Ellipsoid::cartesianToCartographic.
+    VectorLanes normal{
+        VectorMultiply(surface.x, oneOverRadiiSquaredLanes.x),
+        VectorMultiply(surface.y, oneOverRadiiSquaredLanes.y),
+        VectorMultiply(surface.z, oneOverRadiiSquaredLanes.z)};
+    const VectorRegister4Double normalLength = length(normal);
+    normal.x = VectorDivide(normal.x, normalLength);
+    normal.y = VectorDivide(normal.y, normalLength);
+    normal.z = VectorDivide(normal.z, normalLength);
+
+    const VectorLanes height{
+        VectorSubtract(position.x, surface.x),
+        VectorSubtract(position.y, surface.y),
+        VectorSubtract(position.z, surface.z)};
+
+    double normalX[Lanes];
+    double normalY[Lanes];
+    double normalZ[Lanes];
+    double heightLength[Lanes];
+    double heightDirection[Lanes];
+    VectorStore(normal.x, normalX);
+    VectorStore(normal.y, normalY);
+    VectorStore(normal.z, normalZ);
+    VectorStore(length(height), heightLength);
+    VectorStore(dot(height, position), heightDirection);
+    for (int32 lane = 0; lane < laneCount(count, i); ++lane) {
+      longitudeLatitudeHeights[i + lane] = FVector(
+          Math::radiansToDegrees(std::atan2(normalY[lane], normalX[lane])),
+          Math::radiansToDegrees(std::asin(normalZ[lane])),
+          Math::sign(heightDirection[lane]) * heightLength[lane]);
+    }
+  }
+}
+
+void transformPositions(
+    const glm::dmat4& transform,
+    TArrayView<const FVector> positions,
+    TArrayView<FVector> transformedPositions) {
+  check(positions.Num() == transformedPositions.Num());
+
+  VectorRegister4Double m[4][3];
+  for (int32 column = 0; column < 4; ++column) {
+    for (int32 row = 0; row < 3; ++row) {
+      m[column][row] = splat(transform[column][row]);
+    }
+  }
+
+  const int32 count = positions.Num();
+  for (int32 i = 0; i < count; i += Lanes) {
+    const VectorLanes p = gather(positions, i);
+    VectorLanes result;
+    VectorRegister4Double* pResult[3] = {&result.x, &result.y, &result.z};
+    for (int32 row = 0; row < 3; ++row) {
+      *pResult[row] = VectorMultiplyAdd(
+          m[2][row],
+          p.z,
+          VectorMultiplyAdd(
+              m[1][row],
+              p.y,
+              VectorMultiplyAdd(m[0][row], p.x, m[3][row])));
+    }
+    scatter(result, transformedPositions, i);
+  }
+}
+
+void forEachRange(
+    int32 count,
+    const std::function<void(int32 first, int32 rangeCount)>& body) {
+  if (count <= PositionsPerRange) {
+    if (count > 0) {
+      body(0, count);
+    }
+    return;
+  }
+
+  const int32 rangeCount = (count + PositionsPerRange - 1) / PositionsPerRange;
+  getTaskProcessor()->parallelFor(rangeCount, [count, &body](int32 range) {
+    const int32 first = range * PositionsPerRange;
+    body(first, FMath::Min(PositionsPerRange, count - first));
+  });
+}
+
+} // namespace CesiumBatchTransforms
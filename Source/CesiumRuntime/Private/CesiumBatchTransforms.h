@@ -0,0 +1,68 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/ArrayView.h"
+#include "Math/Vector.h"
+#include <glm/mat4x4.hpp>
+#include <functional>
+
+namespace CesiumGeospatial {
+class Ellipsoid;
+}
+
+/**
+ * @brief Coordinate conversions over whole arrays of positions.
+ *
+ * The kernels compute four positions at a time in vector registers, so they
+ * run on AVX or NEON where the platform has it and fall back to scalar math
+ * elsewhere. Their results match the one-position conversions of
+ * {@link CesiumGeospatial::Ellipsoid} to within floating-point round-off.
+ *
+ * In each kernel, the input and output views must have the same number of
+ * elements. They may be the same view, which converts the positions in place.
+ */
+namespace CesiumBatchTransforms {
+
+/**
+ * @brief Converts longitude in degrees (x), latitude in degrees (y), and
+ * height above the ellipsoid in meters (z) to Earth-Centered, Earth-Fixed
+ * coordinates.
+ */
+void longitudeLatitudeHeightToEcef(
+    const CesiumGeospatial::Ellipsoid& ellipsoid,
+    TArrayView<const FVector> longitudeLatitudeHeights,
+    TArrayView<FVector> ecefPositions);
+
+/**
+ * @brief Converts Earth-Centered, Earth-Fixed coordinates to longitude in
+ * degrees (x), latitude in degrees (y), and height above the ellipsoid in
+ * meters (z). Positions near the center of the ellipsoid are converted one
+ * at a time, and those without a geodetic position are converted to zero, like
+ * `UCesiumWgs84Ellipsoid::EarthCenteredEarthFixedToLongitudeLatitudeHeight`
+ * does.
+ */
+void ecefToLongitudeLatitudeHeight(
+    const CesiumGeospatial::Ellipsoid& ellipsoid,
+    TArrayView<const FVector> ecefPositions,
+    TArrayView<FVector> longitudeLatitudeHeights);
+
+/**
+ * @brief Transforms positions by an affine matrix.
+ */
+void transformPositions(
+    const glm::dmat4& transform,
+    TArrayView<const FVector> positions,
+    TArrayView<FVector> transformedPositions);
+
+/**
+ * @brief Calls `body` with consecutive ranges, given as a first index and a
+ * count, that together cover `count` elements. Small counts are covered by a
+ * single call on the calling thread; larger ones are split across the worker
+ * threads, and this function returns once all ranges are done.
+ */
+void forEachRange(
+    int32 count,
+    const std::function<void(int32 first, int32 rangeCount)>& body);
+
+} // namespace CesiumBatchTransforms
@@ -0,0 +1,46 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumCollisionInterestComponent.h"
+
+namespace {
+
+// The registered components of all worlds. Components register and unregister
+// on the game thread only.
+TArray<const UCesiumCollisionInterestComponent*> registeredComponents;
+
+} // namespace
+
+UCesiumCollisionInterestComponent::UCesiumCollisionInterestComponent() {
+  PrimaryComponentTick.bCanEverTick = false;
+}
+
+bool UCesiumCollisionInterestComponent::Intersects(
+    const FVector& Center,
+    double SphereRadius) const {
+  const FVector start = this->GetComponentLocation();
+  const FVector end = start + this->GetForwardVector() * this->Length;
+  const double distance = FMath::PointDistToSegment(Center, start, end);
+  return distance <= this->Radius + SphereRadius;
+}
+
+/*static*/ void UCesiumCollisionInterestComponent::GetInterestComponents(
+    const UWorld* World,
+    TArray<const UCesiumCollisionInterestComponent*>& OutComponents) {
+  OutComponents.Reset();
+  for (const UCesiumCollisionInterestComponent* pComponent :
+       registeredComponents) {
+    if (pComponent->GetWorld() == World) {
+      OutComponents.Add(pComponent);
+    }
+  }
+}
+
+void UCesiumCollisionInterestComponent::OnRegister() {
+  Super::OnRegister();
+  registeredComponents.AddUnique(this);
+}
+
+void UCesiumCollisionInterestComponent::OnUnregister() {
+  registeredComponents.RemoveSingleSwap(this);
+  Super::OnUnregister();
+}
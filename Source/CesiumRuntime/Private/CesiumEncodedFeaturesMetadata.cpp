@@ -16,11 +16,14 @@
 #include "Containers/Map.h"
 #include "PixelFormat.h"
 #include "TextureResource.h"
+#include "UnrealTaskProcessor.h"
 #include <CesiumGltf/FeatureIdTextureView.h>
 #include <CesiumUtility/Tracing.h>
+#include <algorithm>
 #include <glm/gtx/integer.hpp>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 using namespace CesiumTextureUtility;
 
@@ -465,6 +468,73 @@ bool isValidPropertyTexturePropertyDescription(
   return true;
 }
 
+/**
+ * The number of features encoded by one task. Properties of larger tables are
+ * split into several tasks, if they can be encoded by feature range.
+ */
+const int64 FeaturesPerEncodeTask = 16384;
+
+/**
+ * A property table property whose texture has been allocated, but not yet
+ * filled.
+ */
+struct PropertyTablePropertyEncodeJob {
+  const FCesiumPropertyTablePropertyDescription* pDescription;
+  const FCesiumPropertyTableProperty* pProperty;
+  FTexture2DMipMap* pMip;
+  gsl::span<std::byte> textureData;
+  size_t pixelSize;
+  bool byFeatureRange;
+};
+
+/**
+ * A part of a PropertyTablePropertyEncodeJob that one task encodes.
+ */
+struct PropertyTablePropertyEncodeTask {
+  size_t jobIndex;
+  int64 firstFeature;
+  int64 featureCount;
+};
+
+void encodePropertyTablePropertyTask(
+    PropertyTablePropertyEncodeJob& job,
+    const PropertyTablePropertyEncodeTask& task) {
+  if (job.byFeatureRange) {
+    CesiumEncodedMetadataCoerce::encodeFeatureRange(
+        *job.pDescription,
+        *job.pProperty,
+        job.textureData,
+        job.pixelSize,
+        task.firstFeature,
+        task.featureCount);
+    return;
+  }
+
+  try {
+    if (job.pDescription->EncodingDetails.Conversion ==
+        ECesiumEncodedMetadataConversion::ParseColorFromString) {
+      CesiumEncodedMetadataParseColorFromString::encode(
+          *job.pDescription,
+          *job.pProperty,
+          job.textureData,
+          job.pixelSize);
+    } else /* info.Conversion == ECesiumEncodedMetadataConversion::Coerce */ {
+      CesiumEncodedMetadataCoerce::encode(
+          *job.pDescription,
+          *job.pProperty,
+          job.textureData,
+          job.pixelSize);
+    }
+  } catch (const std::exception& exception) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT("Error encoding property table property %s: %s"),
+        *job.pDescription->Name,
+        UTF8_TO_TCHAR(exception.what()));
+  }
+}
+
 } // namespace
 
 EncodedPropertyTable encodePropertyTableAnyThreadPart(
@@ -483,6 +553,8 @@ EncodedPropertyTable encodePropertyTableAnyThreadPart(
       UCesiumPropertyTableBlueprintLibrary::GetProperties(propertyTable);
 
   encodedPropertyTable.properties.Reserve(properties.Num());
+  std::vector<PropertyTablePropertyEncodeJob> jobs;
+  jobs.reserve(size_t(properties.Num()));
   for (const auto& pair : properties) {
     const FCesiumPropertyTableProperty& property = pair.Value;
 
@@ -589,25 +661,21 @@ EncodedPropertyTable encodePropertyTableAnyThreadPart(
       void* pTextureData = pMip->BulkData.Realloc(
           textureDimension * textureDimension * encodedFormat.pixelSize);
 
-      gsl::span<std::byte> textureData(
-          reinterpret_cast<std::byte*>(pTextureData),
-          static_cast<size_t>(pMip->BulkData.GetBulkDataSize()));
-
-      if (encodingDetails.Conversion ==
-          ECesiumEncodedMetadataConversion::ParseColorFromString) {
-        CesiumEncodedMetadataParseColorFromString::encode(
-            *pDescription,
-            property,
-            textureData,
-            encodedFormat.pixelSize);
-      } else /* info.Conversion == ECesiumEncodedMetadataConversion::Coerce */ {
-        CesiumEncodedMetadataCoerce::encode(
-            *pDescription,
-            property,
-            textureData,
-            encodedFormat.pixelSize);
-      }
-      pMip->BulkData.Unlock();
+      // The texture is filled below, together with those of the other
+      // properties.
+      jobs.push_back(PropertyTablePropertyEncodeJob{
+          pDescription,
+          &property,
+          pMip,
+          gsl::span<std::byte>(
+              reinterpret_cast<std::byte*>(pTextureData),
+              static_cast<size_t>(pMip->BulkData.GetBulkDataSize())),
+          encodedFormat.pixelSize,
+          encodingDetails.Conversion ==
+                  ECesiumEncodedMetadataConversion::Coerce &&
+              CesiumEncodedMetadataCoerce::canEncodeFeatureRanges(
+                  *pDescription,
+                  property)});
     }
 
     if (pDescription->PropertyDetails.bHasOffset) {
@@ -651,6 +719,38 @@ EncodedPropertyTable encodePropertyTableAnyThreadPart(
     }
   }
 
+  // Properties are encoded independently of each other, and properties that
+  // can be encoded by feature range are further split, so that large tables
+  // are encoded by several workers at once.
+  std::vector<PropertyTablePropertyEncodeTask> tasks;
+  for (size_t i = 0; i < jobs.size(); ++i) {
+    if (!jobs[i].byFeatureRange) {
+      tasks.push_back({i, 0, propertyTableCount});
+      continue;
+    }
+    for (int64 first = 0; first < propertyTableCount;
+         first += FeaturesPerEncodeTask) {
+      tasks.push_back(
+          {i,
+           first,
+           std::min(FeaturesPerEncodeTask, propertyTableCount - first)});
+    }
+  }
+
+  {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::EncodePropertyTableProperties)
+    getTaskProcessor()->parallelFor(
+        int32(tasks.size()),
+        [&jobs, &tasks](int32 i) {
+          const PropertyTablePropertyEncodeTask& task = tasks[size_t(i)];
+          encodePropertyTablePropertyTask(jobs[task.jobIndex], task);
+        });
+  }
+
+  for (PropertyTablePropertyEncodeJob& job : jobs) {
+    job.pMip->BulkData.Unlock();
+  }
+
   return encodedPropertyTable;
 }
 
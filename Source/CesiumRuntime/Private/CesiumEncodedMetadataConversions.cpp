@@ -329,6 +329,179 @@ void coerceAndEncodeVec4s(
     pWritePos += pixelSize;
   }
 }
+
+/**
+ * Encodes a range of scalar values straight from their column. The loop is
+ * specialized for each source and target type, so that it compiles to a
+ * vectorized conversion where the conversion allows it.
+ */
+template <typename TTarget, typename TSource>
+void encodeScalarColumn(
+    const TCesiumStridedSpan<TSource>& column,
+    gsl::span<std::byte>& textureData,
+    int64 firstFeature,
+    int64 featureCount) {
+  if (featureCount <= 0) {
+    return;
+  }
+  check(
+      textureData.size() >=
+      size_t(firstFeature + featureCount) * sizeof(TTarget));
+  check(column.Stride == int64(sizeof(TSource)));
+
+  // Non-array columns are tightly packed.
+  const TSource* pRead = &column[firstFeature];
+  TTarget* pWrite =
+      reinterpret_cast<TTarget*>(textureData.data()) + firstFeature;
+  for (int64 i = 0; i < featureCount; ++i) {
+    pWrite[i] =
+        CesiumMetadataConversions<TTarget, TSource>::convert(pRead[i], 0);
+  }
+}
+
+/**
+ * Encodes a range of vecN values straight from their column, with the same
+ * layout as coerceAndEncodeVec2s and its siblings.
+ */
+template <typename TTarget, glm::length_t N, typename TSource>
+void encodeVecColumn(
+    const TCesiumStridedSpan<glm::vec<N, TSource>>& column,
+    gsl::span<std::byte>& textureData,
+    size_t pixelSize,
+    int64 firstFeature,
+    int64 featureCount) {
+  check(textureData.size() >= size_t(firstFeature + featureCount) * pixelSize);
+
+  uint8* pWritePos =
+      reinterpret_cast<uint8*>(textureData.data()) + firstFeature * pixelSize;
+  for (int64 i = 0; i < featureCount; ++i) {
+    const glm::vec<N, TSource>& value = column[firstFeature + i];
+    if constexpr (std::is_same_v<TTarget, uint8>) {
+      for (glm::length_t j = 0; j < N; ++j) {
+        *(pWritePos + j) =
+            CesiumMetadataConversions<uint8, TSource>::convert(value[j], 0);
+      }
+    } else {
+      // Floats are encoded backwards (e.g., ABGR)
+      float* pWritePosF = reinterpret_cast<float*>(pWritePos + pixelSize) - 1;
+      for (glm::length_t j = 0; j < N; ++j) {
+        *pWritePosF =
+            CesiumMetadataConversions<float, TSource>::convert(value[j], 0.0f);
+        --pWritePosF;
+      }
+    }
+    pWritePos += pixelSize;
+  }
+}
+
+template <typename T, typename Callback>
+bool visitColumn(
+    const FCesiumPropertyTableProperty& property,
+    Callback&& callback) {
+  TCesiumStridedSpan<T> column =
+      UCesiumPropertyTablePropertyBlueprintLibrary::GetColumnValues<T>(
+          property);
+  if (column.IsEmpty()) {
+    return false;
+  }
+  callback(column);
+  return true;
+}
+
+template <typename T, typename Callback>
+bool visitVecColumn(
+    const FCesiumPropertyTableProperty& property,
+    ECesiumMetadataType type,
+    Callback&& callback) {
+  switch (type) {
+  case ECesiumMetadataType::Vec2:
+    return visitColumn<glm::vec<2, T>>(property, callback);
+  case ECesiumMetadataType::Vec3:
+    return visitColumn<glm::vec<3, T>>(property, callback);
+  case ECesiumMetadataType::Vec4:
+    return visitColumn<glm::vec<4, T>>(property, callback);
+  default:
+    return false;
+  }
+}
+
+/**
+ * Calls the callback with the column of raw values of the property, if its
+ * values can be coerced to the encoded type without going through
+ * FCesiumMetadataValue. This is the case for non-array scalars of any
+ * component type, and for vecNs whose component type and dimension already
+ * match the encoded type. Returns false otherwise.
+ */
+template <typename Callback>
+bool visitEncodableColumn(
+    const FCesiumPropertyTablePropertyDescription& propertyDescription,
+    const FCesiumPropertyTableProperty& property,
+    Callback&& callback) {
+  const FCesiumMetadataEncodingDetails& encodingDetails =
+      propertyDescription.EncodingDetails;
+  if (encodingDetails.ComponentType !=
+          ECesiumEncodedMetadataComponentType::Uint8 &&
+      encodingDetails.ComponentType !=
+          ECesiumEncodedMetadataComponentType::Float) {
+    return false;
+  }
+
+  const FCesiumMetadataValueType valueType =
+      UCesiumPropertyTablePropertyBlueprintLibrary::GetValueType(property);
+  if (valueType.bIsArray || propertyDescription.PropertyDetails.bIsArray) {
+    return false;
+  }
+
+  if (valueType.Type == ECesiumMetadataType::Scalar) {
+    if (encodingDetails.Type != ECesiumEncodedMetadataType::Scalar) {
+      return false;
+    }
+
+    switch (valueType.ComponentType) {
+    case ECesiumMetadataComponentType::Int8:
+      return visitColumn<int8_t>(property, callback);
+    case ECesiumMetadataComponentType::Uint8:
+      return visitColumn<uint8_t>(property, callback);
+    case ECesiumMetadataComponentType::Int16:
+      return visitColumn<int16_t>(property, callback);
+    case ECesiumMetadataComponentType::Uint16:
+      return visitColumn<uint16_t>(property, callback);
+    case ECesiumMetadataComponentType::Int32:
+      return visitColumn<int32_t>(property, callback);
+    case ECesiumMetadataComponentType::Uint32:
+      return visitColumn<uint32_t>(property, callback);
+    case ECesiumMetadataComponentType::Int64:
+      return visitColumn<int64_t>(property, callback);
+    case ECesiumMetadataComponentType::Uint64:
+      return visitColumn<uint64_t>(property, callback);
+    case ECesiumMetadataComponentType::Float32:
+      return visitColumn<float>(property, callback);
+    case ECesiumMetadataComponentType::Float64:
+      return visitColumn<double>(property, callback);
+    default:
+      return false;
+    }
+  }
+
+  if (CesiumMetadataTypeToEncodingType(valueType.Type) !=
+      encodingDetails.Type) {
+    return false;
+  }
+
+  if (valueType.ComponentType == ECesiumMetadataComponentType::Uint8 &&
+      encodingDetails.ComponentType ==
+          ECesiumEncodedMetadataComponentType::Uint8) {
+    return visitVecColumn<uint8_t>(property, valueType.Type, callback);
+  }
+
+  if (valueType.ComponentType == ECesiumMetadataComponentType::Float32 &&
+      encodingDetails.ComponentType ==
+          ECesiumEncodedMetadataComponentType::Float) {
+    return visitVecColumn<float>(property, valueType.Type, callback);
+  }
+
+  return false;
+}
 } // namespace
 
 bool CesiumEncodedMetadataCoerce::canEncode(
@@ -373,11 +546,89 @@ bool CesiumEncodedMetadataCoerce::canEncode(
   }
 }
 
+bool CesiumEncodedMetadataCoerce::canEncodeFeatureRanges(
+    const FCesiumPropertyTablePropertyDescription& propertyDescription,
+    const FCesiumPropertyTableProperty& property) {
+  return visitEncodableColumn(
+      propertyDescription,
+      property,
+      [](const auto& column) {});
+}
+
+void CesiumEncodedMetadataCoerce::encodeFeatureRange(
+    const FCesiumPropertyTablePropertyDescription& propertyDescription,
+    const FCesiumPropertyTableProperty& property,
+    gsl::span<std::byte>& textureData,
+    size_t pixelSize,
+    int64 firstFeature,
+    int64 featureCount) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::EncodeFeatureRange)
+
+  const bool toFloat = propertyDescription.EncodingDetails.ComponentType ==
+                       ECesiumEncodedMetadataComponentType::Float;
+  visitEncodableColumn(
+      propertyDescription,
+      property,
+      [&textureData, pixelSize, firstFeature, featureCount, toFloat](
+          const auto& column) {
+        using TValue = std::decay_t<decltype(column[0])>;
+        if constexpr (CesiumGltf::IsMetadataVecN<TValue>::value) {
+          if (toFloat) {
+            encodeVecColumn<float>(
+                column,
+                textureData,
+                pixelSize,
+                firstFeature,
+                featureCount);
+          } else {
+            encodeVecColumn<uint8>(
+                column,
+                textureData,
+                pixelSize,
+                firstFeature,
+                featureCount);
+          }
+        } else if (toFloat) {
+          encodeScalarColumn<float>(
+              column,
+              textureData,
+              firstFeature,
+              featureCount);
+        } else {
+          encodeScalarColumn<uint8>(
+              column,
+              textureData,
+              firstFeature,
+              featureCount);
+        }
+      });
+}
+
 void CesiumEncodedMetadataCoerce::encode(
     const FCesiumPropertyTablePropertyDescription& propertyDescription,
     const FCesiumPropertyTableProperty& property,
     gsl::span<std::byte>& textureData,
     size_t pixelSize) {
+  if (canEncodeFeatureRanges(propertyDescription, property)) {
+    encodeFeatureRange(
+        propertyDescription,
+        property,
+        textureData,
+        pixelSize,
+        0,
+        UCesiumPropertyTablePropertyBlueprintLibrary::GetPropertySize(
+            property));
+    return;
+  }
+
+  encodeByValue(propertyDescription, property, textureData, pixelSize);
+}
+
+void CesiumEncodedMetadataCoerce::encodeByValue(
+    const FCesiumPropertyTablePropertyDescription& propertyDescription,
+    const FCesiumPropertyTableProperty& property,
+    gsl::span<std::byte>& textureData,
+    size_t pixelSize) {
   if (propertyDescription.PropertyDetails.bIsArray) {
     if (propertyDescription.EncodingDetails.ComponentType ==
         ECesiumEncodedMetadataComponentType::Uint8) {
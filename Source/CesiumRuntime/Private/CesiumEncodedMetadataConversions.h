@@ -81,6 +81,56 @@ struct CesiumEncodedMetadataCoerce {
       const FCesiumPropertyTableProperty& property,
       gsl::span<std::byte>& pTextureData,
       size_t pixelSize);
+
+  /**
+   * Whether the values of the property can be encoded in independent ranges
+   * of features by {@link encodeFeatureRange}. This is the case when they can
+   * be coerced straight from the property's column of raw values, e.g., for
+   * numeric scalars and for vecNs that already have the encoded type.
+   *
+   * @param propertyDescription The property table property description.
+   * @param property The property table property itself.
+   */
+  static bool canEncodeFeatureRanges(
+      const FCesiumPropertyTablePropertyDescription& propertyDescription,
+      const FCesiumPropertyTableProperty& property);
+
+  /**
+   * Encodes the values of the given range of features, as {@link encode}
+   * would. Ranges that do not overlap may be encoded concurrently. This may
+   * only be called if {@link canEncodeFeatureRanges} returns true.
+   *
+   * @param propertyDescription The property table property description.
+   * @param property The property table property itself.
+   * @param textureData The texture data of the whole property.
+   * @param pixelSize The size of a pixel from the given texture, in bytes.
+   * @param firstFeature The ID of the first feature to encode.
+   * @param featureCount The number of features to encode.
+   */
+  static void encodeFeatureRange(
+      const FCesiumPropertyTablePropertyDescription& propertyDescription,
+      const FCesiumPropertyTableProperty& property,
+      gsl::span<std::byte>& textureData,
+      size_t pixelSize,
+      int64 firstFeature,
+      int64 featureCount);
+
+  /**
+   * Encodes the data of the property table property one value at a time,
+   * through FCesiumMetadataValue. This supports every property that
+   * {@link canEncode} accepts, and is what {@link encode} uses for the
+   * properties that cannot be encoded by feature range.
+   *
+   * @param propertyDescription The property table property description.
+   * @param property The property table property itself.
+   * @param textureData The texture data, which will be filled during encoding.
+   * @param pixelSize The size of a pixel from the given texture, in bytes.
+   */
+  static void encodeByValue(
+      const FCesiumPropertyTablePropertyDescription& propertyDescription,
+      const FCesiumPropertyTableProperty& property,
+      gsl::span<std::byte>& textureData,
+      size_t pixelSize);
 };
 
 /**
@@ -2,10 +2,12 @@
 
 #include "CesiumGeoreference.h"
 #include "Camera/PlayerCameraManager.h"
+#include "CesiumBatchTransforms.h"
 #include "CesiumActors.h"
 #include "CesiumCommon.h"
 #include "CesiumCustomVersion.h"
 #include "CesiumGeospatial/Cartographic.h"
+#include "CesiumGeospatial/GlobeTransforms.h"
 #include "CesiumOriginShiftComponent.h"
 #include "CesiumRuntime.h"
 #include "CesiumSubLevelComponent.h"
@@ -143,6 +145,54 @@ CreateDefaultGeoreference(const UObject* WorldContextObject, const FName& Tag) {
   return Georeference;
 }
 
+/**
+ * Transforms Rotators between the East-South-Up frames at the given Unreal
+ * locations and the Unreal frame of the given coordinate system. This computes
+ * the same rotation as
+ * ACesiumGeoreference::ComputeEastSouthUpToUnrealTransformation, but without
+ * constructing a coordinate system for every location.
+ */
+void transformEastSouthUpRotators(
+    const LocalHorizontalCoordinateSystem& coordinateSystem,
+    TArrayView<const FRotator> rotators,
+    TArrayView<const FVector> unrealLocations,
+    TArrayView<FRotator> result,
+    bool toUnreal) {
+  check(rotators.Num() == unrealLocations.Num());
+  check(rotators.Num() == result.Num());
+
+  const glm::dmat4& ecefToUnreal =
+      coordinateSystem.getEcefToLocalTransformation();
+  const glm::dmat3 ecefToUnrealRotation =
+      glm::dmat3(ecefToUnreal) / glm::length(glm::dvec3(ecefToUnreal[0]));
+
+  CesiumBatchTransforms::forEachRange(
+      rotators.Num(),
+      [&](int32 first, int32 count) {
+        TArray<FVector> ecefLocations;
+        ecefLocations.SetNumUninitialized(count);
+        CesiumBatchTransforms::transformPositions(
+            coordinateSystem.getLocalToEcefTransformation(),
+            unrealLocations.Slice(first, count),
+            ecefLocations);
+
+        for (int32 i = 0; i < count; ++i) {
+          const glm::dmat4 enuToEcef = GlobeTransforms::eastNorthUpToFixedFrame(
+              VecMath::createVector3D(ecefLocations[i]),
+              Ellipsoid::WGS84);
+          const glm::dmat3 esuToEcef(
+              glm::dvec3(enuToEcef[0]),
+              -glm::dvec3(enuToEcef[1]),
+              glm::dvec3(enuToEcef[2]));
+          const FQuat esuToUnreal =
+              VecMath::createMatrix(ecefToUnrealRotation * esuToEcef).ToQuat();
+          const FQuat rotation = toUnreal ? esuToUnreal : esuToUnreal.Inverse();
+          result[first + i] =
+              FRotator(rotation * rotators[first + i].Quaternion());
+        }
+      });
+}
+
 } // namespace
 
 /*static*/ const double ACesiumGeoreference::kMinimumScale = 1.0e-6;
@@ -324,6 +374,205 @@ FRotator ACesiumGeoreference::TransformEastSouthUpRotatorToUnreal(
   return FRotator(esuToUnreal.ToQuat() * EastSouthUpRotator.Quaternion());
 }
 
+TArray<FVector>
+ACesiumGeoreference::TransformLongitudeLatitudeHeightPositionsToUnreal(
+    const TArray<FVector>& LongitudeLatitudeHeights) const {
+  TArray<FVector> result;
+  result.SetNumUninitialized(LongitudeLatitudeHeights.Num());
+  this->TransformLongitudeLatitudeHeightPositionsToUnreal(
+      LongitudeLatitudeHeights,
+      result);
+  return result;
+}
+
+TArray<FVector>
+ACesiumGeoreference::TransformUnrealPositionsToLongitudeLatitudeHeight(
+    const TArray<FVector>& UnrealPositions) const {
+  TArray<FVector> result;
+  result.SetNumUninitialized(UnrealPositions.Num());
+  this->TransformUnrealPositionsToLongitudeLatitudeHeight(
+      UnrealPositions,
+      result);
+  return result;
+}
+
+TArray<FVector>
+ACesiumGeoreference::TransformEarthCenteredEarthFixedPositionsToUnreal(
+    const TArray<FVector>& EarthCenteredEarthFixedPositions) const {
+  TArray<FVector> result;
+  result.SetNumUninitialized(EarthCenteredEarthFixedPositions.Num());
+  this->TransformEarthCenteredEarthFixedPositionsToUnreal(
+      EarthCenteredEarthFixedPositions,
+      result);
+  return result;
+}
+
+TArray<FVector>
+ACesiumGeoreference::TransformUnrealPositionsToEarthCenteredEarthFixed(
+    const TArray<FVector>& UnrealPositions) const {
+  TArray<FVector> result;
+  result.SetNumUninitialized(UnrealPositions.Num());
+  this->TransformUnrealPositionsToEarthCenteredEarthFixed(
+      UnrealPositions,
+      result);
+  return result;
+}
+
+TArray<FRotator> ACesiumGeoreference::TransformUnrealRotatorsToEastSouthUp(
+    const TArray<FRotator>& UnrealRotators,
+    const TArray<FVector>& UnrealLocations) const {
+  TArray<FRotator> result;
+  if (UnrealRotators.Num() != UnrealLocations.Num()) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT(
+            "TransformUnrealRotatorsToEastSouthUp was given %d Rotators but %d locations."),
+        UnrealRotators.Num(),
+        UnrealLocations.Num());
+    return result;
+  }
+
+  result.SetNumUninitialized(UnrealRotators.Num());
+  this->TransformUnrealRotatorsToEastSouthUp(
+      UnrealRotators,
+      UnrealLocations,
+      result);
+  return result;
+}
+
+TArray<FRotator> ACesiumGeoreference::TransformEastSouthUpRotatorsToUnreal(
+    const TArray<FRotator>& EastSouthUpRotators,
+    const TArray<FVector>& UnrealLocations) const {
+  TArray<FRotator> result;
+  if (EastSouthUpRotators.Num() != UnrealLocations.Num()) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT(
+            "TransformEastSouthUpRotatorsToUnreal was given %d Rotators but %d locations."),
+        EastSouthUpRotators.Num(),
+        UnrealLocations.Num());
+    return result;
+  }
+
+  result.SetNumUninitialized(EastSouthUpRotators.Num());
+  this->TransformEastSouthUpRotatorsToUnreal(
+      EastSouthUpRotators,
+      UnrealLocations,
+      result);
+  return result;
+}
+
+void ACesiumGeoreference::TransformLongitudeLatitudeHeightPositionsToUnreal(
+    TArrayView<const FVector> LongitudeLatitudeHeights,
+    TArrayView<FVector> UnrealPositions) const {
+  TRACE_CPUPROFILER_EVENT_SCOPE(
+      Cesium::TransformLongitudeLatitudeHeightPositionsToUnreal)
+
+  check(LongitudeLatitudeHeights.Num() == UnrealPositions.Num());
+  const glm::dmat4& ecefToUnreal =
+      this->_coordinateSystem.getEcefToLocalTransformation();
+  CesiumBatchTransforms::forEachRange(
+      LongitudeLatitudeHeights.Num(),
+      [&](int32 first, int32 count) {
+        TArrayView<FVector> unreal = UnrealPositions.Slice(first, count);
+        CesiumBatchTransforms::longitudeLatitudeHeightToEcef(
+            Ellipsoid::WGS84,
+            LongitudeLatitudeHeights.Slice(first, count),
+            unreal);
+        CesiumBatchTransforms::transformPositions(ecefToUnreal, unreal, unreal);
+      });
+}
+
+void ACesiumGeoreference::TransformUnrealPositionsToLongitudeLatitudeHeight(
+    TArrayView<const FVector> UnrealPositions,
+    TArrayView<FVector> LongitudeLatitudeHeights) const {
+  TRACE_CPUPROFILER_EVENT_SCOPE(
+      Cesium::TransformUnrealPositionsToLongitudeLatitudeHeight)
+
+  check(UnrealPositions.Num() == LongitudeLatitudeHeights.Num());
+  const glm::dmat4& unrealToEcef =
+      this->_coordinateSystem.getLocalToEcefTransformation();
+  CesiumBatchTransforms::forEachRange(
+      UnrealPositions.Num(),
+      [&](int32 first, int32 count) {
+        TArrayView<FVector> llh = LongitudeLatitudeHeights.Slice(first, count);
+        CesiumBatchTransforms::transformPositions(
+            unrealToEcef,
+            UnrealPositions.Slice(first, count),
+            llh);
+        CesiumBatchTransforms::ecefToLongitudeLatitudeHeight(
+            Ellipsoid::WGS84,
+            llh,
+            llh);
+      });
+}
+
+void ACesiumGeoreference::TransformEarthCenteredEarthFixedPositionsToUnreal(
+    TArrayView<const FVector> EarthCenteredEarthFixedPositions,
+    TArrayView<FVector> UnrealPositions) const {
+  TRACE_CPUPROFILER_EVENT_SCOPE(
+      Cesium::TransformEarthCenteredEarthFixedPositionsToUnreal)
+
+  check(EarthCenteredEarthFixedPositions.Num() == UnrealPositions.Num());
+  const glm::dmat4& ecefToUnreal =
+      this->_coordinateSystem.getEcefToLocalTransformation();
+  CesiumBatchTransforms::forEachRange(
+      EarthCenteredEarthFixedPositions.Num(),
+      [&](int32 first, int32 count) {
+        CesiumBatchTransforms::transformPositions(
+            ecefToUnreal,
+            EarthCenteredEarthFixedPositions.Slice(first, count),
+            UnrealPositions.Slice(first, count));
+      });
+}
+
+void ACesiumGeoreference::TransformUnrealPositionsToEarthCenteredEarthFixed(
+    TArrayView<const FVector> UnrealPositions,
+    TArrayView<FVector> EarthCenteredEarthFixedPositions) const {
+  TRACE_CPUPROFILER_EVENT_SCOPE(
+      Cesium::TransformUnrealPositionsToEarthCenteredEarthFixed)
+
+  check(UnrealPositions.Num() == EarthCenteredEarthFixedPositions.Num());
+  const glm::dmat4& unrealToEcef =
+      this->_coordinateSystem.getLocalToEcefTransformation();
+  CesiumBatchTransforms::forEachRange(
+      UnrealPositions.Num(),
+      [&](int32 first, int32 count) {
+        CesiumBatchTransforms::transformPositions(
+            unrealToEcef,
+            UnrealPositions.Slice(first, count),
+            EarthCenteredEarthFixedPositions.Slice(first, count));
+      });
+}
+
+void ACesiumGeoreference::TransformUnrealRotatorsToEastSouthUp(
+    TArrayView<const FRotator> UnrealRotators,
+    TArrayView<const FVector> UnrealLocations,
+    TArrayView<FRotator> EastSouthUpRotators) const {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::TransformUnrealRotatorsToEastSouthUp)
+  transformEastSouthUpRotators(
+      this->_coordinateSystem,
+      UnrealRotators,
+      UnrealLocations,
+      EastSouthUpRotators,
+      false);
+}
+
+void ACesiumGeoreference::TransformEastSouthUpRotatorsToUnreal(
+    TArrayView<const FRotator> EastSouthUpRotators,
+    TArrayView<const FVector> UnrealLocations,
+    TArrayView<FRotator> UnrealRotators) const {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::TransformEastSouthUpRotatorsToUnreal)
+  transformEastSouthUpRotators(
+      this->_coordinateSystem,
+      EastSouthUpRotators,
+      UnrealLocations,
+      UnrealRotators,
+      true);
+}
+
 FMatrix
 ACesiumGeoreference::ComputeUnrealToEarthCenteredEarthFixedTransformation()
     const {
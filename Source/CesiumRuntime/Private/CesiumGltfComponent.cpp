@@ -22,7 +22,10 @@
 #include "CesiumGltf/TextureInfo.h"
 #include "CesiumGltfPointsComponent.h"
 #include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumMaterialInstancePool.h"
 #include "CesiumMaterialUserData.h"
+#include "CesiumPhysicsMeshes.h"
+#include "CesiumPrimitiveVertices.h"
 #include "CesiumRasterOverlays.h"
 #include "CesiumRuntime.h"
 #include "CesiumTextureUtility.h"
@@ -48,14 +51,17 @@
 #include "StaticMeshOperations.h"
 #include "StaticMeshResources.h"
 #include "UObject/ConstructorHelpers.h"
+#include "UnrealTaskProcessor.h"
 #include "VecMath.h"
 #include "mikktspace.h"
+#include <algorithm>
 #include <cstddef>
 #include <glm/ext/matrix_transform.hpp>
 #include <glm/gtc/matrix_inverse.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/mat3x3.hpp>
 #include <iostream>
+#include <mutex>
 
 #if WITH_EDITOR
 #include "ScopedTransaction.h"
@@ -66,6 +72,11 @@ using namespace CesiumTextureUtility;
 using namespace CreateGltfOptions;
 using namespace LoadGltfResult;
 
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Vertices Removed by Welding"),
+    STAT_CesiumWeldedVertices,
+    STATGROUP_Cesium);
+
 namespace {
 using TMeshVector2 = FVector2f;
 using TMeshVector3 = FVector3f;
@@ -76,7 +87,7 @@ static uint32_t nextMaterialId = 0;
 
 namespace {
 void destroyHalfLoadedTexture(
-    TUniquePtr<CesiumTextureUtility::LoadedTextureResult>& pHalfLoadedTexture) {
+    TSharedPtr<CesiumTextureUtility::LoadedTextureResult>& pHalfLoadedTexture) {
   if (pHalfLoadedTexture) {
     CesiumTextureUtility::destroyHalfLoadedTexture(*pHalfLoadedTexture.Get());
   }
@@ -111,12 +122,13 @@ template <class T> struct IsAccessorView<T> : std::false_type {};
 
 template <class T> struct IsAccessorView<AccessorView<T>> : std::true_type {};
 
+
 template <class T>
 static uint32_t updateTextureCoordinates(
     const Model& model,
     const MeshPrimitive& primitive,
     bool duplicateVertices,
-    TArray<FStaticMeshBuildVertex>& vertices,
+    CesiumPrimitiveVertices& vertices,
     const TArray<uint32>& indices,
     const std::optional<T>& texture,
     std::unordered_map<int32_t, uint32_t>& gltfToUnrealTexCoordMap) {
@@ -138,7 +150,7 @@ uint32_t updateTextureCoordinates(
     const Model& model,
     const MeshPrimitive& primitive,
     bool duplicateVertices,
-    TArray<FStaticMeshBuildVertex>& vertices,
+    CesiumPrimitiveVertices& vertices,
     const TArray<uint32>& indices,
     const std::string& attributeName,
     std::unordered_map<int32_t, uint32_t>& gltfToUnrealTexCoordMap) {
@@ -163,23 +175,23 @@ uint32_t updateTextureCoordinates(
     return 0;
   }
 
+  TArray<TMeshVector2>& texCoords =
+      vertices.texCoords(uint32(textureCoordinateIndex));
   if (duplicateVertices) {
     for (int i = 0; i < indices.Num(); ++i) {
-      FStaticMeshBuildVertex& vertex = vertices[i];
       uint32 vertexIndex = indices[i];
       if (vertexIndex >= 0 && vertexIndex < uvAccessor.size()) {
-        vertex.UVs[textureCoordinateIndex] = uvAccessor[vertexIndex];
+        texCoords[i] = uvAccessor[vertexIndex];
       } else {
-        vertex.UVs[textureCoordinateIndex] = TMeshVector2(0.0f, 0.0f);
+        texCoords[i] = TMeshVector2(0.0f, 0.0f);
       }
     }
   } else {
-    for (int i = 0; i < vertices.Num(); ++i) {
-      FStaticMeshBuildVertex& vertex = vertices[i];
+    for (int i = 0; i < vertices.count; ++i) {
       if (i >= 0 && i < uvAccessor.size()) {
-        vertex.UVs[textureCoordinateIndex] = uvAccessor[i];
+        texCoords[i] = uvAccessor[i];
       } else {
-        vertex.UVs[textureCoordinateIndex] = TMeshVector2(0.0f, 0.0f);
+        texCoords[i] = TMeshVector2(0.0f, 0.0f);
       }
     }
   }
@@ -188,16 +200,16 @@ uint32_t updateTextureCoordinates(
 }
 
 static int mikkGetNumFaces(const SMikkTSpaceContext* Context) {
-  TArray<FStaticMeshBuildVertex>& vertices =
-      *reinterpret_cast<TArray<FStaticMeshBuildVertex>*>(Context->m_pUserData);
-  return vertices.Num() / 3;
+  const CesiumPrimitiveVertices& vertices =
+      *reinterpret_cast<CesiumPrimitiveVertices*>(Context->m_pUserData);
+  return vertices.count / 3;
 }
 
 static int
 mikkGetNumVertsOfFace(const SMikkTSpaceContext* Context, const int FaceIdx) {
-  TArray<FStaticMeshBuildVertex>& vertices =
-      *reinterpret_cast<TArray<FStaticMeshBuildVertex>*>(Context->m_pUserData);
-  return FaceIdx < (vertices.Num() / 3) ? 3 : 0;
+  const CesiumPrimitiveVertices& vertices =
+      *reinterpret_cast<CesiumPrimitiveVertices*>(Context->m_pUserData);
+  return FaceIdx < (vertices.count / 3) ? 3 : 0;
 }
 
 static void mikkGetPosition(
@@ -205,9 +217,9 @@ static void mikkGetPosition(
     float Position[3],
     const int FaceIdx,
     const int VertIdx) {
-  TArray<FStaticMeshBuildVertex>& vertices =
-      *reinterpret_cast<TArray<FStaticMeshBuildVertex>*>(Context->m_pUserData);
-  const TMeshVector3& position = vertices[FaceIdx * 3 + VertIdx].Position;
+  const CesiumPrimitiveVertices& vertices =
+      *reinterpret_cast<CesiumPrimitiveVertices*>(Context->m_pUserData);
+  const TMeshVector3& position = vertices.position(FaceIdx * 3 + VertIdx);
   Position[0] = position.X;
   Position[1] = -position.Y;
   Position[2] = position.Z;
@@ -218,9 +230,9 @@ static void mikkGetNormal(
     float Normal[3],
     const int FaceIdx,
     const int VertIdx) {
-  TArray<FStaticMeshBuildVertex>& vertices =
-      *reinterpret_cast<TArray<FStaticMeshBuildVertex>*>(Context->m_pUserData);
-  const TMeshVector3& normal = vertices[FaceIdx * 3 + VertIdx].TangentZ;
+  const CesiumPrimitiveVertices& vertices =
+      *reinterpret_cast<CesiumPrimitiveVertices*>(Context->m_pUserData);
+  const TMeshVector3& normal = vertices.tangentZ[FaceIdx * 3 + VertIdx];
   Normal[0] = normal.X;
   Normal[1] = -normal.Y;
   Normal[2] = normal.Z;
@@ -231,9 +243,14 @@ static void mikkGetTexCoord(
     float UV[2],
     const int FaceIdx,
     const int VertIdx) {
-  TArray<FStaticMeshBuildVertex>& vertices =
-      *reinterpret_cast<TArray<FStaticMeshBuildVertex>*>(Context->m_pUserData);
-  const TMeshVector2& uv = vertices[FaceIdx * 3 + VertIdx].UVs[0];
+  const CesiumPrimitiveVertices& vertices =
+      *reinterpret_cast<CesiumPrimitiveVertices*>(Context->m_pUserData);
+  if (vertices.texCoordSets.Num() == 0) {
+    UV[0] = 0.0f;
+    UV[1] = 0.0f;
+    return;
+  }
+  const TMeshVector2& uv = vertices.texCoordSets[0][FaceIdx * 3 + VertIdx];
   UV[0] = uv.X;
   UV[1] = uv.Y;
 }
@@ -244,11 +261,11 @@ static void mikkSetTSpaceBasic(
     const float BitangentSign,
     const int FaceIdx,
     const int VertIdx) {
-  TArray<FStaticMeshBuildVertex>& vertices =
-      *reinterpret_cast<TArray<FStaticMeshBuildVertex>*>(Context->m_pUserData);
-  FStaticMeshBuildVertex& vertex = vertices[FaceIdx * 3 + VertIdx];
+  CesiumPrimitiveVertices& vertices =
+      *reinterpret_cast<CesiumPrimitiveVertices*>(Context->m_pUserData);
+  const int32 index = FaceIdx * 3 + VertIdx;
 
-  FVector3f TangentZ = vertex.TangentZ;
+  FVector3f TangentZ = vertices.tangentZ[index];
   TangentZ.Y = -TangentZ.Y;
 
   FVector3f TangentX = TMeshVector3(Tangent[0], Tangent[1], Tangent[2]);
@@ -258,11 +275,11 @@ static void mikkSetTSpaceBasic(
   TangentX.Y = -TangentX.Y;
   TangentY.Y = -TangentY.Y;
 
-  vertex.TangentX = TangentX;
-  vertex.TangentY = TangentY;
+  vertices.tangentX[index] = TangentX;
+  vertices.tangentY[index] = TangentY;
 }
 
-static void computeTangentSpace(TArray<FStaticMeshBuildVertex>& vertices) {
+static void computeTangentSpace(CesiumPrimitiveVertices& vertices) {
   SMikkTSpaceInterface MikkTInterface{};
   MikkTInterface.m_getNormal = mikkGetNormal;
   MikkTInterface.m_getNumFaces = mikkGetNumFaces;
@@ -281,54 +298,57 @@ static void computeTangentSpace(TArray<FStaticMeshBuildVertex>& vertices) {
 
 static void setUniformNormals(
     const TArray<uint32_t>& indices,
-    TArray<FStaticMeshBuildVertex>& vertices,
+    CesiumPrimitiveVertices& vertices,
     TMeshVector3 normal) {
+  const bool hasTangents = vertices.hasTangents();
   for (int i = 0; i < indices.Num(); i++) {
-    FStaticMeshBuildVertex& v = vertices[i];
-    v.TangentX = v.TangentY = TMeshVector3(0.0f);
-    v.TangentZ = normal;
+    if (hasTangents) {
+      vertices.tangentX[i] = vertices.tangentY[i] = TMeshVector3(0.0f);
+    }
+    vertices.tangentZ[i] = normal;
   }
 }
 
 static void computeFlatNormals(
     const TArray<uint32_t>& indices,
-    TArray<FStaticMeshBuildVertex>& vertices) {
+    CesiumPrimitiveVertices& vertices) {
+  const bool hasTangents = vertices.hasTangents();
+
   // Compute flat normals
   for (int i = 0; i < indices.Num(); i += 3) {
-    FStaticMeshBuildVertex& v0 = vertices[i];
-    FStaticMeshBuildVertex& v1 = vertices[i + 1];
-    FStaticMeshBuildVertex& v2 = vertices[i + 2];
+    const TMeshVector3& p0 = vertices.position(i);
+    const TMeshVector3& p1 = vertices.position(i + 1);
+    const TMeshVector3& p2 = vertices.position(i + 2);
 
     // The Y axis has previously been inverted, so undo that before
     // computing the normal direction. Then invert the Y coordinate of the
     // normal, too.
 
-    TMeshVector3 v01 = v1.Position - v0.Position;
+    TMeshVector3 v01 = p1 - p0;
     v01.Y = -v01.Y;
-    TMeshVector3 v02 = v2.Position - v0.Position;
+    TMeshVector3 v02 = p2 - p0;
     v02.Y = -v02.Y;
     TMeshVector3 normal = TMeshVector3::CrossProduct(v01, v02);
 
     normal.Y = -normal.Y;
 
-    v0.TangentX = v1.TangentX = v2.TangentX = TMeshVector3(0.0f);
-    v0.TangentY = v1.TangentY = v2.TangentY = TMeshVector3(0.0f);
-    v0.TangentZ = v1.TangentZ = v2.TangentZ = normal.GetSafeNormal();
+    if (hasTangents) {
+      for (int j = i; j < i + 3; ++j) {
+        vertices.tangentX[j] = vertices.tangentY[j] = TMeshVector3(0.0f);
+      }
+    }
+    vertices.tangentZ[i] = vertices.tangentZ[i + 1] = vertices.tangentZ[i + 2] =
+        normal.GetSafeNormal();
   }
 }
 
-template <typename TIndex>
-static TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>
-BuildChaosTriangleMeshes(
-    const TArray<FStaticMeshBuildVertex>& vertexData,
-    const TArray<uint32>& indices);
-
 static const Material defaultMaterial;
 static const MaterialPBRMetallicRoughness defaultPbrMetallicRoughness;
 
 struct ColorVisitor {
   bool duplicateVertices;
-  TArray<FStaticMeshBuildVertex>& StaticMeshBuildVertices;
+  int32 vertexCount;
+  FColorVertexBuffer& ColorVertexBuffer;
   const TArray<uint32>& indices;
 
   bool operator()(AccessorView<nullptr_t>&& invalidView) { return false; }
@@ -338,29 +358,34 @@ struct ColorVisitor {
       return false;
     }
 
+    this->ColorVertexBuffer.Init(uint32(this->vertexCount), false);
+
     bool success = true;
     if (duplicateVertices) {
       for (int i = 0; success && i < this->indices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = this->StaticMeshBuildVertices[i];
+        FColor& color = this->ColorVertexBuffer.VertexColor(uint32(i));
         uint32 vertexIndex = this->indices[i];
         if (vertexIndex >= colorView.size()) {
           success = false;
         } else {
-          success =
-              ColorVisitor::convertColor(colorView[vertexIndex], vertex.Color);
+          success = ColorVisitor::convertColor(colorView[vertexIndex], color);
         }
       }
     } else {
-      for (int i = 0; success && i < this->StaticMeshBuildVertices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = this->StaticMeshBuildVertices[i];
+      for (int i = 0; success && i < this->vertexCount; ++i) {
+        FColor& color = this->ColorVertexBuffer.VertexColor(uint32(i));
         if (i >= colorView.size()) {
           success = false;
         } else {
-          success = ColorVisitor::convertColor(colorView[i], vertex.Color);
+          success = ColorVisitor::convertColor(colorView[i], color);
         }
       }
     }
 
+    if (!success) {
+      this->ColorVertexBuffer.CleanUp();
+    }
+
     return success;
   }
 
@@ -407,11 +432,25 @@ struct ColorVisitor {
   }
 };
 
+static TSharedPtr<CesiumTextureUtility::LoadedTextureResult>
+loadSharedTexture(
+    CesiumGltf::Model& model,
+    const CesiumGltf::Texture& texture,
+    bool sRGB) {
+  TUniquePtr<CesiumTextureUtility::LoadedTextureResult> pResult =
+      loadTextureAnyThreadPart(model, texture, sRGB);
+  if (!pResult) {
+    return nullptr;
+  }
+  return MakeShareable(pResult.Release());
+}
+
 template <class T>
-static TUniquePtr<CesiumTextureUtility::LoadedTextureResult> loadTexture(
+static TSharedPtr<CesiumTextureUtility::LoadedTextureResult> loadTexture(
     CesiumGltf::Model& model,
     const std::optional<T>& gltfTexture,
-    bool sRGB) {
+    bool sRGB,
+    std::vector<ImageTextureCache>* pTextureCaches) {
   if (!gltfTexture || gltfTexture.value().index < 0 ||
       gltfTexture.value().index >= model.textures.size()) {
     if (gltfTexture && gltfTexture.value().index >= 0) {
@@ -428,13 +467,47 @@ static TUniquePtr<CesiumTextureUtility::LoadedTextureResult> loadTexture(
   const CesiumGltf::Texture& texture =
       model.textures[gltfTexture.value().index];
 
-  return loadTextureAnyThreadPart(model, texture, sRGB);
+  const int32_t source =
+      pTextureCaches ? getTextureSourceIndex(model, texture) : -1;
+  if (source < 0 || size_t(source) >= pTextureCaches->size()) {
+    return loadSharedTexture(model, texture, sRGB);
+  }
+
+  ImageTextureCache& cache = (*pTextureCaches)[size_t(source)];
+  std::lock_guard<std::mutex> lock(cache.mutex);
+
+  ImageTextureCache::Entry* pEntry = nullptr;
+  for (ImageTextureCache::Entry& entry : cache.entries) {
+    if (entry.sampler == texture.sampler && entry.sRGB == sRGB) {
+      pEntry = &entry;
+      break;
+    }
+  }
+
+  if (pEntry) {
+    TSharedPtr<CesiumTextureUtility::LoadedTextureResult> pCached =
+        pEntry->pTexture.Pin();
+    if (pCached) {
+      return pCached;
+    }
+  }
+
+  TSharedPtr<CesiumTextureUtility::LoadedTextureResult> pResult =
+      loadSharedTexture(model, texture, sRGB);
+  if (pEntry) {
+    pEntry->pTexture = pResult;
+  } else if (pResult) {
+    cache.entries.push_back({texture.sampler, sRGB, pResult});
+  }
+
+  return pResult;
 }
 
 static void applyWaterMask(
     Model& model,
     const MeshPrimitive& primitive,
-    LoadPrimitiveResult& primitiveResult) {
+    LoadPrimitiveResult& primitiveResult,
+    std::vector<ImageTextureCache>* pTextureCaches) {
   // Initialize water mask if needed.
   auto onlyWaterIt = primitive.extras.find("OnlyWater");
   auto onlyLandIt = primitive.extras.find("OnlyLand");
@@ -456,8 +529,11 @@ static void applyWaterMask(
         waterMaskInfo.index = waterMaskTextureId;
         if (waterMaskTextureId >= 0 &&
             waterMaskTextureId < model.textures.size()) {
-          primitiveResult.waterMaskTexture =
-              loadTexture(model, std::make_optional(waterMaskInfo), false);
+          primitiveResult.waterMaskTexture = loadTexture(
+              model,
+              std::make_optional(waterMaskInfo),
+              false,
+              pTextureCaches);
         }
       }
     }
@@ -568,7 +644,7 @@ static void updateTextureCoordinatesForFeaturesMetadata(
     const Model& model,
     const MeshPrimitive& primitive,
     bool duplicateVertices,
-    TArray<FStaticMeshBuildVertex>& vertices,
+    CesiumPrimitiveVertices& vertices,
     const TArray<uint32>& indices,
     const FCesiumPrimitiveFeatures& primitiveFeatures,
     const CesiumEncodedFeaturesMetadata::EncodedPrimitiveFeatures&
@@ -648,29 +724,29 @@ static void updateTextureCoordinatesForFeaturesMetadata(
 
       // We encode unsigned integer feature ids as floats in the u-channel of
       // a texture coordinate slot.
+      TArray<TMeshVector2>& texCoords =
+          vertices.texCoords(textureCoordinateIndex);
       if (duplicateVertices) {
         for (int64_t i = 0; i < indices.Num(); ++i) {
-          FStaticMeshBuildVertex& vertex = vertices[i];
           uint32 vertexIndex = indices[i];
           if (vertexIndex >= 0 && vertexIndex < vertexCount) {
             float featureId = static_cast<float>(
                 UCesiumFeatureIdAttributeBlueprintLibrary::
                     GetFeatureIDForVertex(featureIDAttribute, vertexIndex));
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(featureId, 0.0f);
+            texCoords[i] = TMeshVector2(featureId, 0.0f);
           } else {
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(0.0f, 0.0f);
+            texCoords[i] = TMeshVector2(0.0f, 0.0f);
           }
         }
       } else {
-        for (int64_t i = 0; i < vertices.Num(); ++i) {
-          FStaticMeshBuildVertex& vertex = vertices[i];
+        for (int64_t i = 0; i < vertices.count; ++i) {
           if (i < vertexCount) {
             float featureId = static_cast<float>(
                 UCesiumFeatureIdAttributeBlueprintLibrary::
                     GetFeatureIDForVertex(featureIDAttribute, i));
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(featureId, 0.0f);
+            texCoords[i] = TMeshVector2(featureId, 0.0f);
           } else {
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(0.0f, 0.0f);
+            texCoords[i] = TMeshVector2(0.0f, 0.0f);
           }
         }
       }
@@ -700,18 +776,16 @@ static void updateTextureCoordinatesForFeaturesMetadata(
       featuresMetadataTexcoordParameters.Emplace(
           encodedFeatureIDSet.name,
           textureCoordinateIndex);
+      TArray<TMeshVector2>& texCoords =
+          vertices.texCoords(textureCoordinateIndex);
       if (duplicateVertices) {
         for (int64_t i = 0; i < indices.Num(); ++i) {
-          FStaticMeshBuildVertex& vertex = vertices[i];
           uint32 vertexIndex = indices[i];
-          vertex.UVs[textureCoordinateIndex] =
-              TMeshVector2(static_cast<float>(vertexIndex), 0.0f);
+          texCoords[i] = TMeshVector2(static_cast<float>(vertexIndex), 0.0f);
         }
       } else {
-        for (int64_t i = 0; i < vertices.Num(); ++i) {
-          FStaticMeshBuildVertex& vertex = vertices[i];
-          vertex.UVs[textureCoordinateIndex] =
-              TMeshVector2(static_cast<float>(i), 0.0f);
+        for (int64_t i = 0; i < vertices.count; ++i) {
+          texCoords[i] = TMeshVector2(static_cast<float>(i), 0.0f);
         }
       }
     }
@@ -722,7 +796,7 @@ static void updateTextureCoordinatesForMetadata_DEPRECATED(
     const Model& model,
     const MeshPrimitive& primitive,
     bool duplicateVertices,
-    TArray<FStaticMeshBuildVertex>& vertices,
+    CesiumPrimitiveVertices& vertices,
     const TArray<uint32>& indices,
     const CesiumEncodedMetadataUtility::EncodedMetadata& encodedMetadata,
     const CesiumEncodedMetadataUtility::EncodedMetadataPrimitive&
@@ -805,29 +879,29 @@ static void updateTextureCoordinatesForMetadata_DEPRECATED(
 
       // We encode unsigned integer feature ids as floats in the u-channel of
       // a texture coordinate slot.
+      TArray<TMeshVector2>& texCoords =
+          vertices.texCoords(textureCoordinateIndex);
       if (duplicateVertices) {
         for (int64_t i = 0; i < indices.Num(); ++i) {
-          FStaticMeshBuildVertex& vertex = vertices[i];
           uint32 vertexIndex = indices[i];
           if (vertexIndex >= 0 && vertexIndex < vertexCount) {
             float featureId = static_cast<float>(
                 UCesiumFeatureIdAttributeBlueprintLibrary::
                     GetFeatureIDForVertex(featureIdAttribute, vertexIndex));
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(featureId, 0.0f);
+            texCoords[i] = TMeshVector2(featureId, 0.0f);
           } else {
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(0.0f, 0.0f);
+            texCoords[i] = TMeshVector2(0.0f, 0.0f);
           }
         }
       } else {
-        for (int64_t i = 0; i < vertices.Num(); ++i) {
-          FStaticMeshBuildVertex& vertex = vertices[i];
+        for (int64_t i = 0; i < vertices.count; ++i) {
           if (i < vertexCount) {
             float featureId = static_cast<float>(
                 UCesiumFeatureIdAttributeBlueprintLibrary::
                     GetFeatureIDForVertex(featureIdAttribute, i));
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(featureId, 0.0f);
+            texCoords[i] = TMeshVector2(featureId, 0.0f);
           } else {
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(0.0f, 0.0f);
+            texCoords[i] = TMeshVector2(0.0f, 0.0f);
           }
         }
       }
@@ -1031,7 +1105,10 @@ static void loadPrimitive(
     }
   }
 
-  applyWaterMask(model, primitive, primitiveResult);
+  std::vector<ImageTextureCache>* pTextureCaches =
+      options.pMeshOptions->pNodeOptions->pModelOptions->pTextureCaches;
+
+  applyWaterMask(model, primitive, primitiveResult, pTextureCaches);
 
   // The water effect works by animating the normal, and the normal is
   // expressed in tangent space. So if we have water, we need tangents.
@@ -1116,39 +1193,38 @@ static void loadPrimitive(
   duplicateVertices =
       duplicateVertices && primitive.mode != MeshPrimitive::Mode::POINTS;
 
-  TArray<FStaticMeshBuildVertex> StaticMeshBuildVertices;
-  StaticMeshBuildVertices.SetNum(
+  CesiumPrimitiveVertices vertices(
+      LODResources.VertexBuffers,
       duplicateVertices ? indices.Num()
                         : static_cast<int>(positionView.size()));
+  if (hasTangents || needsTangents) {
+    vertices.allocateTangents();
+  }
 
   {
     if (duplicateVertices) {
       TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyDuplicatedPositions)
       for (int i = 0; i < indices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = StaticMeshBuildVertices[i];
+        TMeshVector3& position = vertices.position(i);
         uint32 vertexIndex = indices[i];
         const TMeshVector3& pos = positionView[vertexIndex];
-        vertex.Position.X = pos.X;
-        vertex.Position.Y = -pos.Y;
-        vertex.Position.Z = pos.Z;
-        vertex.UVs[0] = TMeshVector2(0.0f, 0.0f);
-        vertex.UVs[2] = TMeshVector2(0.0f, 0.0f);
+        position.X = pos.X;
+        position.Y = -pos.Y;
+        position.Z = pos.Z;
         RenderData->Bounds.SphereRadius = FMath::Max(
-            (FVector(vertex.Position) - RenderData->Bounds.Origin).Size(),
+            (FVector(position) - RenderData->Bounds.Origin).Size(),
             RenderData->Bounds.SphereRadius);
       }
     } else {
       TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyPositions)
-      for (int i = 0; i < StaticMeshBuildVertices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = StaticMeshBuildVertices[i];
+      for (int i = 0; i < vertices.count; ++i) {
+        TMeshVector3& position = vertices.position(i);
         const TMeshVector3& pos = positionView[i];
-        vertex.Position.X = pos.X;
-        vertex.Position.Y = -pos.Y;
-        vertex.Position.Z = pos.Z;
-        vertex.UVs[0] = TMeshVector2(0.0f, 0.0f);
-        vertex.UVs[2] = TMeshVector2(0.0f, 0.0f);
+        position.X = pos.X;
+        position.Y = -pos.Y;
+        position.Z = pos.Z;
         RenderData->Bounds.SphereRadius = FMath::Max(
-            (FVector(vertex.Position) - RenderData->Bounds.Origin).Size(),
+            (FVector(position) - RenderData->Bounds.Origin).Size(),
             RenderData->Bounds.SphereRadius);
       }
     }
@@ -1163,31 +1239,39 @@ static void loadPrimitive(
     hasVertexColors = createAccessorView(
         model,
         colorAccessorID,
-        ColorVisitor{duplicateVertices, StaticMeshBuildVertices, indices});
+        ColorVisitor{
+            duplicateVertices,
+            vertices.count,
+            LODResources.VertexBuffers.ColorVertexBuffer,
+            indices});
   }
 
   LODResources.bHasColorVertexData = hasVertexColors;
 
   // We need to copy the texture coordinates associated with each texture (if
-  // any) into the the appropriate UVs slot in FStaticMeshBuildVertex.
+  // any) into the the appropriate Unreal texture coordinate set.
 
   std::unordered_map<int32_t, uint32_t>& gltfToUnrealTexCoordMap =
       primitiveResult.GltfToUnrealTexCoordMap;
 
   {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadTextures)
-    primitiveResult.baseColorTexture =
-        loadTexture(model, pbrMetallicRoughness.baseColorTexture, true);
+    primitiveResult.baseColorTexture = loadTexture(
+        model,
+        pbrMetallicRoughness.baseColorTexture,
+        true,
+        pTextureCaches);
     primitiveResult.metallicRoughnessTexture = loadTexture(
         model,
         pbrMetallicRoughness.metallicRoughnessTexture,
-        false);
+        false,
+        pTextureCaches);
     primitiveResult.normalTexture =
-        loadTexture(model, material.normalTexture, false);
+        loadTexture(model, material.normalTexture, false, pTextureCaches);
     primitiveResult.occlusionTexture =
-        loadTexture(model, material.occlusionTexture, false);
+        loadTexture(model, material.occlusionTexture, false, pTextureCaches);
     primitiveResult.emissiveTexture =
-        loadTexture(model, material.emissiveTexture, true);
+        loadTexture(model, material.emissiveTexture, true, pTextureCaches);
   }
 
   {
@@ -1199,7 +1283,7 @@ static void loadPrimitive(
             model,
             primitive,
             duplicateVertices,
-            StaticMeshBuildVertices,
+            vertices,
             indices,
             pbrMetallicRoughness.baseColorTexture,
             gltfToUnrealTexCoordMap);
@@ -1208,7 +1292,7 @@ static void loadPrimitive(
         model,
         primitive,
         duplicateVertices,
-        StaticMeshBuildVertices,
+        vertices,
         indices,
         pbrMetallicRoughness.metallicRoughnessTexture,
         gltfToUnrealTexCoordMap);
@@ -1218,7 +1302,7 @@ static void loadPrimitive(
             model,
             primitive,
             duplicateVertices,
-            StaticMeshBuildVertices,
+            vertices,
             indices,
             material.normalTexture,
             gltfToUnrealTexCoordMap);
@@ -1228,7 +1312,7 @@ static void loadPrimitive(
             model,
             primitive,
             duplicateVertices,
-            StaticMeshBuildVertices,
+            vertices,
             indices,
             material.occlusionTexture,
             gltfToUnrealTexCoordMap);
@@ -1238,7 +1322,7 @@ static void loadPrimitive(
             model,
             primitive,
             duplicateVertices,
-            StaticMeshBuildVertices,
+            vertices,
             indices,
             material.emissiveTexture,
             gltfToUnrealTexCoordMap);
@@ -1254,7 +1338,7 @@ static void loadPrimitive(
                 model,
                 primitive,
                 duplicateVertices,
-                StaticMeshBuildVertices,
+                vertices,
                 indices,
                 attributeName,
                 gltfToUnrealTexCoordMap);
@@ -1308,7 +1392,7 @@ static void loadPrimitive(
         model,
         primitive,
         duplicateVertices,
-        StaticMeshBuildVertices,
+        vertices,
         indices,
         primitiveResult.Features,
         primitiveResult.EncodedFeatures,
@@ -1326,7 +1410,7 @@ static void loadPrimitive(
         model,
         primitive,
         duplicateVertices,
-        StaticMeshBuildVertices,
+        vertices,
         indices,
         *pModelResult->EncodedMetadata_DEPRECATED,
         *primitiveResult.EncodedMetadata_DEPRECATED,
@@ -1345,25 +1429,21 @@ static void loadPrimitive(
     if (duplicateVertices) {
       TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyNormalsForDuplicatedVertices)
       for (int i = 0; i < indices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = StaticMeshBuildVertices[i];
+        TMeshVector3& tangentZ = vertices.tangentZ[i];
         uint32 vertexIndex = indices[i];
-        vertex.TangentX = TMeshVector3(0.0f, 0.0f, 0.0f);
-        vertex.TangentY = TMeshVector3(0.0f, 0.0f, 0.0f);
         const TMeshVector3& normal = normalAccessor[vertexIndex];
-        vertex.TangentZ.X = normal.X;
-        vertex.TangentZ.Y = -normal.Y;
-        vertex.TangentZ.Z = normal.Z;
+        tangentZ.X = normal.X;
+        tangentZ.Y = -normal.Y;
+        tangentZ.Z = normal.Z;
       }
     } else {
       TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyNormals)
-      for (int i = 0; i < StaticMeshBuildVertices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = StaticMeshBuildVertices[i];
-        vertex.TangentX = TMeshVector3(0.0f, 0.0f, 0.0f);
-        vertex.TangentY = TMeshVector3(0.0f, 0.0f, 0.0f);
+      for (int i = 0; i < vertices.count; ++i) {
+        TMeshVector3& tangentZ = vertices.tangentZ[i];
         const TMeshVector3& normal = normalAccessor[i];
-        vertex.TangentZ.X = normal.X;
-        vertex.TangentZ.Y = -normal.Y;
-        vertex.TangentZ.Z = normal.Z;
+        tangentZ.X = normal.X;
+        tangentZ.Y = -normal.Y;
+        tangentZ.Z = normal.Z;
       }
     }
   } else {
@@ -1378,10 +1458,10 @@ static void loadPrimitive(
                   glm::dvec3(ecefCenter)),
               0.0)));
       upDir.Y *= -1;
-      setUniformNormals(indices, StaticMeshBuildVertices, upDir);
+      setUniformNormals(indices, vertices, upDir);
     } else {
       TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ComputeFlatNormals)
-      computeFlatNormals(indices, StaticMeshBuildVertices);
+      computeFlatNormals(indices, vertices);
     }
   }
 
@@ -1389,27 +1469,26 @@ static void loadPrimitive(
     if (duplicateVertices) {
       TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyTangentsForDuplicatedVertices)
       for (int i = 0; i < indices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = StaticMeshBuildVertices[i];
+        TMeshVector3& tangentX = vertices.tangentX[i];
         uint32 vertexIndex = indices[i];
         const TMeshVector4& tangent = tangentAccessor[vertexIndex];
-        vertex.TangentX.X = tangent.X;
-        vertex.TangentX.Y = -tangent.Y;
-        vertex.TangentX.Z = tangent.Z;
-        vertex.TangentY =
-            TMeshVector3::CrossProduct(vertex.TangentZ, vertex.TangentX) *
+        tangentX.X = tangent.X;
+        tangentX.Y = -tangent.Y;
+        tangentX.Z = tangent.Z;
+        vertices.tangentY[i] =
+            TMeshVector3::CrossProduct(vertices.tangentZ[i], tangentX) *
             tangent.W;
       }
     } else {
       TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyTangents)
-      for (int i = 0; i < StaticMeshBuildVertices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = StaticMeshBuildVertices[i];
+      for (int i = 0; i < vertices.count; ++i) {
+        TMeshVector3& tangentX = vertices.tangentX[i];
         const TMeshVector4& tangent = tangentAccessor[i];
-        vertex.TangentX = tangent;
-        vertex.TangentX.X = tangent.X;
-        vertex.TangentX.Y = -tangent.Y;
-        vertex.TangentX.Z = tangent.Z;
-        vertex.TangentY =
-            TMeshVector3::CrossProduct(vertex.TangentZ, vertex.TangentX) *
+        tangentX.X = tangent.X;
+        tangentX.Y = -tangent.Y;
+        tangentX.Z = tangent.Z;
+        vertices.tangentY[i] =
+            TMeshVector3::CrossProduct(vertices.tangentZ[i], tangentX) *
             tangent.W;
       }
     }
@@ -1419,33 +1498,74 @@ static void loadPrimitive(
     // Use mikktspace to calculate the tangents.
     // Note that this assumes normals and UVs are already populated.
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ComputeTangents)
-    computeTangentSpace(StaticMeshBuildVertices);
+    computeTangentSpace(vertices);
   }
 
-  {
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::InitBuffers)
-
-    // Set to full precision (32-bit) UVs. This is especially important for
-    // metadata because integer feature IDs can and will lose meaningful
-    // precision when using 16-bit floats.
-    LODResources.VertexBuffers.StaticMeshVertexBuffer.SetUseFullPrecisionUVs(
-        true);
-
-    LODResources.VertexBuffers.PositionVertexBuffer.Init(
-        StaticMeshBuildVertices,
-        false);
+  // The physics mesh is built from the glTF positions and indices, before the
+  // indices are changed to refer to duplicated vertices, so that vertices are
+  // never duplicated in it.
+  if (primitive.mode != MeshPrimitive::Mode::POINTS &&
+      options.pMeshOptions->pNodeOptions->pModelOptions->createPhysicsMeshes &&
+      positionView.size() != 0 && indices.Num() != 0) {
+    const int32 positionCount = static_cast<int32>(positionView.size());
+    if (options.pMeshOptions->pNodeOptions->pModelOptions
+            ->createPhysicsMeshesOnDemand) {
+      // Keep the triangles, so that the tileset can build the physics mesh
+      // later if something comes close enough to collide with it.
+      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::KeepPhysicsMeshSource)
+      auto pSource = MakeShared<
+          CesiumPhysicsMeshes::TriangleSource,
+          ESPMode::ThreadSafe>();
+      pSource->positions.SetNumUninitialized(positionCount);
+      for (int32 i = 0; i < positionCount; ++i) {
+        const TMeshVector3& pos = positionView[i];
+        pSource->positions[i] = FVector3f(pos.X, -pos.Y, pos.Z);
+      }
+      pSource->indices = indices;
+      primitiveResult.pPhysicsMeshSource = MoveTemp(pSource);
+    } else {
+      Chaos::TParticles<Chaos::FRealSingle, 3> chaosVertices;
+      chaosVertices.AddParticles(positionCount);
+      for (int32 i = 0; i < positionCount; ++i) {
+        const TMeshVector3& pos = positionView[i];
+        chaosVertices.X(i) = FVector3f(pos.X, -pos.Y, pos.Z);
+      }
+      primitiveResult.collisionMeshes =
+          CesiumPhysicsMeshes::buildTriangleMeshes(
+              MoveTemp(chaosVertices),
+              indices);
+    }
+  }
 
-    FColorVertexBuffer& ColorVertexBuffer =
-        LODResources.VertexBuffers.ColorVertexBuffer;
-    if (hasVertexColors) {
-      ColorVertexBuffer.Init(StaticMeshBuildVertices, false);
+  if (duplicateVertices) {
+    if (options.pMeshOptions->pNodeOptions->pModelOptions
+            ->weldGeneratedVertices) {
+      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::WeldVertices)
+      const int32 duplicatedCount = vertices.count;
+      const int32 removed =
+          vertices.weld(indices, static_cast<int32>(positionView.size()));
+      INC_DWORD_STAT_BY(STAT_CesiumWeldedVertices, removed);
+      UE_LOG(
+          LogCesium,
+          VeryVerbose,
+          TEXT("Welded %d generated vertices into %d (%d glTF vertices)."),
+          duplicatedCount,
+          vertices.count,
+          static_cast<int32>(positionView.size()));
+    } else {
+      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ReverseWindingOrder)
+      for (int32 i = 0; i < indices.Num(); i++) {
+        indices[i] = i;
+      }
     }
+  }
+
+  {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::InitBuffers)
 
-    LODResources.VertexBuffers.StaticMeshVertexBuffer.Init(
-        StaticMeshBuildVertices,
-        gltfToUnrealTexCoordMap.size() == 0 ? 1
-                                            : gltfToUnrealTexCoordMap.size(),
-        false);
+    // The position and color buffers have already been written.
+    vertices.initStaticMeshVertexBuffer(
+        uint32(gltfToUnrealTexCoordMap.size()));
   }
 
   FStaticMeshSectionArray& Sections = LODResources.Sections;
@@ -1454,23 +1574,16 @@ static void loadPrimitive(
   section.NumTriangles = indices.Num() / 3;
   section.FirstIndex = 0;
   section.MinVertexIndex = 0;
-  section.MaxVertexIndex = StaticMeshBuildVertices.Num() - 1;
+  section.MaxVertexIndex = vertices.count - 1;
   section.bEnableCollision = primitive.mode != MeshPrimitive::Mode::POINTS;
   section.bCastShadow = true;
   section.MaterialIndex = 0;
 
-  if (duplicateVertices) {
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ReverseWindingOrder)
-    for (int32 i = 0; i < indices.Num(); i++) {
-      indices[i] = i;
-    }
-  }
-
   {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetIndices)
     LODResources.IndexBuffer.SetIndices(
         indices,
-        StaticMeshBuildVertices.Num() >= std::numeric_limits<uint16>::max()
+        vertices.count >= std::numeric_limits<uint16>::max()
             ? EIndexBufferStride::Type::Force32Bit
             : EIndexBufferStride::Type::Force16Bit);
   }
@@ -1486,7 +1599,6 @@ static void loadPrimitive(
   primitiveResult.pMeshPrimitive = &primitive;
   primitiveResult.RenderData = std::move(RenderData);
   primitiveResult.pMaterial = &material;
-  primitiveResult.pCollisionMesh = nullptr;
 
   // This matrix converts from right-handed Z-up to Unreal
   // left-handed Z-up by flipping the Y axis. It effectively undoes the Y-axis
@@ -1513,21 +1625,6 @@ static void loadPrimitive(
       1.0};
 
   primitiveResult.transform = transform * yInvertMatrix;
-
-  if (primitive.mode != MeshPrimitive::Mode::POINTS &&
-      options.pMeshOptions->pNodeOptions->pModelOptions->createPhysicsMeshes) {
-    if (StaticMeshBuildVertices.Num() != 0 && indices.Num() != 0) {
-      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ChaosCook)
-      primitiveResult.pCollisionMesh =
-          StaticMeshBuildVertices.Num() < TNumericLimits<uint16>::Max()
-              ? BuildChaosTriangleMeshes<uint16>(
-                    StaticMeshBuildVertices,
-                    indices)
-              : BuildChaosTriangleMeshes<int32>(
-                    StaticMeshBuildVertices,
-                    indices);
-    }
-  }
 }
 
 static void loadIndexedPrimitive(
@@ -1636,34 +1733,69 @@ static void loadPrimitive(
   result.PositionAccessor = std::move(positionView);
 }
 
+namespace {
+/**
+ * @brief A primitive found while walking the scene graph of a model. The
+ * primitives are loaded in parallel once the walk is complete and the node
+ * results no longer move.
+ */
+struct PrimitiveLoadJob {
+  CreateNodeOptions nodeOptions;
+  const Mesh* pMesh;
+  const MeshPrimitive* pPrimitive;
+  glm::dmat4x4 transform;
+  size_t nodeIndex;
+  size_t primitiveIndex;
+};
+} // namespace
+
 static void loadMesh(
-    std::optional<LoadMeshResult>& result,
+    std::vector<LoadNodeResult>& loadNodeResults,
+    size_t nodeIndex,
     const glm::dmat4x4& transform,
-    const CreateMeshOptions& options) {
+    const CreateMeshOptions& options,
+    std::vector<PrimitiveLoadJob>& primitiveJobs) {
 
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadMesh)
 
-  const Model& model = *options.pNodeOptions->pModelOptions->pModel;
   const Mesh& mesh = *options.pMesh;
 
+  std::optional<LoadMeshResult>& result =
+      loadNodeResults[nodeIndex].meshResult;
   result = LoadMeshResult();
-  result->primitiveResults.reserve(mesh.primitives.size());
-  for (const CesiumGltf::MeshPrimitive& primitive : mesh.primitives) {
-    CreatePrimitiveOptions primitiveOptions = {&options, &*result, &primitive};
-    auto& primitiveResult = result->primitiveResults.emplace_back();
-    loadPrimitive(primitiveResult, transform, primitiveOptions);
-
-    // if it doesn't have render data, then it can't be loaded
-    if (!primitiveResult.RenderData) {
-      result->primitiveResults.pop_back();
-    }
+  result->primitiveResults.resize(mesh.primitives.size());
+  for (size_t i = 0; i < mesh.primitives.size(); ++i) {
+    primitiveJobs.push_back(PrimitiveLoadJob{
+        *options.pNodeOptions,
+        &mesh,
+        &mesh.primitives[i],
+        transform,
+        nodeIndex,
+        i});
   }
 }
 
+static void
+loadPrimitiveJob(LoadModelResult& modelResult, PrimitiveLoadJob& job) {
+  LoadNodeResult& nodeResult = modelResult.nodeResults[job.nodeIndex];
+  LoadMeshResult& meshResult = *nodeResult.meshResult;
+
+  CreateMeshOptions meshOptions = {&job.nodeOptions, &nodeResult, job.pMesh};
+  CreatePrimitiveOptions primitiveOptions = {
+      &meshOptions,
+      &meshResult,
+      job.pPrimitive};
+  loadPrimitive(
+      meshResult.primitiveResults[job.primitiveIndex],
+      job.transform,
+      primitiveOptions);
+}
+
 static void loadNode(
     std::vector<LoadNodeResult>& loadNodeResults,
     const glm::dmat4x4& transform,
-    const CreateNodeOptions& options) {
+    const CreateNodeOptions& options,
+    std::vector<PrimitiveLoadJob>& primitiveJobs) {
 
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadNode)
 
@@ -1688,7 +1820,10 @@ static void loadNode(
   const Model& model = *options.pModelOptions->pModel;
   const Node& node = *options.pNode;
 
-  LoadNodeResult& result = loadNodeResults.emplace_back();
+  // Child nodes are appended to loadNodeResults, so refer to this node's
+  // result by index.
+  const size_t nodeIndex = loadNodeResults.size();
+  loadNodeResults.emplace_back();
 
   glm::dmat4x4 nodeTransform = transform;
 
@@ -1738,8 +1873,16 @@ static void loadNode(
 
   int meshId = node.mesh;
   if (meshId >= 0 && meshId < model.meshes.size()) {
-    CreateMeshOptions meshOptions = {&options, &result, &model.meshes[meshId]};
-    loadMesh(result.meshResult, nodeTransform, meshOptions);
+    CreateMeshOptions meshOptions = {
+        &options,
+        &loadNodeResults[nodeIndex],
+        &model.meshes[meshId]};
+    loadMesh(
+        loadNodeResults,
+        nodeIndex,
+        nodeTransform,
+        meshOptions,
+        primitiveJobs);
   }
 
   for (int childNodeId : node.children) {
@@ -1748,7 +1891,7 @@ static void loadNode(
           options.pModelOptions,
           options.pHalfConstructedModelResult,
           &model.nodes[childNodeId]};
-      loadNode(loadNodeResults, nodeTransform, childNodeOptions);
+      loadNode(loadNodeResults, nodeTransform, childNodeOptions, primitiveJobs);
     }
   }
 }
@@ -1841,34 +1984,79 @@ static void loadModelAnyThreadPart(
     applyGltfUpAxisTransform(model, rootTransform);
   }
 
+  std::vector<ImageTextureCache> textureCaches(model.images.size());
+  CreateModelOptions modelOptions = options;
+  modelOptions.pTextureCaches = &textureCaches;
+
+  std::vector<PrimitiveLoadJob> primitiveJobs;
+
   if (model.scene >= 0 && model.scene < model.scenes.size()) {
     // Show the default scene
     const Scene& defaultScene = model.scenes[model.scene];
     for (int nodeId : defaultScene.nodes) {
-      CreateNodeOptions nodeOptions = {&options, &result, &model.nodes[nodeId]};
-      loadNode(result.nodeResults, rootTransform, nodeOptions);
+      CreateNodeOptions nodeOptions = {
+          &modelOptions,
+          &result,
+          &model.nodes[nodeId]};
+      loadNode(result.nodeResults, rootTransform, nodeOptions, primitiveJobs);
     }
   } else if (model.scenes.size() > 0) {
     // There's no default, so show the first scene
     const Scene& defaultScene = model.scenes[0];
     for (int nodeId : defaultScene.nodes) {
-      CreateNodeOptions nodeOptions = {&options, &result, &model.nodes[nodeId]};
-      loadNode(result.nodeResults, rootTransform, nodeOptions);
+      CreateNodeOptions nodeOptions = {
+          &modelOptions,
+          &result,
+          &model.nodes[nodeId]};
+      loadNode(result.nodeResults, rootTransform, nodeOptions, primitiveJobs);
     }
   } else if (model.nodes.size() > 0) {
     // No scenes at all, use the first node as the root node.
-    CreateNodeOptions nodeOptions = {&options, &result, &model.nodes[0]};
-    loadNode(result.nodeResults, rootTransform, nodeOptions);
+    CreateNodeOptions nodeOptions = {&modelOptions, &result, &model.nodes[0]};
+    loadNode(result.nodeResults, rootTransform, nodeOptions, primitiveJobs);
   } else if (model.meshes.size() > 0) {
     // No nodes either, show all the meshes.
     for (const Mesh& mesh : model.meshes) {
-      CreateNodeOptions dummyNodeOptions = {&options, &result, nullptr};
+      CreateNodeOptions dummyNodeOptions = {&modelOptions, &result, nullptr};
+      const size_t dummyNodeIndex = result.nodeResults.size();
       LoadNodeResult& dummyNodeResult = result.nodeResults.emplace_back();
       CreateMeshOptions meshOptions = {
           &dummyNodeOptions,
           &dummyNodeResult,
           &mesh};
-      loadMesh(dummyNodeResult.meshResult, rootTransform, meshOptions);
+      loadMesh(
+          result.nodeResults,
+          dummyNodeIndex,
+          rootTransform,
+          meshOptions,
+          primitiveJobs);
+    }
+  }
+
+  // The primitives are independent of each other, so a tile with many
+  // primitives is loaded by several workers at once.
+  {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadPrimitives)
+    getTaskProcessor()->parallelFor(
+        int32(primitiveJobs.size()),
+        [&result, &primitiveJobs](int32 i) {
+          loadPrimitiveJob(result, primitiveJobs[size_t(i)]);
+        });
+  }
+
+  // If a primitive doesn't have render data, then it can't be loaded.
+  for (LoadNodeResult& nodeResult : result.nodeResults) {
+    if (nodeResult.meshResult) {
+      std::vector<LoadPrimitiveResult>& primitiveResults =
+          nodeResult.meshResult->primitiveResults;
+      primitiveResults.erase(
+          std::remove_if(
+              primitiveResults.begin(),
+              primitiveResults.end(),
+              [](const LoadPrimitiveResult& primitiveResult) {
+                return !primitiveResult.RenderData;
+              }),
+          primitiveResults.end());
     }
   }
 }
@@ -2491,7 +2679,7 @@ static void SetMetadataParameterValues_DEPRECATED(
   }
 }
 
-static void loadPrimitiveGameThreadPart(
+static UCesiumGltfPrimitiveComponent* loadPrimitiveGameThreadPart(
     const CesiumGltf::Model& model,
     UCesiumGltfComponent* pGltf,
     LoadPrimitiveResult& loadResult,
@@ -2594,10 +2782,12 @@ static void loadPrimitiveGameThreadPart(
   }
 #endif
 
-  UMaterialInstanceDynamic* pMaterial = UMaterialInstanceDynamic::Create(
-      pBaseMaterial,
-      nullptr,
-      ImportedSlotName);
+  UMaterialInstanceDynamic* pMaterial =
+      CesiumMaterialInstancePool::acquire(pBaseMaterial, ImportedSlotName);
+
+  // A new material has the default fade, and a pooled one still has the fade
+  // of its previous tile.
+  pGltf->RenderState.fadePercentage = std::numeric_limits<float>::quiet_NaN();
 
   pMaterial->SetFlags(
       RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
@@ -2765,9 +2955,8 @@ static void loadPrimitiveGameThreadPart(
   // pMesh->UpdateCollisionFromStaticMesh();
   pBodySetup->CollisionTraceFlag = ECollisionTraceFlag::CTF_UseComplexAsSimple;
 
-  if (loadResult.pCollisionMesh) {
-    pBodySetup->ChaosTriMeshes.Add(loadResult.pCollisionMesh);
-  }
+  pBodySetup->ChaosTriMeshes.Append(MoveTemp(loadResult.collisionMeshes));
+  pMesh->pPhysicsMeshSource = MoveTemp(loadResult.pPhysicsMeshSource);
 
   // Mark physics meshes created, no matter if we actually have a collision
   // mesh or not. We don't want the editor creating collision meshes itself in
@@ -2778,8 +2967,13 @@ static void loadPrimitiveGameThreadPart(
 
   pMesh->SetMobility(pGltf->Mobility);
 
+  // Primitives created after the glTF has been hidden must not show up.
+  pMesh->SetVisibility(pGltf->IsVisible());
+
   pMesh->SetupAttachment(pGltf);
   pMesh->RegisterComponent();
+
+  return pMesh;
 }
 
 /*static*/ TUniquePtr<UCesiumGltfComponent::HalfConstructed>
@@ -2802,7 +2996,8 @@ UCesiumGltfComponent::CreateOffGameThread(
     UMaterialInterface* pBaseWaterMaterial,
     FCustomDepthParameters CustomDepthParameters,
     const Cesium3DTilesSelection::Tile& tile,
-    bool createNavCollision) {
+    bool createNavCollision,
+    bool deferPrimitives) {
 
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LoadModel)
 
@@ -2844,26 +3039,76 @@ UCesiumGltfComponent::CreateOffGameThread(
     encodeMetadataGameThreadPart(*Gltf->EncodedMetadata_DEPRECATED);
   }
 
-  for (LoadNodeResult& node : pReal->loadModelResult.nodeResults) {
-    if (node.meshResult) {
-      for (LoadPrimitiveResult& primitive : node.meshResult->primitiveResults) {
-        loadPrimitiveGameThreadPart(
-            model,
-            Gltf,
-            primitive,
-            cesiumToUnrealTransform,
-            tile,
-            createNavCollision,
-            pTilesetActor);
-      }
-    }
-  }
-
+  // The tileset shows the glTF when it is rendered, so its primitives are
+  // created hidden and without collision.
   Gltf->SetVisibility(false, true);
   Gltf->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+  Gltf->_pPendingCreation = MakeUnique<PendingCreation>(PendingCreation{
+      std::move(pHalfConstructed),
+      &model,
+      &tile,
+      pTilesetActor,
+      createNavCollision});
+
+  if (!deferPrimitives) {
+    Gltf->ContinueCreation(0, TNumericLimits<double>::Max());
+  }
+
   return Gltf;
 }
 
+int32 UCesiumGltfComponent::ContinueCreation(
+    int32 maximumPrimitives,
+    double endTimeSeconds) {
+  if (!this->_pPendingCreation) {
+    return 0;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ContinueGltfCreation)
+
+  PendingCreation& pending = *this->_pPendingCreation;
+  HalfConstructedReal* pReal =
+      static_cast<HalfConstructedReal*>(pending.pHalfConstructed.Get());
+  std::vector<LoadNodeResult>& nodes = pReal->loadModelResult.nodeResults;
+
+  // The georeference may have changed since the creation started.
+  const glm::dmat4& cesiumToUnrealTransform =
+      pending.pTilesetActor->GetCesiumTilesetToGltfTransform();
+
+  int32 created = 0;
+  while (pending.nodeIndex < nodes.size()) {
+    LoadNodeResult& node = nodes[pending.nodeIndex];
+    if (!node.meshResult ||
+        pending.primitiveIndex >= node.meshResult->primitiveResults.size()) {
+      ++pending.nodeIndex;
+      pending.primitiveIndex = 0;
+      continue;
+    }
+
+    if (created > 0 &&
+        ((maximumPrimitives > 0 && created >= maximumPrimitives) ||
+         FPlatformTime::Seconds() >= endTimeSeconds)) {
+      return created;
+    }
+
+    UCesiumGltfPrimitiveComponent* pPrimitive = loadPrimitiveGameThreadPart(
+        *pending.pModel,
+        this,
+        node.meshResult->primitiveResults[pending.primitiveIndex++],
+        cesiumToUnrealTransform,
+        *pending.pTile,
+        pending.createNavCollision,
+        pending.pTilesetActor);
+    this->AttachPendingRasterTiles(pPrimitive);
+    ++created;
+  }
+
+  this->_pPendingCreation.Reset();
+  this->UpdateWorldBounds();
+  return created;
+}
+
 UCesiumGltfComponent::UCesiumGltfComponent() : USceneComponent() {
   // Structure to hold one-time initialization
   struct FConstructorStatics {
@@ -2907,45 +3152,104 @@ void UCesiumGltfComponent::UpdateTransformFromCesium(
       pPrimitive->UpdateTransformFromCesium(cesiumToUnrealTransform);
     }
   }
+
+  this->UpdateWorldBounds();
+}
+
+const FBoxSphereBounds* UCesiumGltfComponent::GetWorldBounds() {
+  if (this->_worldBoundsDirty) {
+    this->UpdateWorldBounds();
+  }
+  return this->_hasWorldBounds ? &this->_worldBounds : nullptr;
+}
+
+void UCesiumGltfComponent::OnUpdateTransform(
+    EUpdateTransformFlags UpdateTransformFlags,
+    ETeleportType Teleport) {
+  USceneComponent::OnUpdateTransform(UpdateTransformFlags, Teleport);
+
+  // The primitives are only moved along with this component after this
+  // returns, so the bounds are recomputed when they are next needed.
+  this->_worldBoundsDirty = true;
+}
+
+void UCesiumGltfComponent::OnVisibilityChanged() {
+  USceneComponent::OnVisibilityChanged();
+
+  // As above, the visibility of the primitives only changes after this
+  // returns.
+  this->_worldBoundsDirty = true;
+}
+
+void UCesiumGltfComponent::UpdateWorldBounds() {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateGltfWorldBounds)
+
+  this->_hasWorldBounds = false;
+  this->_worldBoundsDirty = false;
+
+  for (USceneComponent* pSceneComponent : this->GetAttachChildren()) {
+    UCesiumGltfPrimitiveComponent* pPrimitive =
+        Cast<UCesiumGltfPrimitiveComponent>(pSceneComponent);
+    if (!pPrimitive || !pPrimitive->IsVisible()) {
+      continue;
+    }
+
+    const FBoxSphereBounds primitiveBounds =
+        pPrimitive->CalcBounds(pPrimitive->GetComponentTransform());
+    if (primitiveBounds.SphereRadius <= 0) {
+      continue;
+    }
+
+    this->_worldBounds = this->_hasWorldBounds
+                             ? this->_worldBounds + primitiveBounds
+                             : primitiveBounds;
+    this->_hasWorldBounds = true;
+  }
 }
 
 namespace {
 
+template <typename Func>
+void forPrimitiveComponent(
+    UCesiumGltfPrimitiveComponent* pPrimitive,
+    Func&& f) {
+  UMaterialInstanceDynamic* pMaterial =
+      Cast<UMaterialInstanceDynamic>(pPrimitive->GetMaterial(0));
+
+  if (!IsValid(pMaterial) || pMaterial->IsUnreachable()) {
+    // Don't try to update the material while it's in the process of being
+    // destroyed. This can lead to the render thread freaking out when
+    // it's asked to update a parameter for a material that has been
+    // marked for garbage collection.
+    return;
+  }
+
+  UMaterialInterface* pBaseMaterial = pMaterial->Parent;
+  UMaterialInstance* pBaseAsMaterialInstance =
+      Cast<UMaterialInstance>(pBaseMaterial);
+  UCesiumMaterialUserData* pCesiumData =
+      pBaseAsMaterialInstance
+          ? pBaseAsMaterialInstance->GetAssetUserData<UCesiumMaterialUserData>()
+          : nullptr;
+
+  f(pPrimitive, pMaterial, pCesiumData);
+}
+
 template <typename Func>
 void forEachPrimitiveComponent(UCesiumGltfComponent* pGltf, Func&& f) {
   for (USceneComponent* pSceneComponent : pGltf->GetAttachChildren()) {
     UCesiumGltfPrimitiveComponent* pPrimitive =
         Cast<UCesiumGltfPrimitiveComponent>(pSceneComponent);
     if (pPrimitive) {
-      UMaterialInstanceDynamic* pMaterial =
-          Cast<UMaterialInstanceDynamic>(pPrimitive->GetMaterial(0));
-
-      if (!IsValid(pMaterial) || pMaterial->IsUnreachable()) {
-        // Don't try to update the material while it's in the process of being
-        // destroyed. This can lead to the render thread freaking out when
-        // it's asked to update a parameter for a material that has been
-        // marked for garbage collection.
-        continue;
-      }
-
-      UMaterialInterface* pBaseMaterial = pMaterial->Parent;
-      UMaterialInstance* pBaseAsMaterialInstance =
-          Cast<UMaterialInstance>(pBaseMaterial);
-      UCesiumMaterialUserData* pCesiumData =
-          pBaseAsMaterialInstance
-              ? pBaseAsMaterialInstance
-                    ->GetAssetUserData<UCesiumMaterialUserData>()
-              : nullptr;
-
-      f(pPrimitive, pMaterial, pCesiumData);
+      forPrimitiveComponent(pPrimitive, f);
     }
   }
-} // namespace
-
-} // namespace
+}
 
-void UCesiumGltfComponent::AttachRasterTile(
-    const Cesium3DTilesSelection::Tile& tile,
+void attachRasterTileToMaterial(
+    UCesiumGltfPrimitiveComponent* pPrimitive,
+    UMaterialInstanceDynamic* pMaterial,
+    UCesiumMaterialUserData* pCesiumData,
     const Cesium3DTilesSelection::RasterOverlayTile& rasterTile,
     UTexture2D* pTexture,
     const glm::dvec2& translation,
@@ -2962,68 +3266,144 @@ void UCesiumGltfComponent::AttachRasterTile(
       scale.y);
 #endif
 
+  // If this material uses material layers and has the Cesium user data, set
+  // the parameters on each material layer that maps to this overlay tile.
+  if (pCesiumData) {
+    FString name(UTF8_TO_TCHAR(rasterTile.getOverlay().getName().c_str()));
+
+    for (int32 i = 0; i < pCesiumData->LayerNames.Num(); ++i) {
+      if (pCesiumData->LayerNames[i] != name) {
+        continue;
+      }
+
+      pMaterial->SetTextureParameterValueByInfo(
+          FMaterialParameterInfo(
+              "Texture",
+              EMaterialParameterAssociation::LayerParameter,
+              i),
+          pTexture);
+      pMaterial->SetVectorParameterValueByInfo(
+          FMaterialParameterInfo(
+              "TranslationScale",
+              EMaterialParameterAssociation::LayerParameter,
+              i),
+          translationAndScale);
+      pMaterial->SetScalarParameterValueByInfo(
+          FMaterialParameterInfo(
+              "TextureCoordinateIndex",
+              EMaterialParameterAssociation::LayerParameter,
+              i),
+          static_cast<float>(
+              pPrimitive
+                  ->overlayTextureCoordinateIDToUVIndex[textureCoordinateID]));
+    }
+  } else {
+    pMaterial->SetTextureParameterValue(
+        createSafeName(rasterTile.getOverlay().getName(), "_Texture"),
+        pTexture);
+    pMaterial->SetVectorParameterValue(
+        createSafeName(rasterTile.getOverlay().getName(), "_TranslationScale"),
+        translationAndScale);
+    pMaterial->SetScalarParameterValue(
+        createSafeName(
+            rasterTile.getOverlay().getName(),
+            "_TextureCoordinateIndex"),
+        static_cast<float>(
+            pPrimitive
+                ->overlayTextureCoordinateIDToUVIndex[textureCoordinateID]));
+  }
+}
+
+} // namespace
+
+void UCesiumGltfComponent::AttachRasterTile(
+    const Cesium3DTilesSelection::Tile& tile,
+    const Cesium3DTilesSelection::RasterOverlayTile& rasterTile,
+    UTexture2D* pTexture,
+    const glm::dvec2& translation,
+    const glm::dvec2& scale,
+    int32 textureCoordinateID) {
+  if (this->_pPendingCreation) {
+    // The primitives that have not been created yet get this overlay tile
+    // when they are created.
+    PendingCreation::RasterTile attached{
+        &rasterTile,
+        pTexture,
+        translation,
+        scale,
+        textureCoordinateID};
+    std::vector<PendingCreation::RasterTile>& rasterTiles =
+        this->_pPendingCreation->rasterTiles;
+    auto it = std::find_if(
+        rasterTiles.begin(),
+        rasterTiles.end(),
+        [&rasterTile](const PendingCreation::RasterTile& existing) {
+          return existing.pRasterTile == &rasterTile;
+        });
+    if (it != rasterTiles.end()) {
+      *it = attached;
+    } else {
+      rasterTiles.push_back(attached);
+    }
+  }
+
   forEachPrimitiveComponent(
       this,
-      [&rasterTile, pTexture, &translationAndScale, textureCoordinateID](
+      [&rasterTile, pTexture, &translation, &scale, textureCoordinateID](
           UCesiumGltfPrimitiveComponent* pPrimitive,
           UMaterialInstanceDynamic* pMaterial,
           UCesiumMaterialUserData* pCesiumData) {
-        // If this material uses material layers and has the Cesium user data,
-        // set the parameters on each material layer that maps to this overlay
-        // tile.
-        if (pCesiumData) {
-          FString name(
-              UTF8_TO_TCHAR(rasterTile.getOverlay().getName().c_str()));
-
-          for (int32 i = 0; i < pCesiumData->LayerNames.Num(); ++i) {
-            if (pCesiumData->LayerNames[i] != name) {
-              continue;
-            }
-
-            pMaterial->SetTextureParameterValueByInfo(
-                FMaterialParameterInfo(
-                    "Texture",
-                    EMaterialParameterAssociation::LayerParameter,
-                    i),
-                pTexture);
-            pMaterial->SetVectorParameterValueByInfo(
-                FMaterialParameterInfo(
-                    "TranslationScale",
-                    EMaterialParameterAssociation::LayerParameter,
-                    i),
-                translationAndScale);
-            pMaterial->SetScalarParameterValueByInfo(
-                FMaterialParameterInfo(
-                    "TextureCoordinateIndex",
-                    EMaterialParameterAssociation::LayerParameter,
-                    i),
-                static_cast<float>(
-                    pPrimitive->overlayTextureCoordinateIDToUVIndex
-                        [textureCoordinateID]));
-          }
-        } else {
-          pMaterial->SetTextureParameterValue(
-              createSafeName(rasterTile.getOverlay().getName(), "_Texture"),
-              pTexture);
-          pMaterial->SetVectorParameterValue(
-              createSafeName(
-                  rasterTile.getOverlay().getName(),
-                  "_TranslationScale"),
-              translationAndScale);
-          pMaterial->SetScalarParameterValue(
-              createSafeName(
-                  rasterTile.getOverlay().getName(),
-                  "_TextureCoordinateIndex"),
-              static_cast<float>(pPrimitive->overlayTextureCoordinateIDToUVIndex
-                                     [textureCoordinateID]));
-        }
+        attachRasterTileToMaterial(
+            pPrimitive,
+            pMaterial,
+            pCesiumData,
+            rasterTile,
+            pTexture,
+            translation,
+            scale,
+            textureCoordinateID);
       });
 }
 
+void UCesiumGltfComponent::AttachPendingRasterTiles(
+    UCesiumGltfPrimitiveComponent* pPrimitive) {
+  for (const PendingCreation::RasterTile& attached :
+       this->_pPendingCreation->rasterTiles) {
+    forPrimitiveComponent(
+        pPrimitive,
+        [&attached](
+            UCesiumGltfPrimitiveComponent* pMesh,
+            UMaterialInstanceDynamic* pMaterial,
+            UCesiumMaterialUserData* pCesiumData) {
+          attachRasterTileToMaterial(
+              pMesh,
+              pMaterial,
+              pCesiumData,
+              *attached.pRasterTile,
+              attached.pTexture,
+              attached.translation,
+              attached.scale,
+              attached.textureCoordinateID);
+        });
+  }
+}
+
 void UCesiumGltfComponent::DetachRasterTile(
     const Cesium3DTilesSelection::Tile& tile,
     const Cesium3DTilesSelection::RasterOverlayTile& rasterTile,
     UTexture2D* pTexture) {
+  if (this->_pPendingCreation) {
+    std::vector<PendingCreation::RasterTile>& rasterTiles =
+        this->_pPendingCreation->rasterTiles;
+    rasterTiles.erase(
+        std::remove_if(
+            rasterTiles.begin(),
+            rasterTiles.end(),
+            [&rasterTile](const PendingCreation::RasterTile& attached) {
+              return attached.pRasterTile == &rasterTile;
+            }),
+        rasterTiles.end());
+  }
 
   forEachPrimitiveComponent(
       this,
@@ -3059,6 +3439,7 @@ void UCesiumGltfComponent::DetachRasterTile(
 
 void UCesiumGltfComponent::SetCollisionEnabled(
     ECollisionEnabled::Type NewType) {
+  this->RenderState.collisionEnabled = NewType;
   for (USceneComponent* pSceneComponent : this->GetAttachChildren()) {
     UCesiumGltfPrimitiveComponent* pPrimitive =
         Cast<UCesiumGltfPrimitiveComponent>(pSceneComponent);
@@ -3069,6 +3450,8 @@ void UCesiumGltfComponent::SetCollisionEnabled(
 }
 
 void UCesiumGltfComponent::BeginDestroy() {
+  this->_pPendingCreation.Reset();
+
   CesiumEncodedFeaturesMetadata::destroyEncodedModelMetadata(
       this->EncodedMetadata);
 
@@ -3090,6 +3473,15 @@ void UCesiumGltfComponent::UpdateFade(float fadePercentage, bool fadingIn) {
 
   fadePercentage = glm::clamp(fadePercentage, 0.0f, 1.0f);
 
+  // The material parameters keep their values, so there is nothing to do if
+  // the fade has not changed. Most tiles are not transitioning at all.
+  if (fadePercentage == this->RenderState.fadePercentage &&
+      fadingIn == this->RenderState.fadingIn) {
+    return;
+  }
+  this->RenderState.fadePercentage = fadePercentage;
+  this->RenderState.fadingIn = fadingIn;
+
   UCesiumMaterialUserData* pCesiumData =
       BaseMaterial->GetAssetUserData<UCesiumMaterialUserData>();
 
@@ -3129,61 +3521,3 @@ void UCesiumGltfComponent::UpdateFade(float fadePercentage, bool fadingIn) {
         fadingIn ? 0.0f : 1.0f);
   }
 }
-
-static bool isTriangleDegenerate(
-    const Chaos::FTriangleMeshImplicitObject::ParticleVecType& A,
-    const Chaos::FTriangleMeshImplicitObject::ParticleVecType& B,
-    const Chaos::FTriangleMeshImplicitObject::ParticleVecType& C) {
-  Chaos::FTriangleMeshImplicitObject::ParticleVecType AB = B - A;
-  Chaos::FTriangleMeshImplicitObject::ParticleVecType AC = C - A;
-  Chaos::FTriangleMeshImplicitObject::ParticleVecType Normal =
-      Chaos::FTriangleMeshImplicitObject::ParticleVecType::CrossProduct(AB, AC);
-  return (Normal.SafeNormalize() < 1.e-8f);
-}
-
-template <typename TIndex>
-static TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>
-BuildChaosTriangleMeshes(
-    const TArray<FStaticMeshBuildVertex>& vertexData,
-    const TArray<uint32>& indices) {
-
-  int32 vertexCount = vertexData.Num();
-  Chaos::TParticles<Chaos::FRealSingle, 3> vertices;
-  vertices.AddParticles(vertexCount);
-  for (int32 i = 0; i < vertexCount; ++i) {
-    vertices.X(i) = vertexData[i].Position;
-  }
-
-  int32 triangleCount = indices.Num() / 3;
-  TArray<Chaos::TVector<TIndex, 3>> triangles;
-  triangles.Reserve(triangleCount);
-  TArray<int32> faceRemap;
-  faceRemap.Reserve(triangleCount);
-
-  for (int32 i = 0; i < triangleCount; ++i) {
-    const int32 index0 = 3 * i;
-    int32 vIndex0 = indices[index0 + 1];
-    int32 vIndex1 = indices[index0];
-    int32 vIndex2 = indices[index0 + 2];
-
-    if (!isTriangleDegenerate(
-            vertices.X(vIndex0),
-            vertices.X(vIndex1),
-            vertices.X(vIndex2))) {
-      triangles.Add(Chaos::TVector<int32, 3>(vIndex0, vIndex1, vIndex2));
-      faceRemap.Add(i);
-    }
-  }
-
-  TUniquePtr<TArray<int32>> pFaceRemap = MakeUnique<TArray<int32>>(faceRemap);
-  TArray<uint16> materials;
-  materials.SetNum(triangles.Num());
-
-  return MakeShared<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>(
-      MoveTemp(vertices),
-      MoveTemp(triangles),
-      MoveTemp(materials),
-      MoveTemp(pFaceRemap),
-      nullptr,
-      false);
-}
@@ -13,12 +13,16 @@
 #include "CustomDepthParameters.h"
 #include "Interfaces/IHttpRequest.h"
 #include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <limits>
 #include <memory>
+#include <vector>
 #include "CesiumGltfComponent.generated.h"
 
 class UMaterialInterface;
 class UTexture2D;
 class UStaticMeshComponent;
+class UCesiumGltfPrimitiveComponent;
 
 namespace CreateGltfOptions {
 struct CreateModelOptions;
@@ -75,7 +79,25 @@ public:
       UMaterialInterface* BaseWaterMaterial,
       FCustomDepthParameters CustomDepthParameters,
       const Cesium3DTilesSelection::Tile& tile,
-      bool createNavCollision);
+      bool createNavCollision,
+      bool deferPrimitives = false);
+
+  /**
+   * @brief Creates more of the primitives whose creation
+   * {@link CreateOnGameThread} deferred.
+   *
+   * At least one primitive is created. Creation then continues until
+   * `MaximumPrimitives` have been created, if it is greater than zero, or
+   * until `FPlatformTime::Seconds()` reaches `EndTimeSeconds`.
+   *
+   * @return The number of primitives that were created.
+   */
+  int32 ContinueCreation(int32 MaximumPrimitives, double EndTimeSeconds);
+
+  /**
+   * @brief Whether all primitives of this glTF have been created.
+   */
+  bool IsCreationComplete() const { return !this->_pPendingCreation; }
 
   UCesiumGltfComponent();
   virtual ~UCesiumGltfComponent();
@@ -115,6 +137,31 @@ public:
       const Cesium3DTilesSelection::RasterOverlayTile& RasterTile,
       UTexture2D* Texture);
 
+  /**
+   * @brief The state that the owning tileset last applied to this glTF, so
+   * that the tileset only updates the components when it changes.
+   * Visibility is tracked by the component itself.
+   */
+  struct TileRenderState {
+    /** @brief The collision last set with {@link SetCollisionEnabled}. */
+    ECollisionEnabled::Type collisionEnabled = ECollisionEnabled::NoCollision;
+    /**
+     * @brief The version of the tileset's actor collision settings that were
+     * last applied to the primitives, or 0 if none have been applied yet.
+     */
+    uint32 collisionSettingsVersion = 0;
+    /**
+     * @brief The fade last applied with {@link UpdateFade}. NaN when it is
+     * unknown, because a primitive got a new or pooled material since, so that
+     * the next fade is always applied.
+     */
+    float fadePercentage = std::numeric_limits<float>::quiet_NaN();
+    /** @brief Whether the last applied fade was fading in. */
+    bool fadingIn = true;
+  };
+
+  TileRenderState RenderState{};
+
   UFUNCTION(BlueprintCallable, Category = "Collision")
   virtual void SetCollisionEnabled(ECollisionEnabled::Type NewType);
 
@@ -122,7 +169,68 @@ public:
 
   void UpdateFade(float fadePercentage, bool fadingIn);
 
+  /**
+   * @brief Gets the combined world bounds of the visible primitives of this
+   * glTF, or nullptr if none of them is visible.
+   *
+   * The bounds are cached, and only recomputed after the transform or the
+   * visibility of this component has changed.
+   */
+  const FBoxSphereBounds* GetWorldBounds();
+
+protected:
+  virtual void OnUpdateTransform(
+      EUpdateTransformFlags UpdateTransformFlags,
+      ETeleportType Teleport = ETeleportType::None) override;
+
+  virtual void OnVisibilityChanged() override;
+
 private:
+  void UpdateWorldBounds();
+
   UPROPERTY()
   UTexture2D* Transparent1x1 = nullptr;
+
+  /**
+   * @brief The state of a creation that is spread over several calls to
+   * {@link ContinueCreation}.
+   */
+  struct PendingCreation {
+    TUniquePtr<HalfConstructed> pHalfConstructed;
+    const CesiumGltf::Model* pModel;
+    const Cesium3DTilesSelection::Tile* pTile;
+    ACesium3DTileset* pTilesetActor;
+    bool createNavCollision;
+    size_t nodeIndex = 0;
+    size_t primitiveIndex = 0;
+
+    /**
+     * @brief A raster overlay tile attached while the creation was pending.
+     */
+    struct RasterTile {
+      const Cesium3DTilesSelection::RasterOverlayTile* pRasterTile;
+      UTexture2D* pTexture;
+      glm::dvec2 translation;
+      glm::dvec2 scale;
+      int32 textureCoordinateID;
+    };
+
+    /**
+     * @brief The raster overlay tiles that are currently attached, to be
+     * attached to the primitives that are created later, too.
+     */
+    std::vector<RasterTile> rasterTiles;
+  };
+
+  /**
+   * @brief Attaches the raster overlay tiles recorded in the pending creation
+   * to a primitive that was just created.
+   */
+  void AttachPendingRasterTiles(UCesiumGltfPrimitiveComponent* pPrimitive);
+
+  TUniquePtr<PendingCreation> _pPendingCreation;
+
+  FBoxSphereBounds _worldBounds{ForceInit};
+  bool _hasWorldBounds = false;
+  bool _worldBoundsDirty = true;
 };
@@ -5,6 +5,7 @@
 #include "CesiumGltf/MeshPrimitive.h"
 #include "CesiumGltf/Model.h"
 #include "CesiumLifetime.h"
+#include "CesiumMaterialInstancePool.h"
 #include "CesiumMaterialUserData.h"
 #include "Engine/StaticMesh.h"
 #include "Engine/Texture.h"
@@ -68,6 +69,8 @@ void destroyMaterialTexture(
           FMaterialParameterInfo(name, assocation, index),
           pTexture,
           true)) {
+    // The texture may be shared with other primitives of the same model, which
+    // pass it here too. It is only destroyed once.
     CesiumTextureUtility::destroyTexture(pTexture);
   }
 }
@@ -145,7 +148,9 @@ void UCesiumGltfPrimitiveComponent::BeginDestroy() {
     }
     PRAGMA_ENABLE_DEPRECATION_WARNINGS
 
-    CesiumLifetime::destroy(pMaterial);
+    if (!CesiumMaterialInstancePool::release(pMaterial)) {
+      CesiumLifetime::destroy(pMaterial);
+    }
   }
 
   UStaticMesh* pMesh = this->GetStaticMesh();
@@ -7,6 +7,7 @@
 #include "CesiumEncodedFeaturesMetadata.h"
 #include "CesiumEncodedMetadataUtility.h"
 #include "CesiumMetadataPrimitive.h"
+#include "CesiumPhysicsMeshes.h"
 #include "CesiumPrimitiveFeatures.h"
 #include "CesiumRasterOverlays.h"
 #include "Components/StaticMeshComponent.h"
@@ -104,6 +105,13 @@ public:
 
   std::optional<Cesium3DTilesSelection::BoundingVolume> boundingVolume;
 
+  /**
+   * The triangles from which the physics mesh of this primitive is built on
+   * demand, or nullptr if the physics mesh was built while loading.
+   */
+  TSharedPtr<const CesiumPhysicsMeshes::TriangleSource, ESPMode::ThreadSafe>
+      pPhysicsMeshSource;
+
   /**
    * Updates this component's transform from a new double-precision
    * transformation from the Cesium world to the Unreal Engine world, as well as
@@ -2,6 +2,7 @@
 
 #include "CesiumLifetime.h"
 #include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
 #if WITH_EDITOR
 #include "Editor.h"
 #include "Editor/EditorEngine.h"
@@ -10,11 +11,32 @@
 #include "Engine/StaticMesh.h"
 #include "Engine/Texture2D.h"
 #include "PhysicsEngine/BodySetup.h"
+#include "ProfilingDebugging/CountersTrace.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "StaticMeshResources.h"
 #include "UObject/Object.h"
 #include <algorithm>
 
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Objects Pending Destruction"),
+    STAT_CesiumObjectsPendingDestruction,
+    STATGROUP_Cesium);
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Objects Destroyed"),
+    STAT_CesiumObjectsDestroyed,
+    STATGROUP_Cesium);
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Bytes Freed by Destruction"),
+    STAT_CesiumDestructionBytesFreed,
+    STATGROUP_Cesium);
+
+TRACE_DECLARE_INT_COUNTER(
+    CesiumObjectsPendingDestruction,
+    TEXT("Cesium/Objects Pending Destruction"));
+TRACE_DECLARE_MEMORY_COUNTER(
+    CesiumDestructionBytesFreed,
+    TEXT("Cesium/Bytes Freed by Destruction"));
+
 /*static*/
 AmortizedDestructor CesiumLifetime::amortizedDestructor = AmortizedDestructor();
 
@@ -72,16 +94,33 @@ bool AmortizedDestructor::IsTickableInEditor() const { return true; }
 TStatId AmortizedDestructor::GetStatId() const { return TStatId(); }
 
 void AmortizedDestructor::destroy(UObject* pObject) {
-  if (!runDestruction(pObject)) {
-    addToPending(pObject);
+  if (pObject && _pending.Contains(TWeakObjectPtr<UObject>(pObject))) {
+    return;
+  }
+
+  if (!beginDestruction(pObject)) {
+    return;
+  }
+
+  _pending.Add(TWeakObjectPtr<UObject>(pObject));
+  if (pObject->IsReadyForFinishDestroy()) {
+    _ready.emplace_back(pObject);
+  } else {
+    _waiting.Add(pObject);
   }
+
+  SET_DWORD_STAT(STAT_CesiumObjectsPendingDestruction, getPendingCount());
 }
 
-bool AmortizedDestructor::runDestruction(UObject* pObject) const {
+int32 AmortizedDestructor::getPendingCount() const {
+  return int32(_ready.size()) + _waiting.Num();
+}
+
+bool AmortizedDestructor::beginDestruction(UObject* pObject) const {
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::RunDestruction)
 
   if (!pObject) {
-    return true;
+    return false;
   }
 
 #if ENGINE_MAJOR_VERSION >= 5
@@ -94,44 +133,89 @@ bool AmortizedDestructor::runDestruction(UObject* pObject) const {
 
   if (pObject->HasAnyFlags(RF_FinishDestroyed)) {
     // Already done being destroyed.
-    return true;
+    return false;
   }
 
   if (!pObject->HasAnyFlags(RF_BeginDestroyed)) {
     pObject->ConditionalBeginDestroy();
   }
 
-  if (!pObject->HasAnyFlags(RF_FinishDestroyed) &&
-      pObject->IsReadyForFinishDestroy()) {
-    // Don't actually call ConditionalFinishDestroy here, because if we do the
-    // UE garbage collector will freak out that it's already been called. The
-    // IsReadyForFinishDestroy call is important, though. In some objects,
-    // calling that actually continues the async destruction!
-    finalizeDestroy(pObject);
-    return true;
-  }
-
-  return false;
-}
-
-void AmortizedDestructor::addToPending(UObject* pObject) {
-  _pending.Add(pObject);
+  return !pObject->HasAnyFlags(RF_FinishDestroyed);
 }
 
 void AmortizedDestructor::processPending() {
-  std::swap(_nextPending, _pending);
-  _pending.Empty();
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ProcessPendingDestruction)
+
+  const UCesiumRuntimeSettings* pSettings =
+      GetDefault<UCesiumRuntimeSettings>();
+  const double endTime =
+      FPlatformTime::Seconds() +
+      double(pSettings->DestructionTimeBudgetMilliseconds) / 1000.0;
+  const int32 maximumCount = pSettings->MaximumObjectsDestroyedPerFrame;
+
+  int32 destroyedCount = 0;
+  int64 bytesFreed = 0;
+
+  // At least one object is finalized per frame, so that destruction always
+  // makes progress.
+  auto isWithinBudget = [&]() {
+    return destroyedCount == 0 ||
+           ((maximumCount <= 0 || destroyedCount < maximumCount) &&
+            FPlatformTime::Seconds() < endTime);
+  };
+
+  auto finalize = [&](UObject* pObject) {
+    bytesFreed += this->finalizeDestroy(pObject);
+    ++destroyedCount;
+  };
+
+  while (!_ready.empty() && isWithinBudget()) {
+    TWeakObjectPtr<UObject> pWeakObject = _ready.front();
+    _ready.pop_front();
+    _pending.Remove(pWeakObject);
+    UObject* pObject = pWeakObject.Get(true);
+    if (pObject && !pObject->HasAnyFlags(RF_FinishDestroyed)) {
+      finalize(pObject);
+    }
+  }
 
-  for (TWeakObjectPtr<UObject> pObject : _nextPending) {
-    destroy(pObject.Get(true));
+  // Polling IsReadyForFinishDestroy is what continues the asynchronous
+  // destruction of some objects, so all waiting objects are polled even when
+  // the budget is used up. The ones that become ready are finalized later.
+  int32 stillWaiting = 0;
+  for (int32 i = 0; i < _waiting.Num(); ++i) {
+    UObject* pObject = _waiting[i].Get(true);
+    if (!pObject || pObject->HasAnyFlags(RF_FinishDestroyed)) {
+      _pending.Remove(_waiting[i]);
+      continue;
+    }
+
+    if (!pObject->IsReadyForFinishDestroy()) {
+      _waiting[stillWaiting++] = _waiting[i];
+    } else if (_ready.empty() && isWithinBudget()) {
+      _pending.Remove(_waiting[i]);
+      finalize(pObject);
+    } else {
+      _ready.emplace_back(pObject);
+    }
   }
+  _waiting.SetNum(stillWaiting, false);
+
+  const int32 pendingCount = getPendingCount();
+  SET_DWORD_STAT(STAT_CesiumObjectsPendingDestruction, pendingCount);
+  INC_DWORD_STAT_BY(STAT_CesiumObjectsDestroyed, destroyedCount);
+  INC_DWORD_STAT_BY(STAT_CesiumDestructionBytesFreed, uint32(bytesFreed));
+  TRACE_COUNTER_SET(CesiumObjectsPendingDestruction, pendingCount);
+  TRACE_COUNTER_SET(CesiumDestructionBytesFreed, bytesFreed);
 }
 
-void AmortizedDestructor::finalizeDestroy(UObject* pObject) const {
+int64 AmortizedDestructor::finalizeDestroy(UObject* pObject) const {
   // The freeing/clearing/destroying done here is normally done in these
   // objects' FinishDestroy method, but unfortunately we can't call that
   // directly without confusing the garbage collector if and when it _does_
   // run. So instead we manually release some critical resources here.
+  const int64 resourceSize =
+      pObject->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
 
   UTexture2D* pTexture2D = Cast<UTexture2D>(pObject);
   if (pTexture2D) {
@@ -163,4 +247,6 @@ void AmortizedDestructor::finalizeDestroy(UObject* pObject) const {
     pBodySetup->FaceRemap.Empty();
     pBodySetup->ClearPhysicsMeshes();
   }
+
+  return resourceSize;
 }
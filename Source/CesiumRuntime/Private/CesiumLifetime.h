@@ -3,12 +3,25 @@
 #pragma once
 #include "Components/SceneComponent.h"
 #include "Containers/Array.h"
+#include "Containers/Set.h"
 #include "Tickable.h"
 #include "UObject/WeakObjectPtrTemplates.h"
+#include <deque>
 
 class UObject;
 class UTexture;
 
+/**
+ * @brief Releases the resources of destroyed objects over several frames.
+ *
+ * Objects begin to be destroyed as soon as they are passed to
+ * {@link destroy}. Releasing their resources is deferred to the tick, which
+ * stays within the `DestructionTimeBudgetMilliseconds` and
+ * `MaximumObjectsDestroyedPerFrame` runtime settings. Objects that are ready to
+ * be released are handled before those whose asynchronous destruction is
+ * still in progress. An object that is passed more than once, such as a
+ * texture shared by several primitives, is only destroyed once.
+ */
 class AmortizedDestructor : FTickableGameObject {
 public:
   void Tick(float DeltaTime) override;
@@ -18,14 +31,23 @@ public:
   TStatId GetStatId() const;
   void destroy(UObject* pObject);
 
+  /**
+   * @brief Gets the number of objects whose resources have not been released
+   * yet.
+   */
+  int32 getPendingCount() const;
+
 private:
-  bool runDestruction(UObject* pObject) const;
-  void addToPending(UObject* pObject);
+  bool beginDestruction(UObject* pObject) const;
   void processPending();
-  void finalizeDestroy(UObject* pObject) const;
+  int64 finalizeDestroy(UObject* pObject) const;
 
-  TArray<TWeakObjectPtr<UObject>> _pending;
-  TArray<TWeakObjectPtr<UObject>> _nextPending;
+  // Objects that are ready to be finalized, in the order they became ready.
+  std::deque<TWeakObjectPtr<UObject>> _ready;
+  // Objects that are still waiting on IsReadyForFinishDestroy.
+  TArray<TWeakObjectPtr<UObject>> _waiting;
+  // Every object in _ready or _waiting.
+  TSet<TWeakObjectPtr<UObject>> _pending;
 };
 
 class CesiumLifetime {
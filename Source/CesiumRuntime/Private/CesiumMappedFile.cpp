@@ -0,0 +1,36 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumMappedFile.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+
+/*static*/ std::shared_ptr<CesiumMappedFile>
+CesiumMappedFile::open(const FString& filename) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::MapFile)
+
+  IPlatformFile& platformFile = FPlatformFileManager::Get().GetPlatformFile();
+  TUniquePtr<IMappedFileHandle> pHandle(platformFile.OpenMapped(*filename));
+  if (!pHandle || pHandle->GetFileSize() <= 0) {
+    return nullptr;
+  }
+
+  TUniquePtr<IMappedFileRegion> pRegion(
+      pHandle->MapRegion(0, pHandle->GetFileSize()));
+  if (!pRegion || !pRegion->GetMappedPtr()) {
+    return nullptr;
+  }
+
+  return std::shared_ptr<CesiumMappedFile>(
+      new CesiumMappedFile(std::move(pHandle), std::move(pRegion)));
+}
+
+CesiumMappedFile::CesiumMappedFile(
+    TUniquePtr<IMappedFileHandle>&& pHandle,
+    TUniquePtr<IMappedFileRegion>&& pRegion) noexcept
+    : _pHandle(std::move(pHandle)),
+      _pRegion(std::move(pRegion)),
+      _span(
+          reinterpret_cast<const std::byte*>(this->_pRegion->GetMappedPtr()),
+          size_t(this->_pRegion->GetMappedSize())) {}
+
+CesiumMappedFile::~CesiumMappedFile() noexcept = default;
@@ -0,0 +1,51 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/UnrealString.h"
+#include "Templates/UniquePtr.h"
+#include <cstddef>
+#include <gsl/span>
+#include <memory>
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * @brief A read-only memory mapping of an entire file.
+ *
+ * The mapping is shared by every {@link CesiumResponseBuffer} that views
+ * it, and is released when the last of them is destroyed.
+ */
+class CesiumMappedFile {
+public:
+  /**
+   * @brief Maps the given file into memory.
+   *
+   * @return The mapping, or `nullptr` if the file does not exist, is empty,
+   * or cannot be mapped on this platform. Callers should fall back to reading
+   * the file in that case.
+   */
+  static std::shared_ptr<CesiumMappedFile> open(const FString& filename);
+
+  ~CesiumMappedFile() noexcept;
+
+  CesiumMappedFile(const CesiumMappedFile&) = delete;
+  CesiumMappedFile& operator=(const CesiumMappedFile&) = delete;
+
+  /**
+   * @brief Gets a view of the entire mapped file.
+   */
+  gsl::span<const std::byte> span() const noexcept { return this->_span; }
+
+private:
+  CesiumMappedFile(
+      TUniquePtr<IMappedFileHandle>&& pHandle,
+      TUniquePtr<IMappedFileRegion>&& pRegion) noexcept;
+
+  // The region must be released before the handle, so it is declared after
+  // it.
+  TUniquePtr<IMappedFileHandle> _pHandle;
+  TUniquePtr<IMappedFileRegion> _pRegion;
+  gsl::span<const std::byte> _span;
+};
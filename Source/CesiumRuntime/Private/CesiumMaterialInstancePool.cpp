@@ -0,0 +1,93 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumMaterialInstancePool.h"
+#include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "UObject/UObjectGlobals.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Material Instance Pool Hits"),
+    STAT_CesiumMaterialInstancePoolHits,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Material Instance Pool Misses"),
+    STAT_CesiumMaterialInstancePoolMisses,
+    STATGROUP_Cesium);
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Pooled Material Instances"),
+    STAT_CesiumPooledMaterialInstances,
+    STATGROUP_Cesium);
+
+/*static*/
+TMap<UMaterialInterface*, TArray<UMaterialInstanceDynamic*>>
+    CesiumMaterialInstancePool::_pool;
+
+/*static*/
+int32 CesiumMaterialInstancePool::_pooledCount = 0;
+
+/*static*/ UMaterialInstanceDynamic* CesiumMaterialInstancePool::acquire(
+    UMaterialInterface* pBaseMaterial,
+    FName name) {
+  TArray<UMaterialInstanceDynamic*>* pInstances = _pool.Find(pBaseMaterial);
+  if (pInstances && pInstances->Num() > 0) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ReuseMaterialInstance)
+    UMaterialInstanceDynamic* pMaterial = pInstances->Pop(false);
+    --_pooledCount;
+    SET_DWORD_STAT(STAT_CesiumPooledMaterialInstances, _pooledCount);
+    INC_DWORD_STAT(STAT_CesiumMaterialInstancePoolHits);
+
+    pMaterial->RemoveFromRoot();
+    return pMaterial;
+  }
+
+  INC_DWORD_STAT(STAT_CesiumMaterialInstancePoolMisses);
+  return UMaterialInstanceDynamic::Create(pBaseMaterial, nullptr, name);
+}
+
+/*static*/ bool
+CesiumMaterialInstancePool::release(UMaterialInstanceDynamic* pMaterial) {
+  // An instance that the garbage collector has already found unreachable is
+  // destroyed along with its primitive and must not be resurrected.
+  if (!IsValid(pMaterial) || !pMaterial->Parent || IsGarbageCollecting() ||
+      pMaterial->IsUnreachable() ||
+      pMaterial->HasAnyFlags(RF_BeginDestroyed)) {
+    return false;
+  }
+
+  const UCesiumRuntimeSettings* pSettings =
+      GetDefault<UCesiumRuntimeSettings>();
+  if (_pooledCount >= pSettings->MaximumPooledMaterialInstances) {
+    return false;
+  }
+
+  TArray<UMaterialInstanceDynamic*>& instances =
+      _pool.FindOrAdd(pMaterial->Parent);
+  if (instances.Num() >=
+      pSettings->MaximumPooledMaterialInstancesPerMaterial) {
+    return false;
+  }
+
+  // The textures set as parameters are being destroyed along with the
+  // primitive, so they must not stay reachable from the rooted instance.
+  pMaterial->ClearParameterValues();
+  pMaterial->AddToRoot();
+  instances.Add(pMaterial);
+  ++_pooledCount;
+  SET_DWORD_STAT(STAT_CesiumPooledMaterialInstances, _pooledCount);
+  return true;
+}
+
+/*static*/ void CesiumMaterialInstancePool::clear() {
+  if (UObjectInitialized()) {
+    for (auto& entry : _pool) {
+      for (UMaterialInstanceDynamic* pMaterial : entry.Value) {
+        pMaterial->RemoveFromRoot();
+      }
+    }
+  }
+
+  _pool.Empty();
+  _pooledCount = 0;
+  SET_DWORD_STAT(STAT_CesiumPooledMaterialInstances, 0);
+}
@@ -0,0 +1,61 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "UObject/NameTypes.h"
+
+class UMaterialInstanceDynamic;
+class UMaterialInterface;
+
+/**
+ * @brief Recycles the dynamic material instances of unloaded tiles.
+ *
+ * Every glTF primitive gets its own material instance of one of a few base
+ * materials. Rather than destroying the instance when the primitive is
+ * destroyed, it is cleared and kept for the next primitive that uses the same
+ * base material. Pooled instances are added to the root set so that they
+ * survive garbage collection. Their parameter values are cleared when they are
+ * pooled, so they only keep their base material alive, which does not belong
+ * to any world. The pool is nevertheless emptied whenever a world is cleaned
+ * up, such as at the end of a Play In Editor session, so that instances of an
+ * unloaded level are not kept for one that may never need them.
+ *
+ * The pool is limited by the `MaximumPooledMaterialInstances` and
+ * `MaximumPooledMaterialInstancesPerMaterial` runtime settings.
+ */
+class CesiumMaterialInstancePool {
+public:
+  /**
+   * @brief Gets a material instance of the given base material without any
+   * parameter values, either from the pool or by creating a new one.
+   *
+   * @param pBaseMaterial The base material of the instance.
+   * @param name The name of the instance, if it is newly created.
+   */
+  static UMaterialInstanceDynamic*
+  acquire(UMaterialInterface* pBaseMaterial, FName name);
+
+  /**
+   * @brief Returns a material instance to the pool.
+   *
+   * The parameter values of the instance are cleared when it is pooled, so
+   * that it does not keep the textures set as parameters alive.
+   *
+   * @return True if the instance was pooled, or false if it was not, because
+   * the pool is full or the instance is being garbage collected. In that case
+   * the caller is still responsible for destroying it.
+   */
+  static bool release(UMaterialInstanceDynamic* pMaterial);
+
+  /**
+   * @brief Removes all instances from the pool and lets them be garbage
+   * collected.
+   */
+  static void clear();
+
+private:
+  static TMap<UMaterialInterface*, TArray<UMaterialInstanceDynamic*>> _pool;
+  static int32 _pooledCount;
+};
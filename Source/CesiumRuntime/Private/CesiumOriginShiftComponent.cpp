@@ -3,9 +3,7 @@
 #include "CesiumOriginShiftComponent.h"
 #include "CesiumGeoreference.h"
 #include "CesiumGlobeAnchorComponent.h"
-#include "CesiumSubLevelComponent.h"
 #include "CesiumSubLevelSwitcherComponent.h"
-#include "CesiumWgs84Ellipsoid.h"
 #include "LevelInstance/LevelInstanceActor.h"
 
 #if WITH_EDITOR
@@ -93,36 +91,9 @@ void UCesiumOriginShiftComponent::TickComponent(
 
   FVector ActorEcef = GlobeAnchor->GetEarthCenteredEarthFixedPosition();
 
-  ALevelInstance* ClosestActiveLevel = nullptr;
-  double ClosestLevelDistance = std::numeric_limits<double>::max();
-
-  for (int32 i = 0; i < Sublevels.Num(); ++i) {
-    ALevelInstance* Current = Sublevels[i].Get();
-    if (!IsValid(Current))
-      continue;
-
-    UCesiumSubLevelComponent* SubLevelComponent =
-        Current->FindComponentByClass<UCesiumSubLevelComponent>();
-    if (!IsValid(SubLevelComponent))
-      continue;
-
-    if (!SubLevelComponent->GetEnabled())
-      continue;
-
-    FVector LevelEcef =
-        UCesiumWgs84Ellipsoid::LongitudeLatitudeHeightToEarthCenteredEarthFixed(
-            FVector(
-                SubLevelComponent->GetOriginLongitude(),
-                SubLevelComponent->GetOriginLatitude(),
-                SubLevelComponent->GetOriginHeight()));
-
-    double LevelDistance = FVector::Distance(LevelEcef, ActorEcef);
-    if (LevelDistance < SubLevelComponent->GetLoadRadius() &&
-        LevelDistance < ClosestLevelDistance) {
-      ClosestActiveLevel = Current;
-      ClosestLevelDistance = LevelDistance;
-    }
-  }
+  // The switcher indexes its sub-levels, so this is cheap even with many
+  // sub-levels and many origin shift components.
+  ALevelInstance* ClosestActiveLevel = Switcher->FindClosestSubLevel(ActorEcef);
 
   Switcher->SetTargetSubLevel(ClosestActiveLevel);
 
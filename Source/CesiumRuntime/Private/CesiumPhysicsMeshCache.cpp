@@ -0,0 +1,198 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumPhysicsMeshCache.h"
+#include "CesiumCollisionInterestComponent.h"
+#include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumPhysicsMeshes.h"
+#include "CesiumRuntime.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "UnrealTaskProcessor.h"
+
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Physics Meshes Built On Demand"),
+    STAT_CesiumPhysicsMeshesBuiltOnDemand,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Cached Physics Meshes"),
+    STAT_CesiumCachedPhysicsMeshes,
+    STATGROUP_Cesium);
+
+void FCesiumPhysicsMeshCache::update(
+    const UWorld* pWorld,
+    const TArray<UCesiumGltfPrimitiveComponent*>& primitives,
+    int32 maximumBuildsPerFrame,
+    int32 maximumCachedMeshes) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdatePhysicsMeshCache)
+
+  ++this->_frame;
+
+  // Forget the primitives of unloaded tiles.
+  for (auto it = this->_meshes.CreateIterator(); it; ++it) {
+    if (!it->Key.IsValid()) {
+      if (!it->Value.building) {
+        --this->_builtMeshes;
+        DEC_DWORD_STAT(STAT_CesiumCachedPhysicsMeshes);
+      }
+      it.RemoveCurrent();
+    }
+  }
+
+  UCesiumCollisionInterestComponent::GetInterestComponents(
+      pWorld,
+      this->_interestComponents);
+
+  this->_wanted.Reset();
+  if (!this->_interestComponents.IsEmpty()) {
+    for (UCesiumGltfPrimitiveComponent* pPrimitive : primitives) {
+      if (!pPrimitive->pPhysicsMeshSource) {
+        continue;
+      }
+
+      const FBoxSphereBounds& bounds = pPrimitive->Bounds;
+      double closest = TNumericLimits<double>::Max();
+      for (const UCesiumCollisionInterestComponent* pInterest :
+           this->_interestComponents) {
+        if (pInterest->Intersects(bounds.Origin, bounds.SphereRadius)) {
+          closest = FMath::Min(
+              closest,
+              FVector::DistSquared(
+                  pInterest->GetComponentLocation(),
+                  bounds.Origin));
+        }
+      }
+
+      if (closest == TNumericLimits<double>::Max()) {
+        continue;
+      }
+
+      CachedMesh* pCached = this->_meshes.Find(pPrimitive);
+      if (pCached) {
+        pCached->lastNeededFrame = this->_frame;
+      } else {
+        this->_wanted.Emplace(closest, pPrimitive);
+      }
+    }
+  }
+
+  // Build the closest meshes first.
+  this->_wanted.Sort(
+      [](const auto& a, const auto& b) { return a.Key < b.Key; });
+  const int32 buildCount =
+      maximumBuildsPerFrame > 0
+          ? FMath::Min(maximumBuildsPerFrame, this->_wanted.Num())
+          : this->_wanted.Num();
+
+  for (int32 i = 0; i < buildCount; ++i) {
+    UCesiumGltfPrimitiveComponent* pPrimitive = this->_wanted[i].Value;
+    CachedMesh& cached = this->_meshes.Add(pPrimitive);
+    cached.lastNeededFrame = this->_frame;
+    cached.building = true;
+
+    TSharedPtr<const CesiumPhysicsMeshes::TriangleSource, ESPMode::ThreadSafe>
+        pSource = pPrimitive->pPhysicsMeshSource;
+
+    // Collision is not needed to draw the current frame, so it is built behind
+    // the tile loads of the view.
+    UnrealTaskProcessor::ScopedLane taskLane(UnrealTaskProcessor::Lane::Normal);
+    getAsyncSystem()
+        .runInWorkerThread([pSource = MoveTemp(pSource)]() {
+          return CesiumPhysicsMeshes::buildTriangleMeshes(*pSource);
+        })
+        .thenInMainThread(
+            [pThis = TWeakPtr<FCesiumPhysicsMeshCache, ESPMode::ThreadSafe>(
+                 this->AsShared()),
+             pPrimitive = TWeakObjectPtr<UCesiumGltfPrimitiveComponent>(
+                 pPrimitive),
+             generation = this->_generation](
+                TArray<CesiumPhysicsMeshes::TriangleMeshPtr>&& meshes) {
+              TSharedPtr<FCesiumPhysicsMeshCache, ESPMode::ThreadSafe> pCache =
+                  pThis.Pin();
+              if (!pCache || pCache->_generation != generation) {
+                return;
+              }
+
+              CachedMesh* pCached = pCache->_meshes.Find(pPrimitive);
+              if (!pCached || !pCached->building || !pPrimitive.IsValid()) {
+                return;
+              }
+
+              pCached->building = false;
+              ++pCache->_builtMeshes;
+              INC_DWORD_STAT(STAT_CesiumPhysicsMeshesBuiltOnDemand);
+              INC_DWORD_STAT(STAT_CesiumCachedPhysicsMeshes);
+              pCache->_setPhysicsMeshes(pPrimitive.Get(), MoveTemp(meshes));
+            });
+  }
+
+  this->_evict(maximumCachedMeshes);
+}
+
+int32 FCesiumPhysicsMeshCache::getBuildingMeshCount() const {
+  int32 building = 0;
+  for (const auto& pair : this->_meshes) {
+    if (pair.Value.building) {
+      ++building;
+    }
+  }
+  return building;
+}
+
+bool FCesiumPhysicsMeshCache::isCached(
+    const UCesiumGltfPrimitiveComponent* pPrimitive,
+    bool* pBuilding) const {
+  const CachedMesh* pCached =
+      this->_meshes.Find(TWeakObjectPtr<UCesiumGltfPrimitiveComponent>(
+          const_cast<UCesiumGltfPrimitiveComponent*>(pPrimitive)));
+  if (pBuilding) {
+    *pBuilding = pCached && pCached->building;
+  }
+  return pCached != nullptr;
+}
+
+void FCesiumPhysicsMeshCache::reset() {
+  DEC_DWORD_STAT_BY(STAT_CesiumCachedPhysicsMeshes, this->_builtMeshes);
+  this->_meshes.Reset();
+  this->_builtMeshes = 0;
+  ++this->_generation;
+}
+
+void FCesiumPhysicsMeshCache::_setPhysicsMeshes(
+    UCesiumGltfPrimitiveComponent* pPrimitive,
+    TArray<CesiumPhysicsMeshes::TriangleMeshPtr>&& meshes) {
+  UBodySetup* pBodySetup = pPrimitive->GetBodySetup();
+  if (!pBodySetup) {
+    return;
+  }
+
+  // The physics state refers to the current meshes, so it is destroyed
+  // before they are released.
+  pPrimitive->DestroyPhysicsState();
+  pBodySetup->ChaosTriMeshes = MoveTemp(meshes);
+  pPrimitive->RecreatePhysicsState();
+}
+
+void FCesiumPhysicsMeshCache::_evict(int32 maximumCachedMeshes) {
+  if (maximumCachedMeshes <= 0 || this->_builtMeshes <= maximumCachedMeshes) {
+    return;
+  }
+
+  TArray<TPair<uint64, UCesiumGltfPrimitiveComponent*>> candidates;
+  for (const auto& pair : this->_meshes) {
+    if (!pair.Value.building && pair.Value.lastNeededFrame < this->_frame) {
+      candidates.Emplace(pair.Value.lastNeededFrame, pair.Key.Get());
+    }
+  }
+
+  // Evict the meshes that have not been needed for the longest time.
+  candidates.Sort([](const auto& a, const auto& b) { return a.Key < b.Key; });
+  for (const auto& candidate : candidates) {
+    if (this->_builtMeshes <= maximumCachedMeshes) {
+      break;
+    }
+
+    this->_meshes.Remove(candidate.Value);
+    this->_setPhysicsMeshes(candidate.Value, {});
+    --this->_builtMeshes;
+    DEC_DWORD_STAT(STAT_CesiumCachedPhysicsMeshes);
+  }
+}
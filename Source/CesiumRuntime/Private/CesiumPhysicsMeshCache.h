@@ -0,0 +1,91 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumPhysicsMeshes.h"
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Templates/SharedPointer.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UCesiumCollisionInterestComponent;
+class UCesiumGltfPrimitiveComponent;
+class UWorld;
+
+/**
+ * @brief Builds the physics meshes of a tileset's primitives only when they
+ * are near a {@link UCesiumCollisionInterestComponent}, and keeps a limited
+ * number of them around for when they are needed again.
+ *
+ * Only primitives created with a physics mesh source, and no physics mesh,
+ * are managed. The meshes are built in worker threads, a limited number at a
+ * time, and the closest primitives are built first.
+ */
+class FCesiumPhysicsMeshCache
+    : public TSharedFromThis<FCesiumPhysicsMeshCache, ESPMode::ThreadSafe> {
+public:
+  /**
+   * @brief Starts building the physics meshes of the primitives that are near
+   * an interest volume, and evicts the ones that have not been needed for the
+   * longest time. Called on the game thread once per frame.
+   *
+   * @param pWorld The world whose interest volumes are used.
+   * @param primitives The primitives that are shown this frame.
+   * @param maximumBuildsPerFrame The maximum number of meshes to start
+   * building this frame, or 0 for no limit.
+   * @param maximumCachedMeshes The maximum number of meshes to keep, or 0 for
+   * no limit. Meshes needed in this frame are never evicted.
+   */
+  void update(
+      const UWorld* pWorld,
+      const TArray<UCesiumGltfPrimitiveComponent*>& primitives,
+      int32 maximumBuildsPerFrame,
+      int32 maximumCachedMeshes);
+
+  /**
+   * @brief Forgets all cached meshes and ignores the meshes that are still
+   * being built.
+   */
+  void reset();
+
+  /**
+   * @brief Gets the number of meshes that have been built and are kept.
+   */
+  int32 getCachedMeshCount() const { return this->_builtMeshes; }
+
+  /**
+   * @brief Gets the number of meshes that are being built.
+   */
+  int32 getBuildingMeshCount() const;
+
+  /**
+   * @brief Whether the mesh of the given primitive is kept or being built.
+   *
+   * @param pPrimitive The primitive.
+   * @param pBuilding If not nullptr, set to whether the mesh is still being
+   * built.
+   */
+  bool isCached(
+      const UCesiumGltfPrimitiveComponent* pPrimitive,
+      bool* pBuilding = nullptr) const;
+
+private:
+  struct CachedMesh {
+    uint64 lastNeededFrame = 0;
+    bool building = false;
+  };
+
+  void _setPhysicsMeshes(
+      UCesiumGltfPrimitiveComponent* pPrimitive,
+      TArray<CesiumPhysicsMeshes::TriangleMeshPtr>&& meshes);
+  void _evict(int32 maximumCachedMeshes);
+
+  TMap<TWeakObjectPtr<UCesiumGltfPrimitiveComponent>, CachedMesh> _meshes;
+  uint64 _frame = 0;
+  uint32 _generation = 0;
+  int32 _builtMeshes = 0;
+
+  // Kept between frames to avoid reallocating.
+  TArray<const UCesiumCollisionInterestComponent*> _interestComponents;
+  TArray<TPair<double, UCesiumGltfPrimitiveComponent*>> _wanted;
+};
@@ -0,0 +1,346 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumPhysicsMeshes.h"
+#include "CesiumRuntime.h"
+#include "Math/VectorRegister.h"
+#include "UnrealTaskProcessor.h"
+
+namespace CesiumPhysicsMeshes {
+
+namespace {
+
+using Vertices = Chaos::TParticles<Chaos::FRealSingle, 3>;
+
+// The number of triangles tested together in one vector register.
+constexpr int32 Lanes = 4;
+
+// Meshes with more triangles than this are split into chunks of this many
+// triangles, so that their bounding volume hierarchies are built in parallel.
+constexpr int32 TrianglesPerChunk = 32768;
+
+// Triangles with a smaller squared edge cross product are degenerate. Chaos'
+// SafeNormalize returns zero below this squared length, so the previous
+// cooker, which tested the normalized length against 1e-8, left out the same
+// triangles.
+constexpr float DegenerateCrossLengthSquared = 1.0e-4f;
+
+struct TriangleLanes {
+  VectorRegister4Float x;
+  VectorRegister4Float y;
+  VectorRegister4Float z;
+};
+
+// Gathers one corner of four consecutive triangles. Triangles past the end of
+// the indices repeat the last one, so that a partial group is computed the
+// same way as a full one.
+TriangleLanes gatherCorner(
+    const Vertices& vertices,
+    TArrayView<const uint32> indices,
+    int32 first,
+    int32 corner) {
+  const int32 last = indices.Num() / 3 - 1;
+  const FVector3f& a = vertices.X(indices[3 * first + corner]);
+  const FVector3f& b =
+      vertices.X(indices[3 * FMath::Min(first + 1, last) + corner]);
+  const FVector3f& c =
+      vertices.X(indices[3 * FMath::Min(first + 2, last) + corner]);
+  const FVector3f& d =
+      vertices.X(indices[3 * FMath::Min(first + 3, last) + corner]);
+  return TriangleLanes{
+      MakeVectorRegisterFloat(a.X, b.X, c.X, d.X),
+      MakeVectorRegisterFloat(a.Y, b.Y, c.Y, d.Y),
+      MakeVectorRegisterFloat(a.Z, b.Z, c.Z, d.Z)};
+}
+
+TriangleLanes subtract(const TriangleLanes& a, const TriangleLanes& b) {
+  return TriangleLanes{
+      VectorSubtract(a.x, b.x),
+      VectorSubtract(a.y, b.y),
+      VectorSubtract(a.z, b.z)};
+}
+
+/**
+ * @brief Finds the triangles that are not degenerate, four at a time. Bit `i`
+ * of `masks[j]` is set if triangle `Lanes * j + i` is kept.
+ *
+ * @return The number of triangles kept.
+ */
+int32 findNondegenerateTriangles(
+    const Vertices& vertices,
+    TArrayView<const uint32> indices,
+    TArray<uint8>& masks) {
+  const int32 triangleCount = indices.Num() / 3;
+  masks.SetNumUninitialized((triangleCount + Lanes - 1) / Lanes);
+
+  const VectorRegister4Float tolerance =
+      VectorSetFloat1(DegenerateCrossLengthSquared);
+  int32 keptCount = 0;
+
+  for (int32 i = 0; i < triangleCount; i += Lanes) {
+    const TriangleLanes a = gatherCorner(vertices, indices, i, 0);
+    const TriangleLanes ab = subtract(gatherCorner(vertices, indices, i, 1), a);
+    const TriangleLanes ac = subtract(gatherCorner(vertices, indices, i, 2), a);
+
+    const VectorRegister4Float crossX =
+        VectorNegateMultiplyAdd(ab.z, ac.y, VectorMultiply(ab.y, ac.z));
+    const VectorRegister4Float crossY =
+        VectorNegateMultiplyAdd(ab.x, ac.z, VectorMultiply(ab.z, ac.x));
+    const VectorRegister4Float crossZ =
+        VectorNegateMultiplyAdd(ab.y, ac.x, VectorMultiply(ab.x, ac.y));
+    const VectorRegister4Float lengthSquared = VectorMultiplyAdd(
+        crossZ,
+        crossZ,
+        VectorMultiplyAdd(crossY, crossY, VectorMultiply(crossX, crossX)));
+
+    // NaN positions fail the comparison, so their triangles are left out too.
+    const int32 laneCount = FMath::Min(Lanes, triangleCount - i);
+    const uint32 mask =
+        uint32(VectorMaskBits(VectorCompareGT(lengthSquared, tolerance))) &
+        ((1u << laneCount) - 1u);
+    masks[i / Lanes] = uint8(mask);
+    keptCount += int32(FMath::CountBits(mask));
+  }
+
+  return keptCount;
+}
+
+template <typename TIndex, typename TMapIndex>
+TriangleMeshPtr createMesh(
+    Vertices&& vertices,
+    TArrayView<const uint32> indices,
+    int32 firstTriangle,
+    const TArray<uint8>& masks,
+    int32 keptCount,
+    const TMapIndex& mapIndex) {
+  TArray<Chaos::TVector<TIndex, 3>> triangles;
+  triangles.SetNumUninitialized(keptCount);
+  TUniquePtr<TArray<int32>> pFaceRemap = MakeUnique<TArray<int32>>();
+  pFaceRemap->SetNumUninitialized(keptCount);
+  TArray<uint16> materials;
+  materials.SetNumZeroed(keptCount);
+
+  int32 next = 0;
+  const int32 triangleCount = indices.Num() / 3;
+  for (int32 i = 0; i < triangleCount; ++i) {
+    if ((masks[i / Lanes] & (1u << (i % Lanes))) == 0) {
+      continue;
+    }
+
+    // The first two corners are swapped to account for the Y axis being
+    // flipped between glTF and Unreal.
+    triangles[next] = Chaos::TVector<TIndex, 3>(
+        TIndex(mapIndex(indices[3 * i + 1])),
+        TIndex(mapIndex(indices[3 * i])),
+        TIndex(mapIndex(indices[3 * i + 2])));
+    (*pFaceRemap)[next] = firstTriangle + i;
+    ++next;
+  }
+  check(next == keptCount);
+
+  return MakeShared<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>(
+      MoveTemp(vertices),
+      MoveTemp(triangles),
+      MoveTemp(materials),
+      MoveTemp(pFaceRemap),
+      nullptr,
+      false);
+}
+
+template <typename TMapIndex>
+TriangleMeshPtr createMesh(
+    Vertices&& vertices,
+    TArrayView<const uint32> indices,
+    int32 firstTriangle,
+    const TArray<uint8>& masks,
+    int32 keptCount,
+    const TMapIndex& mapIndex) {
+  return vertices.Size() < TNumericLimits<uint16>::Max()
+             ? createMesh<uint16>(
+                   MoveTemp(vertices),
+                   indices,
+                   firstTriangle,
+                   masks,
+                   keptCount,
+                   mapIndex)
+             : createMesh<int32>(
+                   MoveTemp(vertices),
+                   indices,
+                   firstTriangle,
+                   masks,
+                   keptCount,
+                   mapIndex);
+}
+
+/**
+ * @brief Builds the mesh of one chunk of a large mesh. The chunk gets its own
+ * copy of the vertices its triangles use, which are usually close together
+ * in the shared vertices.
+ */
+TriangleMeshPtr buildChunk(
+    const Vertices& vertices,
+    TArrayView<const uint32> indices,
+    int32 firstTriangle) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ChaosCookChunk)
+
+  TArray<uint8> masks;
+  const int32 keptCount = findNondegenerateTriangles(vertices, indices, masks);
+  if (keptCount == 0) {
+    return nullptr;
+  }
+
+  uint32 minIndex = TNumericLimits<uint32>::Max();
+  uint32 maxIndex = 0;
+  for (const uint32 index : indices) {
+    minIndex = FMath::Min(minIndex, index);
+    maxIndex = FMath::Max(maxIndex, index);
+  }
+
+  TArray<int32> remap;
+  remap.Init(INDEX_NONE, int32(maxIndex - minIndex) + 1);
+  int32 vertexCount = 0;
+  const int32 triangleCount = indices.Num() / 3;
+  for (int32 i = 0; i < triangleCount; ++i) {
+    if ((masks[i / Lanes] & (1u << (i % Lanes))) == 0) {
+      continue;
+    }
+    for (int32 corner = 0; corner < 3; ++corner) {
+      int32& remapped = remap[indices[3 * i + corner] - minIndex];
+      if (remapped == INDEX_NONE) {
+        remapped = vertexCount++;
+      }
+    }
+  }
+
+  Vertices chunkVertices;
+  chunkVertices.AddParticles(vertexCount);
+  for (int32 i = 0; i < remap.Num(); ++i) {
+    if (remap[i] != INDEX_NONE) {
+      chunkVertices.X(remap[i]) = vertices.X(int32(minIndex) + i);
+    }
+  }
+
+  return createMesh(
+      MoveTemp(chunkVertices),
+      indices,
+      firstTriangle,
+      masks,
+      keptCount,
+      [&remap, minIndex](uint32 index) { return remap[index - minIndex]; });
+}
+
+} // namespace
+
+TArray<TriangleMeshPtr> buildTriangleMeshes(
+    Vertices&& vertices,
+    TArrayView<const uint32> indices) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ChaosCook)
+
+  TArray<TriangleMeshPtr> meshes;
+  const int32 triangleCount = indices.Num() / 3;
+  if (vertices.Size() == 0 || triangleCount == 0) {
+    return meshes;
+  }
+  indices = indices.Slice(0, 3 * triangleCount);
+
+  if (triangleCount <= TrianglesPerChunk) {
+    TArray<uint8> masks;
+    const int32 keptCount =
+        findNondegenerateTriangles(vertices, indices, masks);
+    if (keptCount > 0) {
+      meshes.Add(createMesh(
+          MoveTemp(vertices),
+          indices,
+          0,
+          masks,
+          keptCount,
+          [](uint32 index) { return index; }));
+    }
+    return meshes;
+  }
+
+  const int32 chunkCount =
+      (triangleCount + TrianglesPerChunk - 1) / TrianglesPerChunk;
+  meshes.SetNum(chunkCount);
+  getTaskProcessor()->parallelFor(
+      chunkCount,
+      [&vertices, indices, triangleCount, &meshes](int32 chunk) {
+        const int32 first = chunk * TrianglesPerChunk;
+        const int32 count =
+            FMath::Min(TrianglesPerChunk, triangleCount - first);
+        meshes[chunk] =
+            buildChunk(vertices, indices.Slice(3 * first, 3 * count), first);
+      });
+
+  meshes.RemoveAll([](const TriangleMeshPtr& pMesh) { return !pMesh; });
+  return meshes;
+}
+
+TArray<TriangleMeshPtr> buildTriangleMeshes(const TriangleSource& source) {
+  Vertices vertices;
+  vertices.AddParticles(source.positions.Num());
+  for (int32 i = 0; i < source.positions.Num(); ++i) {
+    vertices.X(i) = source.positions[i];
+  }
+  return buildTriangleMeshes(MoveTemp(vertices), source.indices);
+}
+
+bool lineTrace(
+    const TriangleSource& source,
+    const FVector& start,
+    const FVector& end,
+    LineTraceHit& hit) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LineTraceTriangleSource)
+
+  const FVector direction = end - start;
+  bool found = false;
+  hit.time = 1.0;
+
+  // Möller-Trumbore, testing both sides of each triangle.
+  const int32 triangleCount = source.indices.Num() / 3;
+  for (int32 i = 0; i < triangleCount; ++i) {
+    const FVector a(source.positions[source.indices[3 * i]]);
+    const FVector b(source.positions[source.indices[3 * i + 1]]);
+    const FVector c(source.positions[source.indices[3 * i + 2]]);
+
+    const FVector ab = b - a;
+    const FVector ac = c - a;
+    const FVector p = FVector::CrossProduct(direction, ac);
+    const double determinant = FVector::DotProduct(ab, p);
+    if (FMath::Abs(determinant) < UE_DOUBLE_SMALL_NUMBER) {
+      // The line is parallel to the triangle, or the triangle is degenerate.
+      continue;
+    }
+
+    const double inverseDeterminant = 1.0 / determinant;
+    const FVector fromA = start - a;
+    const double u = FVector::DotProduct(fromA, p) * inverseDeterminant;
+    if (u < 0.0 || u > 1.0) {
+      continue;
+    }
+
+    const FVector q = FVector::CrossProduct(fromA, ab);
+    const double v = FVector::DotProduct(direction, q) * inverseDeterminant;
+    if (v < 0.0 || u + v > 1.0) {
+      continue;
+    }
+
+    const double time = FVector::DotProduct(ac, q) * inverseDeterminant;
+    if (time < 0.0 || time > hit.time) {
+      continue;
+    }
+
+    FVector normal = FVector::CrossProduct(ab, ac).GetSafeNormal();
+    if (FVector::DotProduct(normal, direction) > 0.0) {
+      normal = -normal;
+    }
+
+    hit.time = time;
+    hit.faceIndex = i;
+    hit.normal = normal;
+    found = true;
+  }
+
+  return found;
+}
+
+} // namespace CesiumPhysicsMeshes
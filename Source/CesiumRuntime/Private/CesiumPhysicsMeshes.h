@@ -0,0 +1,100 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Chaos/TriangleMeshImplicitObject.h"
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Math/Vector.h"
+#include "Templates/SharedPointer.h"
+
+/**
+ * @brief Builds the Chaos triangle meshes used for collision with tile
+ * primitives, and traces against the triangles of primitives that do not have
+ * one.
+ */
+namespace CesiumPhysicsMeshes {
+
+/**
+ * @brief The triangles of a primitive from which a physics mesh can be built
+ * later, in the primitive's local space. They are the glTF positions and
+ * triangle indices, so vertices are shared between triangles even where the
+ * primitive's static mesh duplicates them.
+ */
+struct TriangleSource {
+  TArray<FVector3f> positions;
+  TArray<uint32> indices;
+
+  /**
+   * @brief Gets the approximate number of bytes held by this source.
+   */
+  SIZE_T GetAllocatedSize() const {
+    return positions.GetAllocatedSize() + indices.GetAllocatedSize();
+  }
+};
+
+/**
+ * @brief A Chaos triangle mesh used for collision with a tile primitive.
+ */
+using TriangleMeshPtr =
+    TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>;
+
+/**
+ * @brief Builds Chaos triangle meshes from the given vertices and triangle
+ * indices. Degenerate triangles are left out. The face remap of each mesh
+ * maps its triangles to the indices of the triangles in `indices`.
+ *
+ * Chaos builds the bounding volume hierarchy of a mesh on one thread, so
+ * large meshes are split into several meshes of consecutive triangles, which
+ * are built in parallel. Other meshes result in a single mesh that takes
+ * ownership of `vertices`.
+ *
+ * @return The meshes, or an empty array if there are no vertices or
+ * non-degenerate triangles.
+ */
+TArray<TriangleMeshPtr> buildTriangleMeshes(
+    Chaos::TParticles<Chaos::FRealSingle, 3>&& vertices,
+    TArrayView<const uint32> indices);
+
+/**
+ * @brief Builds Chaos triangle meshes from a {@link TriangleSource}.
+ */
+TArray<TriangleMeshPtr> buildTriangleMeshes(const TriangleSource& source);
+
+/**
+ * @brief The closest intersection found by {@link lineTrace}.
+ */
+struct LineTraceHit {
+  /**
+   * @brief The fraction of the way from the start to the end of the line.
+   */
+  double time;
+
+  /**
+   * @brief The index of the triangle in {@link TriangleSource::indices}.
+   */
+  int32 faceIndex;
+
+  /**
+   * @brief The unit normal of the triangle, facing the start of the line.
+   */
+  FVector normal;
+};
+
+/**
+ * @brief Finds the closest triangle of the source that the line from `start`
+ * to `end` intersects, by testing every triangle. Both points are in the
+ * local space of the source.
+ *
+ * This costs much less than building a triangle mesh and tracing against it,
+ * as long as only a few lines are traced.
+ *
+ * @return Whether the line intersects any triangle.
+ */
+bool lineTrace(
+    const TriangleSource& source,
+    const FVector& start,
+    const FVector& end,
+    LineTraceHit& hit);
+
+} // namespace CesiumPhysicsMeshes
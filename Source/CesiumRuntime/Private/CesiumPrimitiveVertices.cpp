@@ -0,0 +1,143 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumPrimitiveVertices.h"
+
+void CesiumPrimitiveVertices::initStaticMeshVertexBuffer(
+    uint32 texCoordSetCount) {
+  texCoordSetCount =
+      FMath::Clamp<uint32>(texCoordSetCount, 1, MAX_STATIC_TEXCOORDS);
+
+  FStaticMeshVertexBuffer& buffer = this->vertexBuffers.StaticMeshVertexBuffer;
+
+  // Set to full precision (32-bit) UVs. This is especially important for
+  // metadata because integer feature IDs can and will lose meaningful
+  // precision when using 16-bit floats.
+  buffer.SetUseFullPrecisionUVs(true);
+  buffer.Init(uint32(this->count), texCoordSetCount, false);
+
+  if (this->hasTangents()) {
+    for (int32 i = 0; i < this->count; ++i) {
+      buffer.SetVertexTangents(
+          uint32(i),
+          this->tangentX[i],
+          this->tangentY[i],
+          this->tangentZ[i]);
+    }
+  } else {
+    const FVector3f zero(0.0f);
+    for (int32 i = 0; i < this->count; ++i) {
+      buffer.SetVertexTangents(uint32(i), zero, zero, this->tangentZ[i]);
+    }
+  }
+
+  for (uint32 set = 0; set < texCoordSetCount; ++set) {
+    if (set < uint32(this->texCoordSets.Num())) {
+      const TArray<FVector2f>& texCoords = this->texCoordSets[set];
+      for (int32 i = 0; i < this->count; ++i) {
+        buffer.SetVertexUV(uint32(i), set, texCoords[i]);
+      }
+    } else {
+      for (int32 i = 0; i < this->count; ++i) {
+        buffer.SetVertexUV(uint32(i), set, FVector2f(0.0f, 0.0f));
+      }
+    }
+  }
+
+  this->tangentX.Empty();
+  this->tangentY.Empty();
+  this->tangentZ.Empty();
+  this->texCoordSets.Empty();
+}
+
+int32 CesiumPrimitiveVertices::weld(
+    TArray<uint32>& indices,
+    int32 sourceVertexCount) {
+  check(indices.Num() == this->count);
+
+  const bool hasTangents = this->hasTangents();
+  FColorVertexBuffer& colorBuffer = this->vertexBuffers.ColorVertexBuffer;
+  const bool hasColors = colorBuffer.GetNumVertices() == uint32(this->count);
+
+  // The merged vertices of each glTF vertex form a linked list, so finding a
+  // match only compares against the few vertices of the same source.
+  TArray<int32> firstMerged;
+  firstMerged.Init(INDEX_NONE, sourceVertexCount);
+  TArray<int32> nextMerged;
+  nextMerged.Reserve(this->count);
+
+  TArray<FVector3f> positions;
+  positions.Reserve(this->count);
+  TArray<FColor> colors;
+  if (hasColors) {
+    colors.Reserve(this->count);
+  }
+
+  // Merged vertex n is never created after corner n has been visited, so the
+  // attributes can be compacted in place.
+  int32 mergedCount = 0;
+  for (int32 i = 0; i < this->count; ++i) {
+    const uint32 source = indices[i];
+    const bool validSource = source < uint32(sourceVertexCount);
+
+    int32 match = INDEX_NONE;
+    if (validSource) {
+      for (int32 candidate = firstMerged[source]; candidate != INDEX_NONE;
+           candidate = nextMerged[candidate]) {
+        const bool sameTangents =
+            !hasTangents || (this->tangentX[candidate] == this->tangentX[i] &&
+                             this->tangentY[candidate] == this->tangentY[i]);
+        if (sameTangents && this->tangentZ[candidate] == this->tangentZ[i]) {
+          match = candidate;
+          break;
+        }
+      }
+    }
+
+    if (match != INDEX_NONE) {
+      indices[i] = uint32(match);
+      continue;
+    }
+
+    const int32 merged = mergedCount++;
+    this->tangentZ[merged] = this->tangentZ[i];
+    if (hasTangents) {
+      this->tangentX[merged] = this->tangentX[i];
+      this->tangentY[merged] = this->tangentY[i];
+    }
+    for (TArray<FVector2f>& texCoords : this->texCoordSets) {
+      texCoords[merged] = texCoords[i];
+    }
+    positions.Add(this->position(i));
+    if (hasColors) {
+      colors.Add(colorBuffer.VertexColor(uint32(i)));
+    }
+
+    nextMerged.Add(INDEX_NONE);
+    if (validSource) {
+      nextMerged[merged] = firstMerged[source];
+      firstMerged[source] = merged;
+    }
+    indices[i] = uint32(merged);
+  }
+
+  const int32 removed = this->count - mergedCount;
+  if (removed == 0) {
+    return 0;
+  }
+
+  this->count = mergedCount;
+  this->tangentZ.SetNum(mergedCount);
+  if (hasTangents) {
+    this->tangentX.SetNum(mergedCount);
+    this->tangentY.SetNum(mergedCount);
+  }
+  for (TArray<FVector2f>& texCoords : this->texCoordSets) {
+    texCoords.SetNum(mergedCount);
+  }
+  this->vertexBuffers.PositionVertexBuffer.Init(positions, false);
+  if (hasColors) {
+    colorBuffer.InitFromColorArray(colors, 1, false);
+  }
+
+  return removed;
+}
@@ -0,0 +1,93 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Math/Vector.h"
+#include "Math/Vector2D.h"
+#include "StaticMeshResources.h"
+
+/**
+ * @brief The vertex attributes of a primitive while it is being loaded.
+ *
+ * Positions and colors are written straight into the vertex buffers of the
+ * LOD. The static mesh vertex buffer interleaves the texture coordinate sets
+ * of each vertex, so it is only created once every set the primitive uses has
+ * a slot. Until then, the tangent basis and each texture coordinate set that
+ * is actually used are kept in arrays of their own.
+ */
+struct CesiumPrimitiveVertices {
+  CesiumPrimitiveVertices(
+      FStaticMeshVertexBuffers& vertexBuffers_,
+      int32 count_)
+      : vertexBuffers(vertexBuffers_), count(count_) {
+    this->vertexBuffers.PositionVertexBuffer.Init(uint32(this->count), false);
+    this->tangentZ.SetNumZeroed(this->count);
+  }
+
+  FVector3f& position(int32 index) {
+    return this->vertexBuffers.PositionVertexBuffer.VertexPosition(
+        uint32(index));
+  }
+
+  const FVector3f& position(int32 index) const {
+    return this->vertexBuffers.PositionVertexBuffer.VertexPosition(
+        uint32(index));
+  }
+
+  /**
+   * @brief Gets the given texture coordinate set, creating it with all
+   * coordinates zero on first use.
+   */
+  TArray<FVector2f>& texCoords(uint32 setIndex) {
+    while (uint32(this->texCoordSets.Num()) <= setIndex) {
+      this->texCoordSets.AddDefaulted_GetRef().SetNumZeroed(this->count);
+    }
+    return this->texCoordSets[setIndex];
+  }
+
+  /**
+   * @brief Allocates the tangents and bitangents, which are zero until set.
+   * Primitives that neither have nor need tangents leave them unallocated.
+   */
+  void allocateTangents() {
+    this->tangentX.SetNumZeroed(this->count);
+    this->tangentY.SetNumZeroed(this->count);
+  }
+
+  bool hasTangents() const {
+    return this->count > 0 && this->tangentX.Num() == this->count;
+  }
+
+  /**
+   * @brief Creates the static mesh vertex buffer from the tangent basis and
+   * texture coordinates, and then frees them.
+   */
+  void initStaticMeshVertexBuffer(uint32 texCoordSetCount);
+
+  /**
+   * @brief Merges the duplicated vertices of the same glTF vertex that ended
+   * up with identical normals and tangents.
+   *
+   * On entry, vertex `i` is the duplicate for triangle corner `i`, and
+   * `indices[i]` is the index of the glTF vertex it was copied from. On
+   * return, `indices[i]` is the index of the merged vertex for corner `i`.
+   * All other attributes are copied from the glTF vertex, so they are equal
+   * whenever the source index is.
+   *
+   * @return The number of vertices that were removed.
+   */
+  int32 weld(TArray<uint32>& indices, int32 sourceVertexCount);
+
+  FStaticMeshVertexBuffers& vertexBuffers;
+  int32 count;
+
+  // TangentX: Tangent
+  // TangentY: Bi-tangent
+  // TangentZ: Normal
+  TArray<FVector3f> tangentX;
+  TArray<FVector3f> tangentY;
+  TArray<FVector3f> tangentZ;
+
+  TArray<TArray<FVector2f>> texCoordSets;
+};
@@ -25,11 +25,22 @@ FCesiumPropertyTable::FCesiumPropertyTable(
     return;
   }
 
-  propertyTableView.forEachProperty([&properties = _properties](
+  propertyTableView.forEachProperty([&properties = _properties,
+                                     &Model,
+                                     &PropertyTable](
                                         const std::string& propertyName,
                                         auto propertyValue) mutable {
     FString key(UTF8_TO_TCHAR(propertyName.data()));
-    properties.Add(key, FCesiumPropertyTableProperty(propertyValue));
+    FCesiumPropertyTableProperty& property =
+        properties.Add(key, FCesiumPropertyTableProperty(propertyValue));
+
+    // Keep the raw buffers, so that the property's values can be read in
+    // place by column.
+    auto it = PropertyTable.properties.find(propertyName);
+    if (property._status == ECesiumPropertyTablePropertyStatus::Valid &&
+        it != PropertyTable.properties.end()) {
+      property._column = FCesiumPropertyTableColumn(Model, it->second);
+    }
   });
 }
 
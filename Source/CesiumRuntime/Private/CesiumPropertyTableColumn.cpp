@@ -0,0 +1,102 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumPropertyTableColumn.h"
+#include "CesiumGltf/Model.h"
+#include "CesiumGltf/PropertyTableProperty.h"
+#include <cstring>
+
+using namespace CesiumGltf;
+
+namespace {
+
+TArrayView<const uint8>
+getBufferViewData(const Model& model, int32_t bufferViewIndex) {
+  const BufferView* pBufferView =
+      Model::getSafe(&model.bufferViews, bufferViewIndex);
+  if (!pBufferView) {
+    return TArrayView<const uint8>();
+  }
+
+  const Buffer* pBuffer = Model::getSafe(&model.buffers, pBufferView->buffer);
+  if (!pBuffer) {
+    return TArrayView<const uint8>();
+  }
+
+  const std::vector<std::byte>& data = pBuffer->cesium.data;
+  if (pBufferView->byteOffset < 0 || pBufferView->byteLength < 0 ||
+      pBufferView->byteOffset + pBufferView->byteLength >
+          static_cast<int64_t>(data.size()) ||
+      pBufferView->byteLength > MAX_int32) {
+    return TArrayView<const uint8>();
+  }
+
+  return TArrayView<const uint8>(
+      reinterpret_cast<const uint8*>(data.data() + pBufferView->byteOffset),
+      static_cast<int32>(pBufferView->byteLength));
+}
+
+uint8 getOffsetSize(const std::string& offsetType) {
+  if (offsetType == PropertyTableProperty::ArrayOffsetType::UINT8) {
+    return 1;
+  }
+  if (offsetType == PropertyTableProperty::ArrayOffsetType::UINT16) {
+    return 2;
+  }
+  if (offsetType == PropertyTableProperty::ArrayOffsetType::UINT64) {
+    return 8;
+  }
+  return 4;
+}
+
+} // namespace
+
+FCesiumPropertyTableColumn::FCesiumPropertyTableColumn(
+    const Model& Model,
+    const PropertyTableProperty& Property)
+    : Values(getBufferViewData(Model, Property.values)),
+      ArrayOffsetSize(getOffsetSize(Property.arrayOffsetType)),
+      StringOffsetSize(getOffsetSize(Property.stringOffsetType)) {
+  if (Property.arrayOffsets) {
+    ArrayOffsets = getBufferViewData(Model, *Property.arrayOffsets);
+  }
+  if (Property.stringOffsets) {
+    StringOffsets = getBufferViewData(Model, *Property.stringOffsets);
+  }
+}
+
+/*static*/ uint64 FCesiumPropertyTableColumn::GetOffset(
+    const TArrayView<const uint8>& Offsets,
+    uint8 OffsetSize,
+    int64 Index) {
+  check(Index >= 0 && (Index + 1) * OffsetSize <= Offsets.Num());
+  const uint8* pOffset = Offsets.GetData() + Index * OffsetSize;
+  switch (OffsetSize) {
+  case 1:
+    return *pOffset;
+  case 2: {
+    uint16 offset;
+    std::memcpy(&offset, pOffset, sizeof(offset));
+    return offset;
+  }
+  case 8: {
+    uint64 offset;
+    std::memcpy(&offset, pOffset, sizeof(offset));
+    return offset;
+  }
+  default: {
+    uint32 offset;
+    std::memcpy(&offset, pOffset, sizeof(offset));
+    return offset;
+  }
+  }
+}
+
+std::string_view
+FCesiumPropertyTableColumn::GetStringAt(int64 StringIndex) const {
+  const uint64 begin = GetStringOffset(StringIndex);
+  const uint64 end = GetStringOffset(StringIndex + 1);
+  check(begin <= end && end <= uint64(Values.Num()));
+  return std::string_view(
+      reinterpret_cast<const char*>(Values.GetData() + begin),
+      size_t(end - begin));
+}
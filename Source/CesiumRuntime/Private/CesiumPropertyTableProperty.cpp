@@ -1254,6 +1254,116 @@ FCesiumMetadataValue UCesiumPropertyTablePropertyBlueprintLibrary::GetValue(
       });
 }
 
+namespace {
+/**
+ * Writes the converted value of each feature given by getFeatureID into
+ * outValues, resolving the type of the property only once.
+ */
+template <typename T, typename GetFeatureID>
+void getPropertyTablePropertyValues(
+    const std::any& property,
+    const FCesiumMetadataValueType& valueType,
+    bool normalized,
+    TArrayView<T> outValues,
+    const T& defaultValue,
+    GetFeatureID&& getFeatureID) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::GetPropertyTablePropertyValues)
+  propertyTablePropertyCallback<void>(
+      property,
+      valueType,
+      normalized,
+      [outValues, &defaultValue, &getFeatureID](const auto& v) {
+        // size() returns zero if the view is invalid.
+        const int64 size = v.size();
+        for (int32 i = 0; i < outValues.Num(); ++i) {
+          const int64 featureID = getFeatureID(i);
+          if (featureID < 0 || featureID >= size) {
+            outValues[i] = defaultValue;
+            continue;
+          }
+          auto maybeValue = v.get(featureID);
+          if (maybeValue) {
+            auto value = *maybeValue;
+            outValues[i] =
+                CesiumMetadataConversions<T, decltype(value)>::convert(
+                    value,
+                    defaultValue);
+          } else {
+            outValues[i] = defaultValue;
+          }
+        }
+      });
+}
+} // namespace
+
+template <typename T>
+void UCesiumPropertyTablePropertyBlueprintLibrary::GetValues(
+    const FCesiumPropertyTableProperty& Property,
+    TArrayView<const int64> FeatureIDs,
+    TArrayView<T> OutValues,
+    const T& DefaultValue) {
+  check(FeatureIDs.Num() == OutValues.Num());
+  getPropertyTablePropertyValues(
+      Property._property,
+      Property._valueType,
+      Property._normalized,
+      OutValues,
+      DefaultValue,
+      [FeatureIDs](int32 i) { return FeatureIDs[i]; });
+}
+
+template <typename T>
+void UCesiumPropertyTablePropertyBlueprintLibrary::GetValues(
+    const FCesiumPropertyTableProperty& Property,
+    int64 FirstFeatureID,
+    TArrayView<T> OutValues,
+    const T& DefaultValue) {
+  getPropertyTablePropertyValues(
+      Property._property,
+      Property._valueType,
+      Property._normalized,
+      OutValues,
+      DefaultValue,
+      [FirstFeatureID](int32 i) { return FirstFeatureID + i; });
+}
+
+const FCesiumPropertyTableColumn&
+UCesiumPropertyTablePropertyBlueprintLibrary::GetColumn(
+    const FCesiumPropertyTableProperty& Property) {
+  return Property._column;
+}
+
+#define CESIUM_INSTANTIATE_GET_VALUES(T)                                       \
+  template void                                                                \
+  UCesiumPropertyTablePropertyBlueprintLibrary::GetValues<T>(                  \
+      const FCesiumPropertyTableProperty&,                                     \
+      TArrayView<const int64>,                                                 \
+      TArrayView<T>,                                                           \
+      const T&);                                                               \
+  template void                                                                \
+  UCesiumPropertyTablePropertyBlueprintLibrary::GetValues<T>(                  \
+      const FCesiumPropertyTableProperty&,                                     \
+      int64,                                                                   \
+      TArrayView<T>,                                                           \
+      const T&);
+
+CESIUM_INSTANTIATE_GET_VALUES(bool)
+CESIUM_INSTANTIATE_GET_VALUES(uint8)
+CESIUM_INSTANTIATE_GET_VALUES(int32)
+CESIUM_INSTANTIATE_GET_VALUES(int64)
+CESIUM_INSTANTIATE_GET_VALUES(float)
+CESIUM_INSTANTIATE_GET_VALUES(double)
+CESIUM_INSTANTIATE_GET_VALUES(FIntPoint)
+CESIUM_INSTANTIATE_GET_VALUES(FVector2D)
+CESIUM_INSTANTIATE_GET_VALUES(FIntVector)
+CESIUM_INSTANTIATE_GET_VALUES(FVector3f)
+CESIUM_INSTANTIATE_GET_VALUES(FVector)
+CESIUM_INSTANTIATE_GET_VALUES(FVector4)
+CESIUM_INSTANTIATE_GET_VALUES(FMatrix)
+CESIUM_INSTANTIATE_GET_VALUES(FString)
+
+#undef CESIUM_INSTANTIATE_GET_VALUES
+
 FCesiumMetadataValue UCesiumPropertyTablePropertyBlueprintLibrary::GetRawValue(
     UPARAM(ref) const FCesiumPropertyTableProperty& Property,
     int64 FeatureID) {
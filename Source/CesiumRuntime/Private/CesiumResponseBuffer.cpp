@@ -0,0 +1,65 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumResponseBuffer.h"
+#include "CesiumMappedFile.h"
+#include <utility>
+
+std::atomic<uint64_t> CesiumResponseBuffer::_adoptedBytes{0};
+std::atomic<uint64_t> CesiumResponseBuffer::_mappedBytes{0};
+
+CesiumResponseBuffer::CesiumResponseBuffer(TArray64<uint8>&& data) noexcept
+    : _storage(std::move(data)), _span() {
+  const TArray64<uint8>& stored = std::get<TArray64<uint8>>(this->_storage);
+  this->_span = gsl::span<const std::byte>(
+      reinterpret_cast<const std::byte*>(stored.GetData()),
+      size_t(stored.Num()));
+  _adoptedBytes += this->_span.size();
+}
+
+CesiumResponseBuffer::CesiumResponseBuffer(
+    std::vector<std::byte>&& data) noexcept
+    : _storage(std::move(data)), _span() {
+  const std::vector<std::byte>& stored =
+      std::get<std::vector<std::byte>>(this->_storage);
+  this->_span = gsl::span<const std::byte>(stored.data(), stored.size());
+  _adoptedBytes += this->_span.size();
+}
+
+CesiumResponseBuffer::CesiumResponseBuffer(
+    std::shared_ptr<const CesiumMappedFile>&& pFile,
+    const gsl::span<const std::byte>& range) noexcept
+    : _storage(), _span(range) {
+  const gsl::span<const std::byte> mapping = pFile->span();
+  check(
+      range.empty() ||
+      (range.data() >= mapping.data() &&
+       range.data() + range.size() <= mapping.data() + mapping.size()));
+  this->_storage = std::move(pFile);
+  _mappedBytes += this->_span.size();
+}
+
+CesiumResponseBuffer::CesiumResponseBuffer(
+    CesiumResponseBuffer&& rhs) noexcept
+    : _storage(std::move(rhs._storage)), _span(rhs._span) {
+  rhs._storage = std::monostate();
+  rhs._span = gsl::span<const std::byte>();
+}
+
+CesiumResponseBuffer&
+CesiumResponseBuffer::operator=(CesiumResponseBuffer&& rhs) noexcept {
+  if (this != &rhs) {
+    this->_storage = std::move(rhs._storage);
+    this->_span = rhs._span;
+    rhs._storage = std::monostate();
+    rhs._span = gsl::span<const std::byte>();
+  }
+  return *this;
+}
+
+/*static*/ CesiumResponseBuffer::Statistics
+CesiumResponseBuffer::getStatistics() noexcept {
+  Statistics result;
+  result.adoptedBytes = _adoptedBytes;
+  result.mappedBytes = _mappedBytes;
+  return result;
+}
@@ -0,0 +1,91 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <gsl/span>
+#include <memory>
+#include <variant>
+#include <vector>
+
+class CesiumMappedFile;
+
+/**
+ * @brief A move-only, immutable byte buffer that takes ownership of the
+ * storage produced by the file layer without copying it.
+ *
+ * An {@link CesiumAsync::IAssetResponse} holds one of these and returns
+ * {@link CesiumResponseBuffer::span} from its `data()`, so the bytes that
+ * were received are the bytes that the tile content loaders parse.
+ */
+class CesiumResponseBuffer {
+public:
+  /**
+   * @brief Process-wide counters of the bytes that went through response
+   * buffers.
+   */
+  struct Statistics {
+    /** @brief Bytes whose storage was adopted without copying. */
+    uint64_t adoptedBytes = 0;
+    /** @brief Bytes viewed directly in memory-mapped files. */
+    uint64_t mappedBytes = 0;
+  };
+
+  /**
+   * @brief Creates an empty buffer.
+   */
+  CesiumResponseBuffer() noexcept = default;
+
+  /**
+   * @brief Adopts an array loaded from a file.
+   */
+  explicit CesiumResponseBuffer(TArray64<uint8>&& data) noexcept;
+
+  /**
+   * @brief Views a range of a memory-mapped file. The mapping is kept alive
+   * for as long as this buffer is.
+   *
+   * @param pFile The mapped file.
+   * @param range The bytes to view, which must lie within the mapping.
+   */
+  CesiumResponseBuffer(
+      std::shared_ptr<const CesiumMappedFile>&& pFile,
+      const gsl::span<const std::byte>& range) noexcept;
+
+  /**
+   * @brief Adopts a standard vector.
+   */
+  explicit CesiumResponseBuffer(std::vector<std::byte>&& data) noexcept;
+
+  CesiumResponseBuffer(CesiumResponseBuffer&& rhs) noexcept;
+  CesiumResponseBuffer& operator=(CesiumResponseBuffer&& rhs) noexcept;
+  CesiumResponseBuffer(const CesiumResponseBuffer& rhs) = delete;
+  CesiumResponseBuffer& operator=(const CesiumResponseBuffer& rhs) = delete;
+
+  /**
+   * @brief Gets a view of the bytes in this buffer. Moving the buffer does not
+   * move the bytes, so the view stays valid until the buffer it was moved
+   * into is destroyed.
+   */
+  gsl::span<const std::byte> span() const noexcept { return this->_span; }
+
+  /**
+   * @brief Gets the process-wide adopted and mapped byte counters.
+   */
+  static Statistics getStatistics() noexcept;
+
+private:
+  std::variant<
+      std::monostate,
+      TArray64<uint8>,
+      std::vector<std::byte>,
+      std::shared_ptr<const CesiumMappedFile>>
+      _storage;
+  gsl::span<const std::byte> _span;
+
+  static std::atomic<uint64_t> _adoptedBytes;
+  static std::atomic<uint64_t> _mappedBytes;
+};
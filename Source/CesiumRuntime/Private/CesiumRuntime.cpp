@@ -5,8 +5,11 @@
 #include "CesiumAsync/CachingAssetAccessor.h"
 #include "CesiumAsync/GunzipAssetAccessor.h"
 #include "CesiumAsync/SqliteCache.h"
+#include "CesiumMaterialInstancePool.h"
 #include "CesiumRuntimeSettings.h"
+#include "CesiumTieredCacheDatabase.h"
 #include "CesiumUtility/Tracing.h"
+#include "Engine/World.h"
 #include "HAL/FileManager.h"
 #include "HttpModule.h"
 #include "Interfaces/IPluginManager.h"
@@ -28,6 +31,20 @@
 
 DEFINE_LOG_CATEGORY(LogCesium);
 
+namespace {
+
+// The task processor created by getTaskProcessor, if it has been created. Its
+// worker threads are stopped when the module shuts down.
+std::weak_ptr<UnrealTaskProcessor> pCreatedTaskProcessor;
+
+// The tiered cache created by getCacheDatabase, if it has been created. Its
+// writer thread is stopped when the module shuts down.
+std::weak_ptr<CesiumTieredCacheDatabase> pTieredCacheDatabase;
+
+FDelegateHandle worldCleanupHandle;
+
+} // namespace
+
 void FCesiumRuntimeModule::StartupModule() {
   Cesium3DTilesSelection::registerAllTileContentTypes();
 
@@ -50,9 +67,31 @@ void FCesiumRuntimeModule::StartupModule() {
   AddShaderSourceDirectoryMapping(
       TEXT("/Plugin/CesiumForUnreal"),
       PluginShaderDir);
+
+  worldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddLambda(
+      [](UWorld*, bool, bool) { CesiumMaterialInstancePool::clear(); });
 }
 
-void FCesiumRuntimeModule::ShutdownModule() { CESIUM_TRACE_SHUTDOWN(); }
+void FCesiumRuntimeModule::ShutdownModule() {
+  // Stop the worker threads while the engine's threading is still up, rather
+  // than during static destruction.
+  if (std::shared_ptr<UnrealTaskProcessor> pTaskProcessor =
+          pCreatedTaskProcessor.lock()) {
+    pTaskProcessor->shutdown();
+  }
+
+  // Likewise, write the queued cache entries and stop the cache's writer
+  // thread now. Joining it during static destruction can deadlock.
+  if (std::shared_ptr<CesiumTieredCacheDatabase> pCache =
+          pTieredCacheDatabase.lock()) {
+    pCache->flushAndStop();
+  }
+
+  FWorldDelegates::OnWorldCleanup.Remove(worldCleanupHandle);
+  CesiumMaterialInstancePool::clear();
+
+  CESIUM_TRACE_SHUTDOWN();
+}
 
 #undef LOCTEXT_NAMESPACE
 
@@ -62,9 +101,26 @@ FCesium3DTilesetIonTroubleshooting OnCesium3DTilesetIonTroubleshooting{};
 FCesiumRasterOverlayIonTroubleshooting
     OnCesiumRasterOverlayIonTroubleshooting{};
 
+namespace {
+
+std::shared_ptr<UnrealTaskProcessor> createTaskProcessor() {
+  std::shared_ptr<UnrealTaskProcessor> pTaskProcessor =
+      std::make_shared<UnrealTaskProcessor>(
+          GetDefault<UCesiumRuntimeSettings>()->WorkerThreadCount);
+  pCreatedTaskProcessor = pTaskProcessor;
+  return pTaskProcessor;
+}
+
+} // namespace
+
+const std::shared_ptr<UnrealTaskProcessor>& getTaskProcessor() {
+  static std::shared_ptr<UnrealTaskProcessor> pTaskProcessor =
+      createTaskProcessor();
+  return pTaskProcessor;
+}
+
 CesiumAsync::AsyncSystem& getAsyncSystem() noexcept {
-  static CesiumAsync::AsyncSystem asyncSystem(
-      std::make_shared<UnrealTaskProcessor>());
+  static CesiumAsync::AsyncSystem asyncSystem(getTaskProcessor());
   return asyncSystem;
 }
 
@@ -98,21 +154,39 @@ std::string getCacheDatabaseName() {
   return TCHAR_TO_UTF8(*PlatformAbsolutePath);
 }
 
+std::shared_ptr<CesiumAsync::ICacheDatabase> createCacheDatabase() {
+  const UCesiumRuntimeSettings* pSettings =
+      GetDefault<UCesiumRuntimeSettings>();
+
+  std::shared_ptr<CesiumTieredCacheDatabase> pCache =
+      std::make_shared<CesiumTieredCacheDatabase>(
+          std::make_shared<CesiumAsync::SqliteCache>(
+              spdlog::default_logger(),
+              getCacheDatabaseName(),
+              pSettings->MaxCacheItems),
+          uint64_t(FMath::Max(pSettings->MemoryCacheSizeMegabytes, 0)) *
+              1024 * 1024,
+          uint64_t(FMath::Max(pSettings->MaxPendingCacheWriteMegabytes, 0)) *
+              1024 * 1024,
+          uint32_t(FMath::Max(pSettings->CacheWriteBatchSize, 1)));
+  pTieredCacheDatabase = pCache;
+  return pCache;
+}
+
 } // namespace
 
 std::shared_ptr<CesiumAsync::ICacheDatabase>& getCacheDatabase() {
-  static int MaxCacheItems =
-      GetDefault<UCesiumRuntimeSettings>()->MaxCacheItems;
-
   static std::shared_ptr<CesiumAsync::ICacheDatabase> pCacheDatabase =
-      std::make_shared<CesiumAsync::SqliteCache>(
-          spdlog::default_logger(),
-          getCacheDatabaseName(),
-          MaxCacheItems);
-
+      createCacheDatabase();
   return pCacheDatabase;
 }
 
+const std::shared_ptr<UnrealAssetAccessor>& getUnrealAssetAccessor() {
+  static std::shared_ptr<UnrealAssetAccessor> pUnrealAssetAccessor =
+      std::make_shared<UnrealAssetAccessor>();
+  return pUnrealAssetAccessor;
+}
+
 const std::shared_ptr<CesiumAsync::IAssetAccessor>& getAssetAccessor() {
   static int RequestsPerCachePrune =
       GetDefault<UCesiumRuntimeSettings>()->RequestsPerCachePrune;
@@ -120,7 +194,7 @@ const std::shared_ptr<CesiumAsync::IAssetAccessor>& getAssetAccessor() {
       std::make_shared<CesiumAsync::GunzipAssetAccessor>(
           std::make_shared<CesiumAsync::CachingAssetAccessor>(
               spdlog::default_logger(),
-              std::make_shared<UnrealAssetAccessor>(),
+              getUnrealAssetAccessor(),
               getCacheDatabase(),
               RequestsPerCachePrune));
   return pAssetAccessor;
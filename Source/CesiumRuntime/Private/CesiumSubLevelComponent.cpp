@@ -22,7 +22,10 @@ using namespace CesiumGeospatial;
 
 bool UCesiumSubLevelComponent::GetEnabled() const { return this->Enabled; }
 
-void UCesiumSubLevelComponent::SetEnabled(bool value) { this->Enabled = value; }
+void UCesiumSubLevelComponent::SetEnabled(bool value) {
+  this->Enabled = value;
+  this->_invalidateSwitcherIndex();
+}
 
 double UCesiumSubLevelComponent::GetOriginLongitude() const {
   return this->OriginLongitude;
@@ -30,6 +33,7 @@ double UCesiumSubLevelComponent::GetOriginLongitude() const {
 
 void UCesiumSubLevelComponent::SetOriginLongitude(double value) {
   this->OriginLongitude = value;
+  this->_invalidateSwitcherIndex();
   this->UpdateGeoreferenceIfSubLevelIsActive();
 }
 
@@ -39,6 +43,7 @@ double UCesiumSubLevelComponent::GetOriginLatitude() const {
 
 void UCesiumSubLevelComponent::SetOriginLatitude(double value) {
   this->OriginLatitude = value;
+  this->_invalidateSwitcherIndex();
   this->UpdateGeoreferenceIfSubLevelIsActive();
 }
 
@@ -48,6 +53,7 @@ double UCesiumSubLevelComponent::GetOriginHeight() const {
 
 void UCesiumSubLevelComponent::SetOriginHeight(double value) {
   this->OriginHeight = value;
+  this->_invalidateSwitcherIndex();
   this->UpdateGeoreferenceIfSubLevelIsActive();
 }
 
@@ -57,6 +63,7 @@ double UCesiumSubLevelComponent::GetLoadRadius() const {
 
 void UCesiumSubLevelComponent::SetLoadRadius(double value) {
   this->LoadRadius = value;
+  this->_invalidateSwitcherIndex();
 }
 
 TSoftObjectPtr<ACesiumGeoreference>
@@ -114,6 +121,7 @@ void UCesiumSubLevelComponent::SetOriginLongitudeLatitudeHeight(
     this->OriginLongitude = longitudeLatitudeHeight.X;
     this->OriginLatitude = longitudeLatitudeHeight.Y;
     this->OriginHeight = longitudeLatitudeHeight.Z;
+    this->_invalidateSwitcherIndex();
     this->UpdateGeoreferenceIfSubLevelIsActive();
   }
 }
@@ -410,6 +418,7 @@ void UCesiumSubLevelComponent::OnComponentCreated() {
     this->OriginLongitude = this->ResolvedGeoreference->GetOriginLongitude();
     this->OriginLatitude = this->ResolvedGeoreference->GetOriginLatitude();
     this->OriginHeight = this->ResolvedGeoreference->GetOriginHeight();
+    pSwitcher->InvalidateSubLevelIndex();
 
     // In Editor worlds, make the newly-created sub-level the active one. Unless
     // it's already hidden.
@@ -431,6 +440,9 @@ void UCesiumSubLevelComponent::PostEditChangeProperty(
     FPropertyChangedEvent& PropertyChangedEvent) {
   Super::PostEditChangeProperty(PropertyChangedEvent);
 
+  // Any property may have been changed, including by an undo.
+  this->_invalidateSwitcherIndex();
+
   if (!PropertyChangedEvent.Property) {
     return;
   }
@@ -563,6 +575,12 @@ ALevelInstance* UCesiumSubLevelComponent::_getLevelInstance() const noexcept {
   return pOwner;
 }
 
+void UCesiumSubLevelComponent::_invalidateSwitcherIndex() noexcept {
+  UCesiumSubLevelSwitcherComponent* pSwitcher = this->_getSwitcher();
+  if (pSwitcher)
+    pSwitcher->InvalidateSubLevelIndex();
+}
+
 void UCesiumSubLevelComponent::_invalidateResolvedGeoreference() {
   if (IsValid(this->ResolvedGeoreference)) {
     UCesiumSubLevelSwitcherComponent* pSwitcher = this->_getSwitcher();
@@ -0,0 +1,127 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumSubLevelIndex.h"
+#include <algorithm>
+
+namespace {
+
+// Small leaves are cheaper to test directly than to descend further.
+const int32 MaximumSpheresPerLeaf = 4;
+
+bool isInside(const FVector& position, const FVector& min, const FVector& max) {
+  return position.X >= min.X && position.X <= max.X && position.Y >= min.Y &&
+         position.Y <= max.Y && position.Z >= min.Z && position.Z <= max.Z;
+}
+
+} // namespace
+
+void FCesiumSubLevelIndex::Reset() {
+  this->_centers.Reset();
+  this->_radii.Reset();
+  this->_order.Reset();
+  this->_nodes.Reset();
+}
+
+int32 FCesiumSubLevelIndex::Add(const FVector& Center, double Radius) {
+  this->_radii.Add(Radius);
+  return this->_centers.Add(Center);
+}
+
+void FCesiumSubLevelIndex::Build() {
+  this->_order.SetNumUninitialized(this->_centers.Num());
+  for (int32 i = 0; i < this->_order.Num(); ++i) {
+    this->_order[i] = i;
+  }
+
+  this->_nodes.Reset();
+  if (!this->_order.IsEmpty()) {
+    this->_build(0, this->_order.Num());
+  }
+}
+
+int32 FCesiumSubLevelIndex::_build(int32 begin, int32 end) {
+  const int32 nodeIndex = this->_nodes.AddUninitialized();
+
+  FVector min(TNumericLimits<double>::Max());
+  FVector max(TNumericLimits<double>::Lowest());
+  FVector centerMin(TNumericLimits<double>::Max());
+  FVector centerMax(TNumericLimits<double>::Lowest());
+  for (int32 i = begin; i < end; ++i) {
+    const FVector& center = this->_centers[this->_order[i]];
+    const FVector radius(FMath::Max(this->_radii[this->_order[i]], 0.0));
+    min = min.ComponentMin(center - radius);
+    max = max.ComponentMax(center + radius);
+    centerMin = centerMin.ComponentMin(center);
+    centerMax = centerMax.ComponentMax(center);
+  }
+
+  if (end - begin <= MaximumSpheresPerLeaf) {
+    this->_nodes[nodeIndex] = Node{min, max, begin, end - begin};
+    return nodeIndex;
+  }
+
+  // Split at the median center along the axis in which the centers are most
+  // spread out.
+  const FVector size = centerMax - centerMin;
+  int32 axis = 2;
+  if (size.X >= size.Y && size.X >= size.Z) {
+    axis = 0;
+  } else if (size.Y >= size.Z) {
+    axis = 1;
+  }
+  const int32 middle = begin + (end - begin) / 2;
+  std::nth_element(
+      this->_order.GetData() + begin,
+      this->_order.GetData() + middle,
+      this->_order.GetData() + end,
+      [this, axis](int32 a, int32 b) {
+        return this->_centers[a][axis] < this->_centers[b][axis];
+      });
+
+  this->_build(begin, middle);
+  const int32 second = this->_build(middle, end);
+  this->_nodes[nodeIndex] = Node{min, max, second, 0};
+  return nodeIndex;
+}
+
+int32 FCesiumSubLevelIndex::FindClosestContaining(
+    const FVector& Position) const {
+  int32 closest = INDEX_NONE;
+  double closestDistance = TNumericLimits<double>::Max();
+
+  if (this->_nodes.IsEmpty()) {
+    return closest;
+  }
+
+  TArray<int32, TInlineAllocator<64>> stack;
+  stack.Add(0);
+  while (!stack.IsEmpty()) {
+    const int32 nodeIndex = stack.Pop(false);
+    const Node& node = this->_nodes[nodeIndex];
+    if (!isInside(Position, node.min, node.max)) {
+      continue;
+    }
+
+    if (node.count == 0) {
+      stack.Add(node.index);
+      stack.Add(nodeIndex + 1);
+      continue;
+    }
+
+    for (int32 i = node.index; i < node.index + node.count; ++i) {
+      const int32 sphere = this->_order[i];
+      const double distance =
+          FVector::Distance(this->_centers[sphere], Position);
+      if (distance >= this->_radii[sphere]) {
+        continue;
+      }
+      if (distance < closestDistance ||
+          (distance == closestDistance && sphere < closest)) {
+        closest = sphere;
+        closestDistance = distance;
+      }
+    }
+  }
+
+  return closest;
+}
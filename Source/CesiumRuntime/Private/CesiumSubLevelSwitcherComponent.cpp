@@ -1,6 +1,7 @@
 #include "CesiumSubLevelSwitcherComponent.h"
 #include "CesiumRuntime.h"
 #include "CesiumSubLevelComponent.h"
+#include "CesiumWgs84Ellipsoid.h"
 #include "Engine/LevelStreaming.h"
 #include "Engine/World.h"
 #include "LevelInstance/LevelInstanceActor.h"
@@ -34,6 +35,7 @@ UCesiumSubLevelSwitcherComponent::UCesiumSubLevelSwitcherComponent() {
 void UCesiumSubLevelSwitcherComponent::RegisterSubLevel(
     ALevelInstance* pSubLevel) noexcept {
   this->_sublevels.AddUnique(pSubLevel);
+  this->InvalidateSubLevelIndex();
 
   // Do extra checks on the next tick so that if we're in a game and this level
   // is already loaded and shouldn't be, we can unload it.
@@ -53,6 +55,7 @@ void UCesiumSubLevelSwitcherComponent::RegisterSubLevel(
 void UCesiumSubLevelSwitcherComponent::UnregisterSubLevel(
     ALevelInstance* pSubLevel) noexcept {
   this->_sublevels.Remove(pSubLevel);
+  this->InvalidateSubLevelIndex();
 
   // Next tick, we need to check if the target is still registered, in case this
   // method call just removed it. But we can't actually do the check here
@@ -102,6 +105,67 @@ void UCesiumSubLevelSwitcherComponent::SetTargetSubLevel(
   }
 }
 
+ALevelInstance* UCesiumSubLevelSwitcherComponent::FindClosestSubLevel(
+    const FVector& EarthCenteredEarthFixedPosition) noexcept {
+  if (!this->_subLevelIndexIsValid) {
+    this->_buildSubLevelIndex();
+  }
+
+  int32 closest = this->_subLevelIndex.FindClosestContaining(
+      EarthCenteredEarthFixedPosition);
+  if (closest == INDEX_NONE) {
+    return nullptr;
+  }
+
+  ALevelInstance* pSubLevel = this->_indexedSubLevels[closest].Get();
+  if (!IsValid(pSubLevel)) {
+    // The sub-level was destroyed without being unregistered first. Leave it
+    // out and try again.
+    this->_buildSubLevelIndex();
+    closest = this->_subLevelIndex.FindClosestContaining(
+        EarthCenteredEarthFixedPosition);
+    pSubLevel = closest == INDEX_NONE
+                    ? nullptr
+                    : this->_indexedSubLevels[closest].Get();
+  }
+
+  return pSubLevel;
+}
+
+void UCesiumSubLevelSwitcherComponent::InvalidateSubLevelIndex() noexcept {
+  this->_subLevelIndexIsValid = false;
+}
+
+void UCesiumSubLevelSwitcherComponent::_buildSubLevelIndex() {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::BuildSubLevelIndex)
+
+  this->_indexedSubLevels.Reset();
+  this->_subLevelIndex.Reset();
+
+  for (const TWeakObjectPtr<ALevelInstance>& pWeak : this->_sublevels) {
+    ALevelInstance* pSubLevel = pWeak.Get();
+    if (!IsValid(pSubLevel))
+      continue;
+
+    UCesiumSubLevelComponent* pComponent =
+        pSubLevel->FindComponentByClass<UCesiumSubLevelComponent>();
+    if (!IsValid(pComponent) || !pComponent->GetEnabled())
+      continue;
+
+    FVector originEcef =
+        UCesiumWgs84Ellipsoid::LongitudeLatitudeHeightToEarthCenteredEarthFixed(
+            FVector(
+                pComponent->GetOriginLongitude(),
+                pComponent->GetOriginLatitude(),
+                pComponent->GetOriginHeight()));
+    this->_subLevelIndex.Add(originEcef, pComponent->GetLoadRadius());
+    this->_indexedSubLevels.Add(pSubLevel);
+  }
+
+  this->_subLevelIndex.Build();
+  this->_subLevelIndexIsValid = true;
+}
+
 void UCesiumSubLevelSwitcherComponent::TickComponent(
     float DeltaTime,
     enum ELevelTick TickType,
@@ -688,13 +688,9 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
   return pResult;
 }
 
-TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
-    CesiumGltf::Model& model,
-    const CesiumGltf::Texture& texture,
-    bool sRGB) {
-
-  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LoadTexture)
-
+int32_t getTextureSourceIndex(
+    const CesiumGltf::Model& model,
+    const CesiumGltf::Texture& texture) {
   const CesiumGltf::ExtensionKhrTextureBasisu* pKtxExtension =
       texture.getExtension<CesiumGltf::ExtensionKhrTextureBasisu>();
   const CesiumGltf::ExtensionTextureWebp* pWebpExtension =
@@ -711,7 +707,7 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
               "KTX texture source index must be non-negative and less than %d, but is %d"),
           model.images.size(),
           pKtxExtension->source);
-      return nullptr;
+      return -1;
     }
     source = pKtxExtension->source;
   } else if (pWebpExtension) {
@@ -724,7 +720,7 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
               "WebP texture source index must be non-negative and less than %d, but is %d"),
           model.images.size(),
           pWebpExtension->source);
-      return nullptr;
+      return -1;
     }
     source = pWebpExtension->source;
   } else {
@@ -736,11 +732,26 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
               "Texture source index must be non-negative and less than %d, but is %d"),
           model.images.size(),
           texture.source);
-      return nullptr;
+      return -1;
     }
     source = texture.source;
   }
 
+  return source;
+}
+
+TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
+    CesiumGltf::Model& model,
+    const CesiumGltf::Texture& texture,
+    bool sRGB) {
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LoadTexture)
+
+  const int32_t source = getTextureSourceIndex(model, texture);
+  if (source < 0) {
+    return nullptr;
+  }
+
   CesiumGltf::ImageCesium& image = model.images[source].cesium;
   const CesiumGltf::Sampler* pSampler =
       CesiumGltf::Model::getSafe(&model.samplers, texture.sampler);
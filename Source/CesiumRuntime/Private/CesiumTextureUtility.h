@@ -122,6 +122,17 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
     bool generateMipMaps,
     bool sRGB);
 
+/**
+ * @brief Gets the index of the image that the given texture samples, taking
+ * the KHR_texture_basisu and EXT_texture_webp extensions into account.
+ *
+ * @return The image index, or -1 (after logging a warning) if the texture
+ * does not refer to a valid image.
+ */
+int32_t getTextureSourceIndex(
+    const CesiumGltf::Model& model,
+    const CesiumGltf::Texture& texture);
+
 /**
  * @brief Does the asynchronous part of renderer resource preparation for this
  * image. Should be called in a background thread. May generate mip-maps for
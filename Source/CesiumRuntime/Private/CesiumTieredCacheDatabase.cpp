@@ -0,0 +1,420 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTieredCacheDatabase.h"
+#include "CesiumRuntime.h"
+#include "HAL/PlatformTime.h"
+#include <vector>
+
+DECLARE_CYCLE_STAT(
+    TEXT("Request Cache Lookup"),
+    STAT_CesiumRequestCacheLookup,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Request Cache Memory Hits"),
+    STAT_CesiumRequestCacheMemoryHits,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Request Cache Pending Write Hits"),
+    STAT_CesiumRequestCachePendingWriteHits,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Request Cache Disk Hits"),
+    STAT_CesiumRequestCacheDiskHits,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Request Cache Misses"),
+    STAT_CesiumRequestCacheMisses,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Request Cache Pending Writes"),
+    STAT_CesiumRequestCachePendingWrites,
+    STATGROUP_Cesium);
+DECLARE_MEMORY_STAT(
+    TEXT("Request Cache Memory Tier"),
+    STAT_CesiumRequestCacheMemoryBytes,
+    STATGROUP_Cesium);
+
+using namespace CesiumAsync;
+
+CesiumTieredCacheDatabase::CesiumTieredCacheDatabase(
+    const std::shared_ptr<ICacheDatabase>& pDiskCache,
+    uint64_t maxMemoryBytes,
+    uint64_t maxPendingWriteBytes,
+    uint32_t writeBatchSize)
+    : _pDiskCache(pDiskCache),
+      _maxMemoryBytes(maxMemoryBytes),
+      _maxPendingWriteBytes(maxPendingWriteBytes),
+      _writeBatchSize(std::max(writeBatchSize, 1U)),
+      _lru(),
+      _memoryEntries(),
+      _memoryBytes(0),
+      _pendingWrites(),
+      _pendingWriteIndex(),
+      _pendingWriteBytes(0),
+      _pruneRequested(false),
+      _writeInProgress(false),
+      _stopWriter(false),
+      _generation(0),
+      _memoryHits(0),
+      _pendingWriteHits(0),
+      _diskHits(0),
+      _misses(0),
+      _lookupCount(0),
+      _lookupCycles(0),
+      _completedWrites(0),
+      _writeBatches(0),
+      _writerThread() {
+  this->_writerThread = std::thread([this]() { this->writerThreadMain(); });
+}
+
+CesiumTieredCacheDatabase::~CesiumTieredCacheDatabase() noexcept {
+  this->flushAndStop();
+}
+
+void CesiumTieredCacheDatabase::flushAndStop() {
+  {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    this->_stopWriter = true;
+  }
+  this->_writerWakeUp.notify_all();
+
+  if (this->_writerThread.joinable()) {
+    this->_writerThread.join();
+  }
+}
+
+std::optional<CacheItem>
+CesiumTieredCacheDatabase::getEntry(const std::string& key) const {
+  SCOPE_CYCLE_COUNTER(STAT_CesiumRequestCacheLookup);
+  const uint64_t startCycles = FPlatformTime::Cycles64();
+
+  CacheItemPtr pItem;
+  uint64_t generation;
+  {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    generation = this->_generation;
+
+    auto memoryIt = this->_memoryEntries.find(key);
+    if (memoryIt != this->_memoryEntries.end()) {
+      this->_lru.splice(
+          this->_lru.begin(),
+          this->_lru,
+          memoryIt->second.lruPosition);
+      pItem = memoryIt->second.pItem;
+      ++this->_memoryHits;
+      INC_DWORD_STAT(STAT_CesiumRequestCacheMemoryHits);
+    } else {
+      auto pendingIt = this->_pendingWriteIndex.find(key);
+      if (pendingIt != this->_pendingWriteIndex.end()) {
+        pItem = pendingIt->second;
+        ++this->_pendingWriteHits;
+        INC_DWORD_STAT(STAT_CesiumRequestCachePendingWriteHits);
+      }
+    }
+  }
+
+  // Copy the item outside the lock; it is immutable once shared.
+  if (pItem) {
+    std::optional<CacheItem> result(*pItem);
+    this->recordLookup(startCycles);
+    return result;
+  }
+
+  std::optional<CacheItem> result = this->_pDiskCache->getEntry(key);
+  if (result) {
+    ++this->_diskHits;
+    INC_DWORD_STAT(STAT_CesiumRequestCacheDiskHits);
+
+    if (this->_maxMemoryBytes > 0) {
+      CacheItemPtr pPromoted = std::make_shared<const CacheItem>(*result);
+      const uint64_t size = computeSize(*pPromoted);
+
+      // A store of this key while the database was read may have put a
+      // newer version in memory or in the write queue, or may already have
+      // been written and evicted again.
+      std::scoped_lock<std::mutex> lock(this->_mutex);
+      if (this->_generation == generation &&
+          this->_memoryEntries.find(key) == this->_memoryEntries.end() &&
+          this->_pendingWriteIndex.find(key) ==
+              this->_pendingWriteIndex.end()) {
+        this->insertIntoMemoryTier(key, pPromoted, size);
+      }
+    }
+  } else {
+    ++this->_misses;
+    INC_DWORD_STAT(STAT_CesiumRequestCacheMisses);
+  }
+
+  this->recordLookup(startCycles);
+  return result;
+}
+
+bool CesiumTieredCacheDatabase::storeEntry(
+    const std::string& key,
+    std::time_t expiryTime,
+    const std::string& url,
+    const std::string& requestMethod,
+    const HttpHeaders& requestHeaders,
+    uint16_t statusCode,
+    const HttpHeaders& responseHeaders,
+    const gsl::span<const std::byte>& responseData) {
+  CacheItemPtr pItem = std::make_shared<const CacheItem>(
+      expiryTime,
+      CacheRequest(requestHeaders, requestMethod, url),
+      CacheResponse(
+          statusCode,
+          responseHeaders,
+          std::vector<std::byte>(responseData.begin(), responseData.end())));
+  const uint64_t size = computeSize(*pItem);
+
+  {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+
+    ++this->_generation;
+    this->insertIntoMemoryTier(key, pItem, size);
+
+    // An older version of this key that is still queued must not be written
+    // after this one, so a key that is already pending is always queued.
+    const bool alreadyPending =
+        this->_pendingWriteIndex.find(key) != this->_pendingWriteIndex.end();
+    if (!this->_stopWriter &&
+        (alreadyPending ||
+         this->_pendingWriteBytes + size <= this->_maxPendingWriteBytes)) {
+      this->_pendingWrites.push_back(PendingWrite{key, pItem, size});
+      this->_pendingWriteIndex[key] = pItem;
+      this->_pendingWriteBytes += size;
+      SET_DWORD_STAT(
+          STAT_CesiumRequestCachePendingWrites,
+          this->_pendingWrites.size());
+      this->_writerWakeUp.notify_one();
+      return true;
+    }
+  }
+
+  // The write-behind queue is full, so apply back pressure by writing on the
+  // calling thread. This is also the only way to write once the writer thread
+  // has stopped.
+  std::scoped_lock<std::mutex> diskLock(this->_diskMutex);
+  const bool stored = this->writeToDisk(key, *pItem);
+  ++this->_completedWrites;
+  return stored;
+}
+
+bool CesiumTieredCacheDatabase::prune() {
+  {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    if (!this->_stopWriter) {
+      this->_pruneRequested = true;
+      this->_writerWakeUp.notify_one();
+      return true;
+    }
+  }
+
+  std::scoped_lock<std::mutex> diskLock(this->_diskMutex);
+  return this->_pDiskCache->prune();
+}
+
+bool CesiumTieredCacheDatabase::clearAll() {
+  // Wait for an in-flight batch to finish so that it cannot re-populate the
+  // database after it is cleared.
+  std::scoped_lock<std::mutex> diskLock(this->_diskMutex);
+
+  {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+
+    ++this->_generation;
+    this->_lru.clear();
+    this->_memoryEntries.clear();
+    this->_memoryBytes = 0;
+    SET_MEMORY_STAT(STAT_CesiumRequestCacheMemoryBytes, 0);
+
+    for (const PendingWrite& write : this->_pendingWrites) {
+      this->_pendingWriteBytes -= write.size;
+    }
+    this->_pendingWrites.clear();
+    this->_pendingWriteIndex.clear();
+    this->_pruneRequested = false;
+    SET_DWORD_STAT(STAT_CesiumRequestCachePendingWrites, 0);
+  }
+
+  this->_writerIdle.notify_all();
+
+  return this->_pDiskCache->clearAll();
+}
+
+void CesiumTieredCacheDatabase::flush() {
+  std::unique_lock<std::mutex> lock(this->_mutex);
+  this->_writerIdle.wait(lock, [this]() {
+    return this->_pendingWrites.empty() && !this->_writeInProgress;
+  });
+}
+
+CesiumTieredCacheDatabase::Statistics
+CesiumTieredCacheDatabase::getStatistics() const {
+  Statistics result;
+  result.memoryHits = this->_memoryHits;
+  result.pendingWriteHits = this->_pendingWriteHits;
+  result.diskHits = this->_diskHits;
+  result.misses = this->_misses;
+  result.completedWrites = this->_completedWrites;
+  result.writeBatches = this->_writeBatches;
+
+  const uint64_t lookupCount = this->_lookupCount;
+  if (lookupCount > 0) {
+    result.averageLookupMicroseconds =
+        FPlatformTime::ToSeconds64(this->_lookupCycles) * 1000000.0 /
+        double(lookupCount);
+  }
+
+  std::scoped_lock<std::mutex> lock(this->_mutex);
+  result.memoryBytes = this->_memoryBytes;
+  result.memoryItems = this->_memoryEntries.size();
+  result.pendingWriteBytes = this->_pendingWriteBytes;
+  result.pendingWriteItems = this->_pendingWrites.size();
+  return result;
+}
+
+/*static*/ uint64_t
+CesiumTieredCacheDatabase::computeSize(const CacheItem& item) {
+  uint64_t size = sizeof(CacheItem) + item.cacheResponse.data.size() +
+                  item.cacheRequest.url.size() +
+                  item.cacheRequest.method.size();
+  for (const auto& header : item.cacheRequest.headers) {
+    size += header.first.size() + header.second.size();
+  }
+  for (const auto& header : item.cacheResponse.headers) {
+    size += header.first.size() + header.second.size();
+  }
+  return size;
+}
+
+void CesiumTieredCacheDatabase::insertIntoMemoryTier(
+    const std::string& key,
+    const CacheItemPtr& pItem,
+    uint64_t size) const {
+  auto it = this->_memoryEntries.find(key);
+  if (it != this->_memoryEntries.end()) {
+    this->_memoryBytes -= it->second.size;
+    this->_lru.erase(it->second.lruPosition);
+    this->_memoryEntries.erase(it);
+  }
+
+  // Don't let a single huge response flush the whole tier.
+  if (size > this->_maxMemoryBytes / 4) {
+    SET_MEMORY_STAT(STAT_CesiumRequestCacheMemoryBytes, this->_memoryBytes);
+    return;
+  }
+
+  this->_lru.push_front(key);
+  this->_memoryEntries.emplace(
+      key,
+      MemoryEntry{pItem, size, this->_lru.begin()});
+  this->_memoryBytes += size;
+
+  this->evictFromMemoryTier();
+}
+
+void CesiumTieredCacheDatabase::evictFromMemoryTier() const {
+  while (this->_memoryBytes > this->_maxMemoryBytes && !this->_lru.empty()) {
+    auto it = this->_memoryEntries.find(this->_lru.back());
+    this->_memoryBytes -= it->second.size;
+    this->_memoryEntries.erase(it);
+    this->_lru.pop_back();
+  }
+
+  SET_MEMORY_STAT(STAT_CesiumRequestCacheMemoryBytes, this->_memoryBytes);
+}
+
+bool CesiumTieredCacheDatabase::writeToDisk(
+    const std::string& key,
+    const CacheItem& item) {
+  return this->_pDiskCache->storeEntry(
+      key,
+      item.expiryTime,
+      item.cacheRequest.url,
+      item.cacheRequest.method,
+      item.cacheRequest.headers,
+      item.cacheResponse.statusCode,
+      item.cacheResponse.headers,
+      gsl::span<const std::byte>(item.cacheResponse.data));
+}
+
+void CesiumTieredCacheDatabase::writerThreadMain() {
+  std::vector<PendingWrite> batch;
+  batch.reserve(this->_writeBatchSize);
+
+  std::unique_lock<std::mutex> lock(this->_mutex);
+  while (true) {
+    this->_writerWakeUp.wait(lock, [this]() {
+      return this->_stopWriter || !this->_pendingWrites.empty() ||
+             this->_pruneRequested;
+    });
+
+    if (this->_pendingWrites.empty() && !this->_pruneRequested) {
+      // Only stop once everything queued has been written.
+      break;
+    }
+
+    while (!this->_pendingWrites.empty() &&
+           batch.size() < this->_writeBatchSize) {
+      batch.emplace_back(std::move(this->_pendingWrites.front()));
+      this->_pendingWrites.pop_front();
+    }
+
+    // Prune only after the queue has drained, so that entries that were
+    // just stored are not immediately pruned again.
+    const bool prune = this->_pruneRequested && this->_pendingWrites.empty();
+    if (prune) {
+      this->_pruneRequested = false;
+    }
+
+    this->_writeInProgress = true;
+    lock.unlock();
+
+    {
+      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::RequestCacheWriteBatch)
+      std::scoped_lock<std::mutex> diskLock(this->_diskMutex);
+      for (const PendingWrite& write : batch) {
+        this->writeToDisk(write.key, *write.pItem);
+      }
+      if (prune) {
+        TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::RequestCachePrune)
+        this->_pDiskCache->prune();
+      }
+    }
+
+    lock.lock();
+
+    for (const PendingWrite& write : batch) {
+      // clearAll may have dropped the index entry while the batch was being
+      // written, and a newer store may have replaced it.
+      auto it = this->_pendingWriteIndex.find(write.key);
+      if (it != this->_pendingWriteIndex.end() && it->second == write.pItem) {
+        this->_pendingWriteIndex.erase(it);
+      }
+      this->_pendingWriteBytes -= write.size;
+    }
+
+    if (!batch.empty()) {
+      this->_completedWrites += batch.size();
+      ++this->_writeBatches;
+    }
+    batch.clear();
+
+    this->_writeInProgress = false;
+    SET_DWORD_STAT(
+        STAT_CesiumRequestCachePendingWrites,
+        this->_pendingWrites.size());
+
+    if (this->_pendingWrites.empty()) {
+      this->_writerIdle.notify_all();
+    }
+  }
+
+  this->_writerIdle.notify_all();
+}
+
+void CesiumTieredCacheDatabase::recordLookup(uint64_t startCycles) const {
+  this->_lookupCycles += FPlatformTime::Cycles64() - startCycles;
+  ++this->_lookupCount;
+}
@@ -0,0 +1,185 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumAsync/CacheItem.h"
+#include "CesiumAsync/ICacheDatabase.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+/**
+ * @brief An {@link CesiumAsync::ICacheDatabase} that puts a byte-budgeted,
+ * in-memory LRU tier and an asynchronous write-behind queue in front of
+ * another (typically Sqlite-backed) cache database.
+ *
+ * Lookups are served from memory when possible, so re-entering a recently
+ * visited area does not touch the database at all. Stores are inserted into
+ * the memory tier immediately and written to the underlying database in
+ * batches by a dedicated writer thread, which also performs pruning. This
+ * keeps database I/O off of the worker threads that decode tiles.
+ */
+class CesiumTieredCacheDatabase : public CesiumAsync::ICacheDatabase {
+public:
+  /**
+   * @brief A snapshot of the cache counters.
+   */
+  struct Statistics {
+    uint64_t memoryHits = 0;
+    uint64_t pendingWriteHits = 0;
+    uint64_t diskHits = 0;
+    uint64_t misses = 0;
+    uint64_t memoryBytes = 0;
+    uint64_t memoryItems = 0;
+    uint64_t pendingWriteBytes = 0;
+    uint64_t pendingWriteItems = 0;
+    uint64_t completedWrites = 0;
+    uint64_t writeBatches = 0;
+    double averageLookupMicroseconds = 0.0;
+  };
+
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param pDiskCache The database to which entries are eventually written
+   * and from which memory-tier misses are loaded.
+   * @param maxMemoryBytes The byte budget of the in-memory tier. If zero, the
+   * memory tier is disabled.
+   * @param maxPendingWriteBytes The maximum number of bytes that may wait in
+   * the write-behind queue. Stores that would exceed it are written
+   * synchronously instead.
+   * @param writeBatchSize The maximum number of entries the writer thread
+   * hands to the underlying database in one batch.
+   */
+  CesiumTieredCacheDatabase(
+      const std::shared_ptr<CesiumAsync::ICacheDatabase>& pDiskCache,
+      uint64_t maxMemoryBytes,
+      uint64_t maxPendingWriteBytes,
+      uint32_t writeBatchSize);
+
+  /**
+   * @brief Writes all pending entries to the underlying database and stops
+   * the writer thread, if {@link flushAndStop} has not done so already.
+   */
+  virtual ~CesiumTieredCacheDatabase() noexcept;
+
+  virtual std::optional<CesiumAsync::CacheItem>
+  getEntry(const std::string& key) const override;
+
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const CesiumAsync::HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const CesiumAsync::HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override;
+
+  /**
+   * @brief Schedules a prune of the underlying database on the writer thread.
+   * The memory tier is pruned continuously against its byte budget.
+   */
+  virtual bool prune() override;
+
+  virtual bool clearAll() override;
+
+  /**
+   * @brief Blocks until every store queued so far has been written to the
+   * underlying database.
+   */
+  void flush();
+
+  /**
+   * @brief Writes all pending entries to the underlying database and stops
+   * the writer thread. Later stores are written on the calling thread.
+   *
+   * Call this while the engine is still running, such as when the module
+   * shuts down, rather than leaving it to the destructor of a static.
+   */
+  void flushAndStop();
+
+  /**
+   * @brief Gets a snapshot of the hit, miss, size, and latency counters.
+   */
+  Statistics getStatistics() const;
+
+private:
+  using CacheItemPtr = std::shared_ptr<const CesiumAsync::CacheItem>;
+
+  struct MemoryEntry {
+    CacheItemPtr pItem;
+    uint64_t size;
+    std::list<std::string>::iterator lruPosition;
+  };
+
+  struct PendingWrite {
+    std::string key;
+    CacheItemPtr pItem;
+    uint64_t size;
+  };
+
+  static uint64_t computeSize(const CesiumAsync::CacheItem& item);
+
+  void insertIntoMemoryTier(
+      const std::string& key,
+      const CacheItemPtr& pItem,
+      uint64_t size) const;
+  void evictFromMemoryTier() const;
+  bool writeToDisk(const std::string& key, const CesiumAsync::CacheItem& item);
+  void writerThreadMain();
+  void recordLookup(uint64_t startCycles) const;
+
+  std::shared_ptr<CesiumAsync::ICacheDatabase> _pDiskCache;
+  uint64_t _maxMemoryBytes;
+  uint64_t _maxPendingWriteBytes;
+  uint32_t _writeBatchSize;
+
+  // Guards the memory tier and the write-behind queue.
+  mutable std::mutex _mutex;
+  std::condition_variable _writerWakeUp;
+  std::condition_variable _writerIdle;
+
+  // The memory tier, with the most recently used key at the front of the
+  // list.
+  mutable std::list<std::string> _lru;
+  mutable std::unordered_map<std::string, MemoryEntry> _memoryEntries;
+  mutable uint64_t _memoryBytes;
+
+  // Entries that have not been written to the underlying database yet. The
+  // index maps a key to its most recent pending item so that lookups can be
+  // served from it even after the memory tier has evicted the entry.
+  std::deque<PendingWrite> _pendingWrites;
+  std::unordered_map<std::string, CacheItemPtr> _pendingWriteIndex;
+  uint64_t _pendingWriteBytes;
+  bool _pruneRequested;
+  bool _writeInProgress;
+  bool _stopWriter;
+
+  // Incremented by every store and clear. A lookup that read the underlying
+  // database only promotes the entry to the memory tier if nothing was
+  // stored or cleared in the meantime, as the entry may already be stale.
+  uint64_t _generation;
+
+  // Serializes access to the underlying database between the writer thread
+  // and clearAll.
+  std::mutex _diskMutex;
+
+  mutable std::atomic<uint64_t> _memoryHits;
+  mutable std::atomic<uint64_t> _pendingWriteHits;
+  mutable std::atomic<uint64_t> _diskHits;
+  mutable std::atomic<uint64_t> _misses;
+  mutable std::atomic<uint64_t> _lookupCount;
+  mutable std::atomic<uint64_t> _lookupCycles;
+  std::atomic<uint64_t> _completedWrites;
+  std::atomic<uint64_t> _writeBatches;
+
+  std::thread _writerThread;
+};
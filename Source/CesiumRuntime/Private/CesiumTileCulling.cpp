@@ -0,0 +1,93 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTileCulling.h"
+#include "Math/VectorRegister.h"
+
+void FCesiumTileBoundsBatch::Reset(int32 ExpectedNum) {
+  for (TArray<double>* pComponent :
+       {&CenterX, &CenterY, &CenterZ, &ExtentX, &ExtentY, &ExtentZ}) {
+    pComponent->Reset(ExpectedNum);
+  }
+}
+
+int32 FCesiumTileBoundsBatch::Add(const FBoxSphereBounds& Bounds) {
+  CenterX.Add(Bounds.Origin.X);
+  CenterY.Add(Bounds.Origin.Y);
+  CenterZ.Add(Bounds.Origin.Z);
+  ExtentX.Add(Bounds.BoxExtent.X);
+  ExtentY.Add(Bounds.BoxExtent.Y);
+  ExtentZ.Add(Bounds.BoxExtent.Z);
+  return CenterX.Num() - 1;
+}
+
+namespace CesiumTileCulling {
+
+namespace {
+
+// The number of tiles tested together in one vector register.
+constexpr int32 Lanes = 4;
+
+VectorRegister4Double splat(double value) {
+  return MakeVectorRegisterDouble(value, value, value, value);
+}
+
+void applyMask(int32 mask, int32 first, TArray<bool>& culled) {
+  for (int32 lane = 0; lane < Lanes; ++lane) {
+    if (mask & (1 << lane)) {
+      culled[first + lane] = true;
+    }
+  }
+}
+
+} // namespace
+
+void cullOutsideBox(
+    const FCesiumTileBoundsBatch& bounds,
+    const FBox& box,
+    TArray<bool>& culled) {
+  check(culled.Num() == bounds.Num());
+
+  const FVector center = box.GetCenter();
+  const FVector extent = box.GetExtent();
+  const int32 count = bounds.Num();
+
+  // Two boxes are disjoint if, along any axis, the distance between their
+  // centers exceeds the sum of their extents.
+  const VectorRegister4Double boxCenterX = splat(center.X);
+  const VectorRegister4Double boxCenterY = splat(center.Y);
+  const VectorRegister4Double boxCenterZ = splat(center.Z);
+  const VectorRegister4Double boxExtentX = splat(extent.X);
+  const VectorRegister4Double boxExtentY = splat(extent.Y);
+  const VectorRegister4Double boxExtentZ = splat(extent.Z);
+
+  int32 i = 0;
+  for (; i + Lanes <= count; i += Lanes) {
+    const VectorRegister4Double outsideX = VectorCompareGT(
+        VectorAbs(VectorSubtract(VectorLoad(&bounds.CenterX[i]), boxCenterX)),
+        VectorAdd(VectorLoad(&bounds.ExtentX[i]), boxExtentX));
+    const VectorRegister4Double outsideY = VectorCompareGT(
+        VectorAbs(VectorSubtract(VectorLoad(&bounds.CenterY[i]), boxCenterY)),
+        VectorAdd(VectorLoad(&bounds.ExtentY[i]), boxExtentY));
+    const VectorRegister4Double outsideZ = VectorCompareGT(
+        VectorAbs(VectorSubtract(VectorLoad(&bounds.CenterZ[i]), boxCenterZ)),
+        VectorAdd(VectorLoad(&bounds.ExtentZ[i]), boxExtentZ));
+    applyMask(
+        VectorMaskBits(
+            VectorBitwiseOr(VectorBitwiseOr(outsideX, outsideY), outsideZ)),
+        i,
+        culled);
+  }
+
+  for (; i < count; ++i) {
+    if (FMath::Abs(bounds.CenterX[i] - center.X) >
+            bounds.ExtentX[i] + extent.X ||
+        FMath::Abs(bounds.CenterY[i] - center.Y) >
+            bounds.ExtentY[i] + extent.Y ||
+        FMath::Abs(bounds.CenterZ[i] - center.Z) >
+            bounds.ExtentZ[i] + extent.Z) {
+      culled[i] = true;
+    }
+  }
+}
+
+} // namespace CesiumTileCulling
@@ -0,0 +1,32 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTilesetTransformComponent.h"
+#include "VecMath.h"
+
+UCesiumTilesetTransformComponent::UCesiumTilesetTransformComponent() {
+  PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UCesiumTilesetTransformComponent::UpdateTransformFromCesium(
+    const glm::dmat4& CesiumToUnrealTransform) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateTilesetTransform)
+
+  const FTransform transform =
+      FTransform(VecMath::createMatrix(CesiumToUnrealTransform));
+
+  // Moves the attached glTF components and their primitives the same way that
+  // UCesiumGltfPrimitiveComponent::UpdateTransformFromCesium moves a single
+  // primitive.
+  if (this->Mobility == EComponentMobility::Movable) {
+    this->SetRelativeTransform(
+        transform,
+        false,
+        nullptr,
+        ETeleportType::TeleportPhysics);
+  } else {
+    this->SetRelativeTransform_Direct(transform);
+    this->UpdateComponentToWorld(
+        EUpdateTransformFlags::None,
+        ETeleportType::ResetPhysics);
+  }
+}
@@ -0,0 +1,35 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Components/SceneComponent.h"
+#include "CoreMinimal.h"
+#include <glm/mat4x4.hpp>
+#include "CesiumTilesetTransformComponent.generated.h"
+
+/**
+ * A component whose relative transform is the transformation from the "Cesium
+ * Tileset" reference frame to the "Unreal Relative World" reference frame.
+ *
+ * When a tileset shares its transform, glTF components are attached to this
+ * component, and their primitives keep only their fixed, double-precision
+ * HighPrecisionNodeTransform. A georeference or origin change then only sets
+ * the transform of this component. Unreal still propagates it to every
+ * attached primitive, but without the per-primitive double-precision matrix
+ * products.
+ */
+UCLASS()
+class UCesiumTilesetTransformComponent : public USceneComponent {
+  GENERATED_BODY()
+
+public:
+  UCesiumTilesetTransformComponent();
+
+  /**
+   * Updates this component's transform from a new double-precision
+   * transformation from the Cesium world to the Unreal Engine world.
+   *
+   * @param CesiumToUnrealTransform The new transformation.
+   */
+  void UpdateTransformFromCesium(const glm::dmat4& CesiumToUnrealTransform);
+};
@@ -8,9 +8,34 @@
 #include "CesiumGltf/Model.h"
 #include "CesiumGltf/Node.h"
 #include "LoadGltfResult.h"
+#include "Templates/SharedPointer.h"
+#include <cstdint>
+#include <mutex>
+#include <vector>
 
 // TODO: internal documentation
 namespace CreateGltfOptions {
+/**
+ * The textures that have been loaded from one image of a model. Primitives
+ * that sample the same image with the same sampler and color space share a
+ * single texture, rather than each getting their own mipmaps and RHI texture.
+ */
+struct ImageTextureCache {
+  struct Entry {
+    int32_t sampler;
+    bool sRGB;
+    TWeakPtr<CesiumTextureUtility::LoadedTextureResult> pTexture;
+  };
+
+  /**
+   * Held while looking up or loading a texture from this image. Loading a
+   * texture may generate mipmaps in the image, and the primitives of a model
+   * are loaded in parallel.
+   */
+  std::mutex mutex;
+  std::vector<Entry> entries;
+};
+
 struct CreateModelOptions {
   /**
    * A pointer to the glTF model.
@@ -22,8 +47,19 @@ struct CreateModelOptions {
   const FMetadataDescription* pEncodedMetadataDescription_DEPRECATED = nullptr;
   PRAGMA_ENABLE_DEPRECATION_WARNINGS
   bool alwaysIncludeTangents = false;
+  bool weldGeneratedVertices = true;
   bool createPhysicsMeshes = true;
+  /**
+   * Whether to only keep the triangles of each primitive, so that its physics
+   * mesh can be built later, instead of building it while loading.
+   */
+  bool createPhysicsMeshesOnDemand = false;
   bool ignoreKhrMaterialsUnlit = false;
+
+  /**
+   * One texture cache per image of the model. Set by the model loader itself.
+   */
+  std::vector<ImageTextureCache>* pTextureCaches = nullptr;
 };
 
 struct CreateNodeOptions {
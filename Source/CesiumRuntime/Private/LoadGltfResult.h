@@ -8,6 +8,7 @@
 #include "CesiumGltf/Model.h"
 #include "CesiumMetadataPrimitive.h"
 #include "CesiumModelMetadata.h"
+#include "CesiumPhysicsMeshes.h"
 #include "CesiumPrimitiveFeatures.h"
 #include "CesiumPrimitiveMetadata.h"
 #include "CesiumRasterOverlays.h"
@@ -44,17 +45,30 @@ struct LoadPrimitiveResult {
    */
   const CesiumGltf::Material* pMaterial = nullptr;
   glm::dmat4x4 transform{1.0};
-  TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>
-      pCollisionMesh = nullptr;
+  /**
+   * The meshes to collide with, of which there are several if the primitive
+   * is large.
+   */
+  TArray<CesiumPhysicsMeshes::TriangleMeshPtr> collisionMeshes;
+  /**
+   * The triangles to build the collision mesh from later, when the tileset
+   * creates physics meshes on demand.
+   */
+  TSharedPtr<const CesiumPhysicsMeshes::TriangleSource, ESPMode::ThreadSafe>
+      pPhysicsMeshSource = nullptr;
   std::string name{};
 
-  TUniquePtr<CesiumTextureUtility::LoadedTextureResult> baseColorTexture;
-  TUniquePtr<CesiumTextureUtility::LoadedTextureResult>
+  /**
+   * The textures of the material. Primitives of the same model that sample
+   * the same image in the same way share a texture.
+   */
+  TSharedPtr<CesiumTextureUtility::LoadedTextureResult> baseColorTexture;
+  TSharedPtr<CesiumTextureUtility::LoadedTextureResult>
       metallicRoughnessTexture;
-  TUniquePtr<CesiumTextureUtility::LoadedTextureResult> normalTexture;
-  TUniquePtr<CesiumTextureUtility::LoadedTextureResult> emissiveTexture;
-  TUniquePtr<CesiumTextureUtility::LoadedTextureResult> occlusionTexture;
-  TUniquePtr<CesiumTextureUtility::LoadedTextureResult> waterMaskTexture;
+  TSharedPtr<CesiumTextureUtility::LoadedTextureResult> normalTexture;
+  TSharedPtr<CesiumTextureUtility::LoadedTextureResult> emissiveTexture;
+  TSharedPtr<CesiumTextureUtility::LoadedTextureResult> occlusionTexture;
+  TSharedPtr<CesiumTextureUtility::LoadedTextureResult> waterMaskTexture;
   std::unordered_map<std::string, uint32_t> textureCoordinateParameters;
   /**
    * A map of feature ID set names to their corresponding texture coordinate
@@ -0,0 +1,149 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "Cesium3tzSpecUtility.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "CesiumRuntime.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UnrealAssetAccessor.h"
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCesium3tzArchiveLoad,
+    "Cesium.Performance.3tzArchive.UnpackedVsPacked",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::PerfFilter)
+
+using namespace CesiumAsync;
+
+namespace {
+
+// Roughly the shape of a small photogrammetry tileset: many small tiles in a
+// deep directory tree.
+const int32 TileCount = 20000;
+const int32 RequestsPerFrame = 256;
+
+std::vector<std::pair<std::string, std::vector<std::byte>>> createTiles() {
+  std::vector<std::pair<std::string, std::vector<std::byte>>> tiles;
+  tiles.reserve(TileCount);
+  for (int32 i = 0; i < TileCount; ++i) {
+    std::string path = "tiles/" + std::to_string(i / 1000) + "/" +
+                       std::to_string(i / 100 % 10) + "/" + std::to_string(i) +
+                       ".glb";
+    std::vector<std::byte> content(size_t(4 * 1024 + (i * 7919) % (60 * 1024)));
+    for (size_t j = 0; j < content.size(); j += 64) {
+      content[j] = std::byte(i + j);
+    }
+    tiles.emplace_back(std::move(path), std::move(content));
+  }
+  return tiles;
+}
+
+struct LoadResult {
+  double seconds = 0.0;
+  uint64 bytes = 0;
+  int32 failures = 0;
+};
+
+LoadResult loadAll(
+    UnrealAssetAccessor& accessor,
+    const std::string& baseUri,
+    const std::vector<std::pair<std::string, std::vector<std::byte>>>& tiles) {
+  LoadResult result;
+  const double start = FPlatformTime::Seconds();
+
+  for (size_t first = 0; first < tiles.size(); first += RequestsPerFrame) {
+    const size_t last = std::min(first + RequestsPerFrame, tiles.size());
+    int32 remaining = int32(last - first);
+    for (size_t i = first; i < last; ++i) {
+      const size_t expectedSize = tiles[i].second.size();
+      accessor.get(getAsyncSystem(), baseUri + tiles[i].first, {})
+          .thenInMainThread(
+              [&remaining, &result, expectedSize](
+                  std::shared_ptr<IAssetRequest>&& pRequest) {
+                const IAssetResponse* pResponse = pRequest->response();
+                if (!pResponse || pResponse->statusCode() != 200 ||
+                    pResponse->data().size() != expectedSize) {
+                  ++result.failures;
+                } else {
+                  result.bytes += pResponse->data().size();
+                }
+                --remaining;
+              });
+    }
+
+    while (remaining > 0) {
+      accessor.tick();
+      getAsyncSystem().dispatchMainThreadTasks();
+    }
+  }
+
+  result.seconds = FPlatformTime::Seconds() - start;
+  return result;
+}
+
+std::string toFileUri(const FString& filename) {
+  FString uri = TEXT("file:///") + filename;
+  uri.ReplaceCharInline('\\', '/');
+  uri.ReplaceInline(TEXT(" "), TEXT("%20"));
+  return TCHAR_TO_UTF8(*uri);
+}
+
+} // namespace
+
+bool FCesium3tzArchiveLoad::RunTest(const FString& Parameters) {
+  const FString directory = FPaths::ConvertRelativePathToFull(
+      FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Cesium3tzBenchmark")));
+  const FString unpackedDirectory =
+      FPaths::Combine(directory, TEXT("unpacked"));
+  const FString archiveFilename =
+      FPaths::Combine(directory, TEXT("tileset.3tz"));
+  IFileManager::Get().DeleteDirectory(*directory, false, true);
+  IFileManager::Get().MakeDirectory(*unpackedDirectory, true);
+
+  const std::vector<std::pair<std::string, std::vector<std::byte>>> tiles =
+      createTiles();
+  for (const auto& [path, content] : tiles) {
+    FFileHelper::SaveArrayToFile(
+        TArrayView<const uint8>(
+            reinterpret_cast<const uint8*>(content.data()),
+            int32(content.size())),
+        *FPaths::Combine(unpackedDirectory, UTF8_TO_TCHAR(path.c_str())));
+  }
+  FFileHelper::SaveArrayToFile(Create3tzArchive(tiles), *archiveFilename);
+
+  auto run = [&](const FString& name,
+                 const std::string& baseUri,
+                 bool useMemoryMapping) {
+    UnrealAssetAccessor accessor{};
+    accessor.setUseMemoryMappedFiles(useMemoryMapping);
+    LoadResult result = loadAll(accessor, baseUri, tiles);
+
+    TestEqual(name + " failures", result.failures, 0);
+
+    UE_LOG(
+        LogCesium,
+        Display,
+        TEXT("%s: %d tiles, %.1f MB in %.3f secs, %.1f us per tile"),
+        *name,
+        TileCount,
+        double(result.bytes) / (1024.0 * 1024.0),
+        result.seconds,
+        result.seconds * 1000000.0 / TileCount);
+  };
+
+  run(TEXT("Unpacked"), toFileUri(unpackedDirectory) + "/", false);
+  run(TEXT("Unpacked, memory-mapped"),
+      toFileUri(unpackedDirectory) + "/",
+      true);
+  run(TEXT("Packed 3TZ"), toFileUri(archiveFilename) + "/", false);
+
+  IFileManager::Get().DeleteDirectory(*directory, false, true);
+
+  return true;
+}
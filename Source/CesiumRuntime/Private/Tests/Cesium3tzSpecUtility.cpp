@@ -0,0 +1,139 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "Cesium3tzSpecUtility.h"
+#include "Misc/Crc.h"
+#include "Misc/SecureHash.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace {
+
+template <typename T> void append(TArray64<uint8>& bytes, T value) {
+  const int64 offset = bytes.AddUninitialized(sizeof(T));
+  std::memcpy(bytes.GetData() + offset, &value, sizeof(T));
+}
+
+void appendBytes(TArray64<uint8>& bytes, const void* pData, size_t size) {
+  bytes.Append(reinterpret_cast<const uint8*>(pData), int64(size));
+}
+
+struct WrittenFile {
+  std::string path;
+  uint32 crc;
+  uint32 size;
+  uint32 localHeaderOffset;
+};
+
+WrittenFile appendLocalFile(
+    TArray64<uint8>& archive,
+    const std::string& path,
+    const void* pData,
+    size_t size) {
+  WrittenFile file{
+      path,
+      FCrc::MemCrc32(pData, int32(size)),
+      uint32(size),
+      uint32(archive.Num())};
+
+  append<uint32>(archive, 0x04034b50);
+  append<uint16>(archive, 20); // version needed to extract
+  append<uint16>(archive, 0);  // flags
+  append<uint16>(archive, 0);  // stored
+  append<uint16>(archive, 0);  // time
+  append<uint16>(archive, 0);  // date
+  append<uint32>(archive, file.crc);
+  append<uint32>(archive, file.size);
+  append<uint32>(archive, file.size);
+  append<uint16>(archive, uint16(path.size()));
+  append<uint16>(archive, 0); // extra field length
+  appendBytes(archive, path.data(), path.size());
+  appendBytes(archive, pData, size);
+
+  return file;
+}
+
+} // namespace
+
+TArray64<uint8> Create3tzArchive(
+    const std::vector<std::pair<std::string, std::vector<std::byte>>>& files,
+    bool includeIndex) {
+  TArray64<uint8> archive;
+  std::vector<WrittenFile> written;
+
+  for (const auto& [path, data] : files) {
+    written.emplace_back(
+        appendLocalFile(archive, path, data.data(), data.size()));
+  }
+
+  if (includeIndex) {
+    using Record = std::array<uint8, 24>;
+    std::vector<Record> records;
+    for (const WrittenFile& file : written) {
+      Record& record = records.emplace_back();
+      FMD5 md5;
+      md5.Update(
+          reinterpret_cast<const uint8*>(file.path.data()),
+          file.path.size());
+      md5.Final(record.data());
+      const uint64 offset = file.localHeaderOffset;
+      std::memcpy(record.data() + 16, &offset, sizeof(offset));
+    }
+
+    // Sorted by the second half of the hash, then the first, each read as a
+    // little-endian 64-bit integer.
+    std::sort(
+        records.begin(),
+        records.end(),
+        [](const Record& left, const Record& right) {
+          uint64 leftHalves[2];
+          uint64 rightHalves[2];
+          std::memcpy(leftHalves, left.data(), sizeof(leftHalves));
+          std::memcpy(rightHalves, right.data(), sizeof(rightHalves));
+          if (leftHalves[1] != rightHalves[1]) {
+            return leftHalves[1] < rightHalves[1];
+          }
+          return leftHalves[0] < rightHalves[0];
+        });
+
+    written.emplace_back(appendLocalFile(
+        archive,
+        "@3dtilesIndex1@",
+        records.data(),
+        records.size() * sizeof(Record)));
+  }
+
+  const uint32 directoryOffset = uint32(archive.Num());
+  for (const WrittenFile& file : written) {
+    append<uint32>(archive, 0x02014b50);
+    append<uint16>(archive, 20); // version made by
+    append<uint16>(archive, 20); // version needed to extract
+    append<uint16>(archive, 0);  // flags
+    append<uint16>(archive, 0);  // stored
+    append<uint16>(archive, 0);  // time
+    append<uint16>(archive, 0);  // date
+    append<uint32>(archive, file.crc);
+    append<uint32>(archive, file.size);
+    append<uint32>(archive, file.size);
+    append<uint16>(archive, uint16(file.path.size()));
+    append<uint16>(archive, 0); // extra field length
+    append<uint16>(archive, 0); // comment length
+    append<uint16>(archive, 0); // disk number
+    append<uint16>(archive, 0); // internal attributes
+    append<uint32>(archive, 0); // external attributes
+    append<uint32>(archive, file.localHeaderOffset);
+    appendBytes(archive, file.path.data(), file.path.size());
+  }
+  const uint32 directorySize = uint32(archive.Num()) - directoryOffset;
+
+  append<uint32>(archive, 0x06054b50);
+  append<uint16>(archive, 0); // disk number
+  append<uint16>(archive, 0); // disk with the central directory
+  append<uint16>(archive, uint16(written.size()));
+  append<uint16>(archive, uint16(written.size()));
+  append<uint32>(archive, directorySize);
+  append<uint32>(archive, directoryOffset);
+  append<uint16>(archive, 0); // comment length
+
+  return archive;
+}
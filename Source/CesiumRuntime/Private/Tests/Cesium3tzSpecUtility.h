@@ -0,0 +1,22 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Creates an uncompressed 3D Tiles archive (3TZ) holding the given
+ * files, keyed by their paths within the archive.
+ *
+ * @param files The paths and contents of the files.
+ * @param includeIndex Whether to write the `@3dtilesIndex1@` index. Without
+ * it, the result is a plain ZIP file.
+ * @returns The bytes of the archive.
+ */
+TArray64<uint8> Create3tzArchive(
+    const std::vector<std::pair<std::string, std::vector<std::byte>>>& files,
+    bool includeIndex = true);
@@ -0,0 +1,194 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumEncodedFeaturesMetadata.h"
+#include "CesiumEncodedMetadataConversions.h"
+#include "CesiumFeaturesMetadataComponent.h"
+#include "CesiumGltf/ExtensionModelExtStructuralMetadata.h"
+#include "CesiumGltf/Model.h"
+#include "CesiumGltfSpecUtility.h"
+#include "CesiumPropertyTable.h"
+#include "CesiumRuntime.h"
+#include "CesiumTextureUtility.h"
+#include "Misc/AutomationTest.h"
+#include "UnrealTaskProcessor.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCesiumEncodedMetadataPropertyTable,
+    "Cesium.Performance.EncodedMetadata.PropertyTable",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::PerfFilter)
+
+using namespace CesiumGltf;
+
+namespace {
+
+// Roughly a city-scale building tile with a few dozen encoded attributes.
+const int32 FeatureCount = 150000;
+const int32 PropertiesPerType = 8;
+
+template <typename T>
+void addProperty(
+    Model& model,
+    PropertyTable& propertyTable,
+    FCesiumPropertyTableDescription& description,
+    const std::string& name,
+    const std::string& type,
+    const std::string& componentType,
+    FCesiumMetadataPropertyDetails details,
+    T (*createValue)(int32)) {
+  std::vector<T> values(static_cast<size_t>(FeatureCount));
+  for (int32 i = 0; i < FeatureCount; ++i) {
+    values[size_t(i)] = createValue(i);
+  }
+  AddPropertyTablePropertyToModel(
+      model,
+      propertyTable,
+      name,
+      type,
+      componentType,
+      values);
+
+  FCesiumPropertyTablePropertyDescription& property =
+      description.Properties.Emplace_GetRef();
+  property.Name = UTF8_TO_TCHAR(name.c_str());
+  property.PropertyDetails = details;
+  property.EncodingDetails =
+      CesiumMetadataPropertyDetailsToEncodingDetails(details);
+}
+
+int32 createInt32(int32 i) { return i * 7919 - FeatureCount; }
+
+uint8_t createUint8(int32 i) { return uint8_t(i * 31); }
+
+glm::vec3 createVec3(int32 i) {
+  return glm::vec3(float(i), float(i) * 0.5f, float(i) * 0.25f);
+}
+
+} // namespace
+
+bool FCesiumEncodedMetadataPropertyTable::RunTest(const FString& Parameters) {
+  Model model;
+  ExtensionModelExtStructuralMetadata& metadata =
+      model.addExtension<ExtensionModelExtStructuralMetadata>();
+  metadata.schema.emplace();
+  PropertyTable& gltfPropertyTable = metadata.propertyTables.emplace_back();
+  gltfPropertyTable.classProperty = "building";
+  gltfPropertyTable.count = FeatureCount;
+
+  FCesiumPropertyTableDescription description;
+  description.Name = TEXT("buildings");
+  for (int32 i = 0; i < PropertiesPerType; ++i) {
+    const std::string suffix = std::to_string(i);
+    addProperty(
+        model,
+        gltfPropertyTable,
+        description,
+        "height" + suffix,
+        ClassProperty::Type::SCALAR,
+        ClassProperty::ComponentType::INT32,
+        FCesiumMetadataPropertyDetails(
+            ECesiumMetadataType::Scalar,
+            ECesiumMetadataComponentType::Int32,
+            false),
+        createInt32);
+    addProperty(
+        model,
+        gltfPropertyTable,
+        description,
+        "class" + suffix,
+        ClassProperty::Type::SCALAR,
+        ClassProperty::ComponentType::UINT8,
+        FCesiumMetadataPropertyDetails(
+            ECesiumMetadataType::Scalar,
+            ECesiumMetadataComponentType::Uint8,
+            false),
+        createUint8);
+    addProperty(
+        model,
+        gltfPropertyTable,
+        description,
+        "center" + suffix,
+        ClassProperty::Type::VEC3,
+        ClassProperty::ComponentType::FLOAT32,
+        FCesiumMetadataPropertyDetails(
+            ECesiumMetadataType::Vec3,
+            ECesiumMetadataComponentType::Float32,
+            false),
+        createVec3);
+  }
+
+  const FCesiumPropertyTable propertyTable(model, gltfPropertyTable);
+
+  double start = FPlatformTime::Seconds();
+  CesiumEncodedFeaturesMetadata::EncodedPropertyTable encoded =
+      CesiumEncodedFeaturesMetadata::encodePropertyTableAnyThreadPart(
+          description,
+          propertyTable);
+  const double encodeMilliseconds = (FPlatformTime::Seconds() - start) * 1000.0;
+
+  TestEqual(
+      "All properties encoded",
+      encoded.properties.Num(),
+      description.Properties.Num());
+
+  // Encode the same properties with the value-by-value encoder, one property
+  // after the other, into buffers of the same size as the textures. The
+  // results must be identical.
+  const TMap<FString, FCesiumPropertyTableProperty>& properties =
+      UCesiumPropertyTableBlueprintLibrary::GetProperties(propertyTable);
+  double byValueMilliseconds = 0.0;
+  for (const auto& encodedProperty : encoded.properties) {
+    const FCesiumPropertyTablePropertyDescription* pDescription =
+        description.Properties.FindByPredicate(
+            [&encodedProperty](
+                const FCesiumPropertyTablePropertyDescription& candidate) {
+              return candidate.Name == encodedProperty.name;
+            });
+    if (!TestNotNull("Description", pDescription) ||
+        !TestNotNull("Texture", encodedProperty.pTexture.Get())) {
+      continue;
+    }
+
+    FTexture2DMipMap& mip = encodedProperty.pTexture->pTextureData->Mips[0];
+    const int64 textureSize = mip.BulkData.GetBulkDataSize();
+    const size_t pixelSize = size_t(textureSize / (mip.SizeX * mip.SizeY));
+
+    start = FPlatformTime::Seconds();
+    TArray<uint8> byValue;
+    byValue.SetNumZeroed(int32(textureSize));
+    gsl::span<std::byte> byValueData(
+        reinterpret_cast<std::byte*>(byValue.GetData()),
+        size_t(byValue.Num()));
+    CesiumEncodedMetadataCoerce::encodeByValue(
+        *pDescription,
+        properties.FindChecked(pDescription->Name),
+        byValueData,
+        pixelSize);
+    byValueMilliseconds += (FPlatformTime::Seconds() - start) * 1000.0;
+
+    // The pixels after the last feature are not written.
+    const void* pEncoded = mip.BulkData.LockReadOnly();
+    TestTrue(
+        FString::Printf(TEXT("%s matches"), *pDescription->Name),
+        FMemory::Memcmp(
+            pEncoded,
+            byValue.GetData(),
+            size_t(FeatureCount) * pixelSize) == 0);
+    mip.BulkData.Unlock();
+  }
+
+  UE_LOG(
+      LogCesium,
+      Display,
+      TEXT(
+          "Encoded %d properties of %d features with %d worker threads: value by value %.1f ms, by column %.1f ms."),
+      description.Properties.Num(),
+      FeatureCount,
+      getTaskProcessor()->getThreadCount(),
+      byValueMilliseconds,
+      encodeMilliseconds);
+
+  return true;
+}
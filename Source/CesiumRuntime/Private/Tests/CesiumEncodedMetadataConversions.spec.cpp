@@ -0,0 +1,212 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumEncodedFeaturesMetadata.h"
+#include "CesiumEncodedMetadataConversions.h"
+#include "CesiumFeaturesMetadataComponent.h"
+#include "CesiumGltf/ExtensionModelExtStructuralMetadata.h"
+#include "CesiumGltf/Model.h"
+#include "CesiumGltfSpecUtility.h"
+#include "CesiumPropertyTable.h"
+#include "CesiumTextureUtility.h"
+#include "Misc/AutomationTest.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+using namespace CesiumGltf;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumEncodedMetadataConversionsSpec,
+    "Cesium.Unit.EncodedMetadataConversions",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+Model model;
+PropertyTable* pPropertyTable;
+FCesiumPropertyTableDescription description;
+
+template <typename T>
+void addProperty(
+    const std::string& name,
+    const std::string& type,
+    const std::string& componentType,
+    FCesiumMetadataPropertyDetails details,
+    const std::vector<T>& values) {
+  pPropertyTable->count = int64_t(values.size());
+  AddPropertyTablePropertyToModel(
+      model,
+      *pPropertyTable,
+      name,
+      type,
+      componentType,
+      values);
+
+  FCesiumPropertyTablePropertyDescription& property =
+      description.Properties.Emplace_GetRef();
+  property.Name = UTF8_TO_TCHAR(name.c_str());
+  property.PropertyDetails = details;
+  property.EncodingDetails =
+      CesiumMetadataPropertyDetailsToEncodingDetails(details);
+}
+
+/**
+ * Encodes the only property of the table with both the column encoder and the
+ * value-by-value encoder, and checks that they agree. The column encoder
+ * encodes the features in ranges of the given size.
+ */
+TArray<uint8> encodeProperty(size_t pixelSize, int64 featuresPerRange) {
+  const FCesiumPropertyTable propertyTable(model, *pPropertyTable);
+  const FCesiumPropertyTablePropertyDescription& propertyDescription =
+      description.Properties[0];
+  const FCesiumPropertyTableProperty& property =
+      UCesiumPropertyTableBlueprintLibrary::GetProperties(propertyTable)
+          .FindChecked(propertyDescription.Name);
+  const int64 count = pPropertyTable->count;
+
+  TArray<uint8> byColumn;
+  byColumn.SetNumZeroed(int32(size_t(count) * pixelSize));
+  gsl::span<std::byte> byColumnData(
+      reinterpret_cast<std::byte*>(byColumn.GetData()),
+      size_t(byColumn.Num()));
+  TArray<uint8> byValue = byColumn;
+  gsl::span<std::byte> byValueData(
+      reinterpret_cast<std::byte*>(byValue.GetData()),
+      size_t(byValue.Num()));
+
+  if (!TestTrue(
+          "can encode by feature range",
+          CesiumEncodedMetadataCoerce::canEncodeFeatureRanges(
+              propertyDescription,
+              property))) {
+    return byColumn;
+  }
+
+  for (int64 first = 0; first < count; first += featuresPerRange) {
+    CesiumEncodedMetadataCoerce::encodeFeatureRange(
+        propertyDescription,
+        property,
+        byColumnData,
+        pixelSize,
+        first,
+        FMath::Min(featuresPerRange, count - first));
+  }
+  CesiumEncodedMetadataCoerce::encodeByValue(
+      propertyDescription,
+      property,
+      byValueData,
+      pixelSize);
+
+  TestTrue("same as value by value", byColumn == byValue);
+  return byColumn;
+}
+END_DEFINE_SPEC(FCesiumEncodedMetadataConversionsSpec)
+
+void FCesiumEncodedMetadataConversionsSpec::Define() {
+  BeforeEach([this]() {
+    model = Model();
+    ExtensionModelExtStructuralMetadata& extension =
+        model.addExtension<ExtensionModelExtStructuralMetadata>();
+    extension.schema.emplace();
+    pPropertyTable = &extension.propertyTables.emplace_back();
+    pPropertyTable->classProperty = "testClass";
+    description = FCesiumPropertyTableDescription();
+  });
+
+  It("encodes uint8 scalars as bytes", [this]() {
+    const std::vector<uint8_t> values{0, 1, 42, 127, 128, 255};
+    addProperty(
+        "byte",
+        ClassProperty::Type::SCALAR,
+        ClassProperty::ComponentType::UINT8,
+        FCesiumMetadataPropertyDetails(
+            ECesiumMetadataType::Scalar,
+            ECesiumMetadataComponentType::Uint8,
+            false),
+        values);
+
+    TArray<uint8> encoded = encodeProperty(1, 4);
+    if (!TestEqual("size", encoded.Num(), int32(values.size()))) {
+      return;
+    }
+    for (int32 i = 0; i < encoded.Num(); ++i) {
+      TestEqual("value", int32(encoded[i]), int32(values[size_t(i)]));
+    }
+  });
+
+  It("encodes vec3 floats in reverse component order", [this]() {
+    const std::vector<glm::vec3> values{
+        glm::vec3(1.0f, 2.0f, 3.0f),
+        glm::vec3(-4.0f, 5.5f, 6.25f),
+        glm::vec3(7.0f, -8.0f, 9.0f)};
+    addProperty(
+        "position",
+        ClassProperty::Type::VEC3,
+        ClassProperty::ComponentType::FLOAT32,
+        FCesiumMetadataPropertyDetails(
+            ECesiumMetadataType::Vec3,
+            ECesiumMetadataComponentType::Float32,
+            false),
+        values);
+
+    // vec3s are stored in four-component float pixels, e.g. ABGR.
+    TArray<uint8> encoded = encodeProperty(4 * sizeof(float), 2);
+    if (!TestEqual(
+            "size",
+            encoded.Num(),
+            int32(values.size() * 4 * sizeof(float)))) {
+      return;
+    }
+    const float* pPixels = reinterpret_cast<const float*>(encoded.GetData());
+    for (size_t i = 0; i < values.size(); ++i) {
+      const float* pPixel = pPixels + 4 * i;
+      TestEqual("x", pPixel[3], values[i].x);
+      TestEqual("y", pPixel[2], values[i].y);
+      TestEqual("z", pPixel[1], values[i].z);
+      TestEqual("unused", pPixel[0], 0.0f);
+    }
+  });
+
+  It("encodes features on both sides of a task boundary", [this]() {
+    // encodePropertyTableAnyThreadPart encodes 16384 features per task.
+    const int64 featuresPerTask = 16384;
+    std::vector<int32_t> values(size_t(2 * featuresPerTask + 5));
+    for (size_t i = 0; i < values.size(); ++i) {
+      values[i] = int32_t(i) * 3 - 100;
+    }
+    addProperty(
+        "count",
+        ClassProperty::Type::SCALAR,
+        ClassProperty::ComponentType::INT32,
+        FCesiumMetadataPropertyDetails(
+            ECesiumMetadataType::Scalar,
+            ECesiumMetadataComponentType::Int32,
+            false),
+        values);
+
+    TArray<uint8> encoded = encodeProperty(sizeof(float), featuresPerTask);
+    const float* pValues = reinterpret_cast<const float*>(encoded.GetData());
+    for (int64 i : {int64(0),
+                    featuresPerTask - 1,
+                    featuresPerTask,
+                    featuresPerTask + 1,
+                    int64(values.size()) - 1}) {
+      TestEqual("value", pValues[i], float(values[size_t(i)]));
+    }
+
+    // The whole table, as the tileset encodes it.
+    const FCesiumPropertyTable propertyTable(model, *pPropertyTable);
+    CesiumEncodedFeaturesMetadata::EncodedPropertyTable table =
+        CesiumEncodedFeaturesMetadata::encodePropertyTableAnyThreadPart(
+            description,
+            propertyTable);
+    if (!TestEqual("properties", table.properties.Num(), 1) ||
+        !TestNotNull("texture", table.properties[0].pTexture.Get())) {
+      return;
+    }
+    FTexture2DMipMap& mip =
+        table.properties[0].pTexture->pTextureData->Mips[0];
+    const void* pTexture = mip.BulkData.LockReadOnly();
+    TestTrue(
+        "texture matches",
+        FMemory::Memcmp(pTexture, encoded.GetData(), encoded.Num()) == 0);
+    mip.BulkData.Unlock();
+  });
+}
@@ -5,6 +5,7 @@
 #include "CesiumTestHelpers.h"
 #include "CesiumUtility/Math.h"
 #include "GeoTransforms.h"
+#include "Math/RandomStream.h"
 #include "Misc/AutomationTest.h"
 
 using namespace CesiumGeospatial;
@@ -19,6 +20,26 @@ BEGIN_DEFINE_SPEC(
 TObjectPtr<ACesiumGeoreference> pGeoreferenceNullIsland;
 TObjectPtr<ACesiumGeoreference> pGeoreference90Longitude;
 
+// Not a multiple of the vector width, so that partial groups are tested too.
+const int32 BatchCount = 103;
+
+// More than the 8192 positions that CesiumBatchTransforms::forEachRange
+// converts on the calling thread, and not a multiple of them, so that the
+// parallel path and a partial last range are tested.
+const int32 ParallelBatchCount = 3 * 8192 + 5;
+
+TArray<FVector> CreateLongitudeLatitudeHeights(int32 count = BatchCount) {
+  FRandomStream random(42);
+  TArray<FVector> result;
+  for (int32 i = 0; i < count; ++i) {
+    result.Add(FVector(
+        random.FRandRange(-180.0, 180.0),
+        random.FRandRange(-90.0, 90.0),
+        random.FRandRange(-1000.0, 100000.0)));
+  }
+  return result;
+}
+
 END_DEFINE_SPEC(FCesiumGeoreferenceSpec)
 
 void FCesiumGeoreferenceSpec::Define() {
@@ -214,4 +235,206 @@ void FCesiumGeoreferenceSpec::Define() {
           rotationAt90DegreesLongitude);
     });
   });
+
+  Describe("Batched Transformation", [this]() {
+    It("transforms positions like the single-position functions", [this]() {
+      const TArray<FVector> llh = CreateLongitudeLatitudeHeights();
+      TArray<FVector> unreal;
+      TArray<FVector> ecef;
+      for (const FVector& position : llh) {
+        unreal.Add(
+            pGeoreferenceNullIsland
+                ->TransformLongitudeLatitudeHeightPositionToUnreal(position));
+        ecef.Add(pGeoreferenceNullIsland
+                     ->TransformUnrealPositionToEarthCenteredEarthFixed(
+                         unreal.Last()));
+      }
+
+      const TArray<FVector> batchedUnreal =
+          pGeoreferenceNullIsland
+              ->TransformLongitudeLatitudeHeightPositionsToUnreal(llh);
+      const TArray<FVector> batchedLlh =
+          pGeoreferenceNullIsland
+              ->TransformUnrealPositionsToLongitudeLatitudeHeight(unreal);
+      const TArray<FVector> batchedEcef =
+          pGeoreferenceNullIsland
+              ->TransformUnrealPositionsToEarthCenteredEarthFixed(unreal);
+      const TArray<FVector> batchedFromEcef =
+          pGeoreferenceNullIsland
+              ->TransformEarthCenteredEarthFixedPositionsToUnreal(ecef);
+
+      TestEqual("unreal count", batchedUnreal.Num(), BatchCount);
+      TestEqual("llh count", batchedLlh.Num(), BatchCount);
+      for (int32 i = 0; i < BatchCount; ++i) {
+        TestEqual(
+            FString::Printf(TEXT("unreal %d"), i),
+            batchedUnreal[i],
+            unreal[i],
+            1e-3);
+        TestEqual(
+            FString::Printf(TEXT("longitude %d"), i),
+            batchedLlh[i].X,
+            llh[i].X,
+            1e-9);
+        TestEqual(
+            FString::Printf(TEXT("latitude %d"), i),
+            batchedLlh[i].Y,
+            llh[i].Y,
+            1e-9);
+        TestEqual(
+            FString::Printf(TEXT("height %d"), i),
+            batchedLlh[i].Z,
+            llh[i].Z,
+            1e-4);
+        TestEqual(
+            FString::Printf(TEXT("ecef %d"), i),
+            batchedEcef[i],
+            ecef[i],
+            1e-5);
+        TestEqual(
+            FString::Printf(TEXT("from ecef %d"), i),
+            batchedFromEcef[i],
+            unreal[i],
+            1e-3);
+      }
+    });
+
+    It("transforms positions in place", [this]() {
+      const TArray<FVector> llh = CreateLongitudeLatitudeHeights();
+      TArray<FVector> positions = llh;
+      ACesiumGeoreference* pGeoreference = pGeoreferenceNullIsland;
+      pGeoreference->TransformLongitudeLatitudeHeightPositionsToUnreal(
+          positions,
+          positions);
+      pGeoreference->TransformUnrealPositionsToLongitudeLatitudeHeight(
+          positions,
+          positions);
+      for (int32 i = 0; i < BatchCount; ++i) {
+        TestEqual(
+            FString::Printf(TEXT("llh %d"), i),
+            positions[i],
+            llh[i],
+            1e-4);
+      }
+    });
+
+    It("transforms positions in parallel ranges", [this]() {
+      const TArray<FVector> llh =
+          CreateLongitudeLatitudeHeights(ParallelBatchCount);
+      const TArray<FVector> unreal =
+          pGeoreferenceNullIsland
+              ->TransformLongitudeLatitudeHeightPositionsToUnreal(llh);
+      TArray<FVector> positions = unreal;
+      pGeoreferenceNullIsland
+          ->TransformUnrealPositionsToLongitudeLatitudeHeight(
+              positions,
+              positions);
+
+      if (!TestEqual("unreal count", unreal.Num(), ParallelBatchCount)) {
+        return;
+      }
+
+      // Every range, including both sides of each range boundary.
+      TArray<int32> indices;
+      for (int32 i = 0; i < ParallelBatchCount; i += 97) {
+        indices.Add(i);
+      }
+      indices.Append({8191, 8192, 16383, 16384, ParallelBatchCount - 1});
+      for (int32 i : indices) {
+        TestEqual(
+            FString::Printf(TEXT("unreal %d"), i),
+            unreal[i],
+            pGeoreferenceNullIsland
+                ->TransformLongitudeLatitudeHeightPositionToUnreal(llh[i]),
+            1e-3);
+        TestEqual(
+            FString::Printf(TEXT("llh in place %d"), i),
+            positions[i],
+            llh[i],
+            1e-4);
+      }
+    });
+
+    It("transforms positions near the center of the Earth", [this]() {
+      const FVector center =
+          pGeoreferenceNullIsland
+              ->TransformEarthCenteredEarthFixedPositionToUnreal(
+                  FVector(0.0, 0.0, 0.0));
+      const TArray<FVector> unreal = {
+          center,
+          pGeoreferenceNullIsland
+              ->TransformLongitudeLatitudeHeightPositionToUnreal(
+                  FVector(10.0, 20.0, 30.0))};
+      const TArray<FVector> llh =
+          pGeoreferenceNullIsland
+              ->TransformUnrealPositionsToLongitudeLatitudeHeight(unreal);
+      TestEqual(
+          "center",
+          llh[0],
+          pGeoreferenceNullIsland
+              ->TransformUnrealPositionToLongitudeLatitudeHeight(center));
+      TestEqual("surface", llh[1], FVector(10.0, 20.0, 30.0), 1e-4);
+    });
+
+    It("transforms Rotators like the single-Rotator functions", [this]() {
+      const TArray<FVector> locations =
+          pGeoreferenceNullIsland
+              ->TransformLongitudeLatitudeHeightPositionsToUnreal(
+                  CreateLongitudeLatitudeHeights());
+      FRandomStream random(7);
+      TArray<FRotator> rotators;
+      for (int32 i = 0; i < BatchCount; ++i) {
+        rotators.Add(FRotator(
+            random.FRandRange(-90.0, 90.0),
+            random.FRandRange(-180.0, 180.0),
+            random.FRandRange(-180.0, 180.0)));
+      }
+
+      const TArray<FRotator> toUnreal =
+          pGeoreferenceNullIsland->TransformEastSouthUpRotatorsToUnreal(
+              rotators,
+              locations);
+      const TArray<FRotator> toEastSouthUp =
+          pGeoreferenceNullIsland->TransformUnrealRotatorsToEastSouthUp(
+              rotators,
+              locations);
+      for (int32 i = 0; i < BatchCount; ++i) {
+        const FQuat expectedToUnreal =
+            pGeoreferenceNullIsland
+                ->TransformEastSouthUpRotatorToUnreal(rotators[i], locations[i])
+                .Quaternion();
+        const FQuat expectedToEastSouthUp =
+            pGeoreferenceNullIsland
+                ->TransformUnrealRotatorToEastSouthUp(rotators[i], locations[i])
+                .Quaternion();
+        TestTrue(
+            FString::Printf(TEXT("to Unreal %d"), i),
+            toUnreal[i].Quaternion().AngularDistance(expectedToUnreal) < 1e-6);
+        TestTrue(
+            FString::Printf(TEXT("to East-South-Up %d"), i),
+            toEastSouthUp[i].Quaternion().AngularDistance(
+                expectedToEastSouthUp) < 1e-6);
+      }
+    });
+
+    It("returns nothing for Rotators and locations of different lengths",
+       [this]() {
+         TestEqual(
+             "to Unreal",
+             pGeoreferenceNullIsland
+                 ->TransformEastSouthUpRotatorsToUnreal(
+                     {FRotator(1.0, 2.0, 3.0)},
+                     {})
+                 .Num(),
+             0);
+         TestEqual(
+             "to East-South-Up",
+             pGeoreferenceNullIsland
+                 ->TransformUnrealRotatorsToEastSouthUp(
+                     {FRotator(1.0, 2.0, 3.0)},
+                     {})
+                 .Num(),
+             0);
+       });
+  });
 }
@@ -0,0 +1,149 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumGeoreference.h"
+#include "CesiumRuntime.h"
+#include "CesiumTestHelpers.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCesiumGeoreferenceBatchedTransforms,
+    "Cesium.Performance.Georeference.BatchedTransforms",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::PerfFilter)
+
+namespace {
+
+// Roughly a minute of GPS tracks and sensor points.
+const int32 PositionCount = 1000000;
+
+void logThroughput(
+    const TCHAR* name,
+    double scalarSeconds,
+    double batchedSeconds) {
+  UE_LOG(
+      LogCesium,
+      Display,
+      TEXT(
+          "%s of %d positions: one at a time %.1f ms (%.1f M/s), batched %.1f ms (%.1f M/s)."),
+      name,
+      PositionCount,
+      scalarSeconds * 1000.0,
+      PositionCount / scalarSeconds / 1.0e6,
+      batchedSeconds * 1000.0,
+      PositionCount / batchedSeconds / 1.0e6);
+}
+
+} // namespace
+
+bool FCesiumGeoreferenceBatchedTransforms::RunTest(const FString& Parameters) {
+  UWorld* pWorld = CesiumTestHelpers::getGlobalWorldContext();
+  ACesiumGeoreference* pGeoreference =
+      pWorld->SpawnActor<ACesiumGeoreference>();
+  pGeoreference->SetOriginLongitudeLatitudeHeight(
+      FVector(-105.25737, 39.736401, 2250.0));
+
+  // Tracks within a few degrees of the origin.
+  FRandomStream random(42);
+  TArray<FVector> llh;
+  TArray<FRotator> rotators;
+  llh.SetNumUninitialized(PositionCount);
+  rotators.SetNumUninitialized(PositionCount);
+  for (int32 i = 0; i < PositionCount; ++i) {
+    llh[i] = FVector(
+        -105.25737 + random.FRandRange(-2.0, 2.0),
+        39.736401 + random.FRandRange(-2.0, 2.0),
+        random.FRandRange(0.0, 10000.0));
+    rotators[i] = FRotator(
+        random.FRandRange(-90.0, 90.0),
+        random.FRandRange(-180.0, 180.0),
+        random.FRandRange(-180.0, 180.0));
+  }
+
+  TArray<FVector> scalarUnreal;
+  scalarUnreal.SetNumUninitialized(PositionCount);
+  double start = FPlatformTime::Seconds();
+  for (int32 i = 0; i < PositionCount; ++i) {
+    scalarUnreal[i] =
+        pGeoreference->TransformLongitudeLatitudeHeightPositionToUnreal(
+            llh[i]);
+  }
+  double scalarSeconds = FPlatformTime::Seconds() - start;
+
+  TArray<FVector> unreal;
+  unreal.SetNumUninitialized(PositionCount);
+  start = FPlatformTime::Seconds();
+  pGeoreference->TransformLongitudeLatitudeHeightPositionsToUnreal(llh, unreal);
+  double batchedSeconds = FPlatformTime::Seconds() - start;
+  logThroughput(
+      TEXT("Longitude-latitude-height to Unreal"),
+      scalarSeconds,
+      batchedSeconds);
+
+  TArray<FVector> scalarLlh;
+  scalarLlh.SetNumUninitialized(PositionCount);
+  start = FPlatformTime::Seconds();
+  for (int32 i = 0; i < PositionCount; ++i) {
+    scalarLlh[i] =
+        pGeoreference->TransformUnrealPositionToLongitudeLatitudeHeight(
+            unreal[i]);
+  }
+  scalarSeconds = FPlatformTime::Seconds() - start;
+
+  TArray<FVector> batchedLlh;
+  batchedLlh.SetNumUninitialized(PositionCount);
+  start = FPlatformTime::Seconds();
+  pGeoreference->TransformUnrealPositionsToLongitudeLatitudeHeight(
+      unreal,
+      batchedLlh);
+  batchedSeconds = FPlatformTime::Seconds() - start;
+  logThroughput(
+      TEXT("Unreal to longitude-latitude-height"),
+      scalarSeconds,
+      batchedSeconds);
+
+  TArray<FRotator> scalarRotators;
+  scalarRotators.SetNumUninitialized(PositionCount);
+  start = FPlatformTime::Seconds();
+  for (int32 i = 0; i < PositionCount; ++i) {
+    scalarRotators[i] = pGeoreference->TransformEastSouthUpRotatorToUnreal(
+        rotators[i],
+        unreal[i]);
+  }
+  scalarSeconds = FPlatformTime::Seconds() - start;
+
+  TArray<FRotator> batchedRotators;
+  batchedRotators.SetNumUninitialized(PositionCount);
+  start = FPlatformTime::Seconds();
+  pGeoreference->TransformEastSouthUpRotatorsToUnreal(
+      rotators,
+      unreal,
+      batchedRotators);
+  batchedSeconds = FPlatformTime::Seconds() - start;
+  logThroughput(
+      TEXT("East-South-Up Rotators to Unreal"),
+      scalarSeconds,
+      batchedSeconds);
+
+  // Both ways must give the same results.
+  for (int32 i = 0; i < PositionCount; i += 9973) {
+    TestEqual(
+        FString::Printf(TEXT("Unreal position %d"), i),
+        unreal[i],
+        scalarUnreal[i],
+        1e-3);
+    TestEqual(
+        FString::Printf(TEXT("Longitude-latitude-height %d"), i),
+        batchedLlh[i],
+        scalarLlh[i],
+        1e-4);
+    TestTrue(
+        FString::Printf(TEXT("Rotator %d"), i),
+        batchedRotators[i].Quaternion().AngularDistance(
+            scalarRotators[i].Quaternion()) < 1e-6);
+  }
+
+  pGeoreference->Destroy();
+
+  return true;
+}
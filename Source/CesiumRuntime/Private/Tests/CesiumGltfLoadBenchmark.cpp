@@ -0,0 +1,234 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumGltf/Material.h"
+#include "CesiumGltf/Model.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumGltfSpecUtility.h"
+#include "CesiumRuntime.h"
+#include "CreateGltfOptions.h"
+#include "Misc/AutomationTest.h"
+#include "UnrealTaskProcessor.h"
+#include <atomic>
+#include <glm/glm.hpp>
+#include <vector>
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCesiumGltfLoadParallelPrimitives,
+    "Cesium.Performance.GltfComponent.ParallelPrimitives",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::PerfFilter)
+
+using namespace CesiumGltf;
+
+namespace {
+
+// Roughly a photogrammetry tile split by material: each primitive is a
+// textured grid with its own image.
+const int32 PrimitiveCount = 64;
+const int32 GridSize = 64;
+const int32 ImageSize = 256;
+
+void addTexturedGrid(Model& model, Mesh& mesh, int32 primitiveIndex) {
+  std::vector<glm::vec3> positions;
+  std::vector<glm::vec3> normals;
+  std::vector<glm::vec2> texCoords;
+  positions.reserve(size_t(GridSize * GridSize));
+  normals.reserve(size_t(GridSize * GridSize));
+  texCoords.reserve(size_t(GridSize * GridSize));
+  for (int32 y = 0; y < GridSize; ++y) {
+    for (int32 x = 0; x < GridSize; ++x) {
+      const float u = float(x) / float(GridSize - 1);
+      const float v = float(y) / float(GridSize - 1);
+      positions.emplace_back(
+          float(primitiveIndex) + u,
+          v,
+          0.1f * glm::sin(10.0f * u) * glm::cos(10.0f * v));
+      normals.emplace_back(0.0f, 0.0f, 1.0f);
+      texCoords.emplace_back(u, v);
+    }
+  }
+
+  std::vector<uint32_t> indices;
+  indices.reserve(size_t((GridSize - 1) * (GridSize - 1) * 6));
+  for (int32 y = 0; y < GridSize - 1; ++y) {
+    for (int32 x = 0; x < GridSize - 1; ++x) {
+      const uint32_t i = uint32_t(y * GridSize + x);
+      indices.insert(
+          indices.end(),
+          {i, i + 1, i + GridSize, i + 1, i + GridSize + 1, i + GridSize});
+    }
+  }
+
+  MeshPrimitive& primitive = mesh.primitives.emplace_back();
+  CreateAttributeForPrimitive(
+      model,
+      primitive,
+      "POSITION",
+      AccessorSpec::Type::VEC3,
+      AccessorSpec::ComponentType::FLOAT,
+      positions);
+  model.accessors[primitive.attributes["POSITION"]].min = {
+      double(primitiveIndex),
+      0.0,
+      -0.1};
+  model.accessors[primitive.attributes["POSITION"]].max = {
+      double(primitiveIndex + 1),
+      1.0,
+      0.1};
+  CreateAttributeForPrimitive(
+      model,
+      primitive,
+      "NORMAL",
+      AccessorSpec::Type::VEC3,
+      AccessorSpec::ComponentType::FLOAT,
+      normals);
+  CreateAttributeForPrimitive(
+      model,
+      primitive,
+      "TEXCOORD_0",
+      AccessorSpec::Type::VEC2,
+      AccessorSpec::ComponentType::FLOAT,
+      texCoords);
+  CreateIndicesForPrimitive(
+      model,
+      primitive,
+      AccessorSpec::ComponentType::UNSIGNED_INT,
+      indices);
+
+  Image& image = model.images.emplace_back();
+  image.cesium.width = ImageSize;
+  image.cesium.height = ImageSize;
+  image.cesium.channels = 4;
+  image.cesium.bytesPerChannel = 1;
+  image.cesium.pixelData.resize(size_t(ImageSize * ImageSize * 4));
+  for (size_t i = 0; i < image.cesium.pixelData.size(); ++i) {
+    image.cesium.pixelData[i] = std::byte(i * 31 + size_t(primitiveIndex));
+  }
+
+  model.samplers.emplace_back();
+
+  Texture& texture = model.textures.emplace_back();
+  texture.sampler = int32_t(model.samplers.size() - 1);
+  texture.source = int32_t(model.images.size() - 1);
+
+  Material& material = model.materials.emplace_back();
+  material.pbrMetallicRoughness.emplace().baseColorTexture.emplace().index =
+      int32_t(model.textures.size() - 1);
+  primitive.material = int32_t(model.materials.size() - 1);
+}
+
+Model createModel(int32 firstPrimitive, int32 primitiveCount) {
+  Model model;
+  Mesh& mesh = model.meshes.emplace_back();
+  for (int32 i = 0; i < primitiveCount; ++i) {
+    addTexturedGrid(model, mesh, firstPrimitive + i);
+  }
+
+  Node& node = model.nodes.emplace_back();
+  node.mesh = 0;
+  model.scenes.emplace_back().nodes.push_back(0);
+  model.scene = 0;
+  return model;
+}
+
+/**
+ * Loads the models off the game thread and returns the elapsed time. The
+ * half-constructed results are freed after the clock stops, which also frees
+ * the textures and render data that the game-thread part would have taken
+ * over.
+ */
+double loadModels(std::vector<Model>& models) {
+  std::vector<TUniquePtr<UCesiumGltfComponent::HalfConstructed>> results;
+  results.reserve(models.size());
+
+  const double start = FPlatformTime::Seconds();
+  for (Model& model : models) {
+    CreateGltfOptions::CreateModelOptions options;
+    options.pModel = &model;
+    results.emplace_back(
+        UCesiumGltfComponent::CreateOffGameThread(glm::dmat4x4(1.0), options));
+  }
+  const double seconds = FPlatformTime::Seconds() - start;
+
+  results.clear();
+  return seconds;
+}
+
+/**
+ * Keeps all but `freeWorkers` of the worker threads busy for as long as it
+ * exists, so that a load only gets that many workers to help it.
+ */
+class ScopedBusyWorkers {
+public:
+  explicit ScopedBusyWorkers(int32 freeWorkers) : _release(false), _busy(0) {
+    const int32 busyWorkers =
+        getTaskProcessor()->getThreadCount() - freeWorkers;
+    UnrealTaskProcessor::ScopedLane lane(UnrealTaskProcessor::Lane::High);
+    for (int32 i = 0; i < busyWorkers; ++i) {
+      getTaskProcessor()->startTask([this]() {
+        ++this->_busy;
+        while (!this->_release.load()) {
+          FPlatformProcess::Sleep(0.0001f);
+        }
+        --this->_busy;
+      });
+    }
+    while (this->_busy.load() < busyWorkers) {
+      FPlatformProcess::Sleep(0.0001f);
+    }
+  }
+
+  ~ScopedBusyWorkers() {
+    this->_release = true;
+    while (this->_busy.load() > 0) {
+      FPlatformProcess::Sleep(0.0001f);
+    }
+  }
+
+private:
+  std::atomic<bool> _release;
+  std::atomic<int32> _busy;
+};
+
+} // namespace
+
+bool FCesiumGltfLoadParallelPrimitives::RunTest(const FString& Parameters) {
+  const int32 threadCount = getTaskProcessor()->getThreadCount();
+
+  // With no free workers, the primitives are loaded one after another on the
+  // calling thread, which is the sequential baseline.
+  std::vector<int32> freeWorkerCounts = {0};
+  if (threadCount > 2) {
+    freeWorkerCounts.push_back(threadCount / 2);
+  }
+  freeWorkerCounts.push_back(threadCount);
+
+  double sequentialSeconds = 0.0;
+  for (int32 freeWorkers : freeWorkerCounts) {
+    // Mip generation modifies the images, so every run gets a fresh model.
+    std::vector<Model> models;
+    models.emplace_back(createModel(0, PrimitiveCount));
+
+    double seconds;
+    {
+      ScopedBusyWorkers busyWorkers(freeWorkers);
+      seconds = loadModels(models);
+    }
+    if (freeWorkers == 0) {
+      sequentialSeconds = seconds;
+    }
+
+    UE_LOG(
+        LogCesium,
+        Display,
+        TEXT(
+            "Loaded %d primitives with %d of %d worker threads: %.1f ms, %.2fx speedup."),
+        PrimitiveCount,
+        freeWorkers,
+        threadCount,
+        seconds * 1000.0,
+        seconds > 0.0 ? sequentialSeconds / seconds : 0.0);
+  }
+
+  return true;
+}
@@ -6,9 +6,14 @@
 
 #include "Misc/AutomationTest.h"
 
+#include "Cesium3DTilesSelection/RasterMappedTo3DTile.h"
+#include "Cesium3DTilesSelection/RasterOverlay.h"
+#include "Cesium3DTilesSelection/RasterOverlayTile.h"
 #include "CesiumAsync/ICacheDatabase.h"
 #include "CesiumGltfComponent.h"
+#include "CesiumGltfPrimitiveComponent.h"
 #include "CesiumIonRasterOverlay.h"
+#include "CesiumMaterialUserData.h"
 #include "CesiumRuntime.h"
 #include "CesiumSunSky.h"
 #include "GlobeAwareDefaultPawn.h"
@@ -30,6 +35,11 @@ IMPLEMENT_SIMPLE_AUTOMATION_TEST(
     "Cesium.Performance.SampleTestPointCloud",
     EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCesiumSampleDeferredCreation,
+    "Cesium.Performance.SampleDeferredCreationWithOverlay",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(
     FSampleMaxTileLoads,
     "Cesium.Performance.SampleVaryMaxTileLoads",
@@ -218,6 +228,113 @@ bool FCesiumSampleMontrealPointCloud::RunTest(const FString& Parameters) {
       512);
 }
 
+bool FCesiumSampleDeferredCreation::RunTest(const FString& Parameters) {
+  auto setupForDeferredCreation = [](SceneGenerationContext& context) {
+    setupForDenver(context);
+
+    // Create one primitive per frame, so that most terrain tiles wait for
+    // their primitives while the overlay tiles are attached to them.
+    for (ACesium3DTileset* pTileset : context.tilesets) {
+      pTileset->MaximumTilesCreatedPerFrame = 1;
+      pTileset->MaximumPrimitivesCreatedPerFrame = 1;
+    }
+  };
+
+  auto verifyOverlays = [this](
+                            SceneGenerationContext& context,
+                            TestPass::TestingParameter parameter) {
+    Cesium3DTilesSelection::Tileset* pTileset =
+        context.tilesets[0]->GetTileset();
+    if (!TestNotNull("Tileset", pTileset)) {
+      return;
+    }
+
+    int32 overlaidPrimitives = 0;
+    int32 primitivesMissingOverlay = 0;
+    pTileset->forEachLoadedTile([&](Cesium3DTilesSelection::Tile& tile) {
+      if (tile.getState() != Cesium3DTilesSelection::TileLoadState::Done) {
+        return;
+      }
+      const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
+          tile.getContent().getRenderContent();
+      if (!pRenderContent) {
+        return;
+      }
+
+      UCesiumGltfComponent* Gltf = static_cast<UCesiumGltfComponent*>(
+          pRenderContent->getRenderResources());
+      if (!Gltf || !Gltf->IsVisible()) {
+        return;
+      }
+
+      TestTrue("Visible tile is complete", Gltf->IsCreationComplete());
+
+      for (const Cesium3DTilesSelection::RasterMappedTo3DTile& mapped :
+           tile.getMappedRasterTiles()) {
+        const Cesium3DTilesSelection::RasterOverlayTile* pRasterTile =
+            mapped.getReadyTile();
+        if (!pRasterTile ||
+            mapped.getState() != Cesium3DTilesSelection::RasterMappedTo3DTile::
+                                     AttachmentState::Attached) {
+          continue;
+        }
+
+        UTexture* pExpected =
+            static_cast<UTexture*>(pRasterTile->getRendererResources());
+        FString name(
+            UTF8_TO_TCHAR(pRasterTile->getOverlay().getName().c_str()));
+
+        for (USceneComponent* pChild : Gltf->GetAttachChildren()) {
+          UCesiumGltfPrimitiveComponent* pPrimitive =
+              Cast<UCesiumGltfPrimitiveComponent>(pChild);
+          UMaterialInstanceDynamic* pMaterial =
+              pPrimitive
+                  ? Cast<UMaterialInstanceDynamic>(pPrimitive->GetMaterial(0))
+                  : nullptr;
+          UMaterialInstance* pBase =
+              pMaterial ? Cast<UMaterialInstance>(pMaterial->Parent) : nullptr;
+          UCesiumMaterialUserData* pCesiumData =
+              pBase ? pBase->GetAssetUserData<UCesiumMaterialUserData>()
+                    : nullptr;
+          if (!pCesiumData) {
+            continue;
+          }
+
+          int32 layer = pCesiumData->LayerNames.Find(name);
+          if (layer == INDEX_NONE) {
+            continue;
+          }
+
+          UTexture* pTexture = nullptr;
+          pMaterial->GetTextureParameterValue(
+              FMaterialParameterInfo(
+                  "Texture",
+                  EMaterialParameterAssociation::LayerParameter,
+                  layer),
+              pTexture);
+          ++overlaidPrimitives;
+          if (pTexture != pExpected) {
+            ++primitivesMissingOverlay;
+          }
+        }
+      }
+    });
+
+    TestTrue("Primitives with an overlay", overlaidPrimitives > 0);
+    TestEqual("Primitives missing their overlay", primitivesMissingOverlay, 0);
+  };
+
+  std::vector<TestPass> testPasses;
+  testPasses.push_back(TestPass{"Cold Cache", nullptr, verifyOverlays});
+
+  return RunLoadTest(
+      GetBeautifiedTestName(),
+      setupForDeferredCreation,
+      testPasses,
+      1024,
+      768);
+}
+
 bool FSampleMaxTileLoads::RunTest(const FString& Parameters) {
 
   auto setupPass = [this](
@@ -0,0 +1,113 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumMaterialInstancePool.h"
+#include "CesiumRuntimeSettings.h"
+#include "Engine/Texture2D.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumMaterialInstancePoolSpec,
+    "Cesium.Unit.MaterialInstancePool",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+int32 maximumPooled;
+int32 maximumPooledPerMaterial;
+
+UMaterialInterface* getBaseMaterial() {
+  return UMaterial::GetDefaultMaterial(MD_Surface);
+}
+
+END_DEFINE_SPEC(FCesiumMaterialInstancePoolSpec)
+
+void FCesiumMaterialInstancePoolSpec::Define() {
+  BeforeEach([this]() {
+    CesiumMaterialInstancePool::clear();
+
+    const UCesiumRuntimeSettings* pSettings =
+        GetDefault<UCesiumRuntimeSettings>();
+    maximumPooled = pSettings->MaximumPooledMaterialInstances;
+    maximumPooledPerMaterial =
+        pSettings->MaximumPooledMaterialInstancesPerMaterial;
+  });
+
+  AfterEach([this]() {
+    CesiumMaterialInstancePool::clear();
+
+    UCesiumRuntimeSettings* pSettings =
+        GetMutableDefault<UCesiumRuntimeSettings>();
+    pSettings->MaximumPooledMaterialInstances = maximumPooled;
+    pSettings->MaximumPooledMaterialInstancesPerMaterial =
+        maximumPooledPerMaterial;
+  });
+
+  It("reuses released instances without their parameter values", [this]() {
+    UMaterialInstanceDynamic* pMaterial =
+        CesiumMaterialInstancePool::acquire(getBaseMaterial(), NAME_None);
+    pMaterial->SetScalarParameterValue(TEXT("opacityMask"), 0.5f);
+    pMaterial->SetTextureParameterValue(
+        TEXT("baseColorTexture"),
+        UTexture2D::CreateTransient(1, 1));
+
+    TestTrue("released", CesiumMaterialInstancePool::release(pMaterial));
+    TestTrue("rooted", pMaterial->IsRooted());
+    TestEqual("scalars", pMaterial->ScalarParameterValues.Num(), 0);
+    TestEqual("textures", pMaterial->TextureParameterValues.Num(), 0);
+
+    UMaterialInstanceDynamic* pReused =
+        CesiumMaterialInstancePool::acquire(getBaseMaterial(), NAME_None);
+    TestTrue("same instance", pReused == pMaterial);
+    TestFalse("rooted", pReused->IsRooted());
+    TestEqual("scalars", pReused->ScalarParameterValues.Num(), 0);
+    TestEqual("textures", pReused->TextureParameterValues.Num(), 0);
+  });
+
+  It("pools no more instances than the limit", [this]() {
+    GetMutableDefault<UCesiumRuntimeSettings>()
+        ->MaximumPooledMaterialInstances = 2;
+
+    TArray<UMaterialInstanceDynamic*> materials;
+    for (int32 i = 0; i < 3; ++i) {
+      materials.Add(
+          CesiumMaterialInstancePool::acquire(getBaseMaterial(), NAME_None));
+    }
+
+    TestTrue("first", CesiumMaterialInstancePool::release(materials[0]));
+    TestTrue("second", CesiumMaterialInstancePool::release(materials[1]));
+    TestFalse("third", CesiumMaterialInstancePool::release(materials[2]));
+    TestFalse("third rooted", materials[2]->IsRooted());
+  });
+
+  It("pools no more instances per material than the limit", [this]() {
+    GetMutableDefault<UCesiumRuntimeSettings>()
+        ->MaximumPooledMaterialInstancesPerMaterial = 1;
+
+    UMaterialInstanceDynamic* pFirst =
+        CesiumMaterialInstancePool::acquire(getBaseMaterial(), NAME_None);
+    UMaterialInstanceDynamic* pSecond =
+        CesiumMaterialInstancePool::acquire(getBaseMaterial(), NAME_None);
+    UMaterialInstanceDynamic* pOther = CesiumMaterialInstancePool::acquire(
+        UMaterial::GetDefaultMaterial(MD_DeferredDecal),
+        NAME_None);
+
+    TestTrue("first", CesiumMaterialInstancePool::release(pFirst));
+    TestFalse("second", CesiumMaterialInstancePool::release(pSecond));
+    TestTrue("other material", CesiumMaterialInstancePool::release(pOther));
+  });
+
+  It("unroots the instances when cleared", [this]() {
+    UMaterialInstanceDynamic* pMaterial =
+        CesiumMaterialInstancePool::acquire(getBaseMaterial(), NAME_None);
+    TestTrue("released", CesiumMaterialInstancePool::release(pMaterial));
+    TestTrue("rooted", pMaterial->IsRooted());
+
+    CesiumMaterialInstancePool::clear();
+    TestFalse("rooted after clear", pMaterial->IsRooted());
+    TestTrue(
+        "new instance",
+        CesiumMaterialInstancePool::acquire(getBaseMaterial(), NAME_None) !=
+            pMaterial);
+  });
+}
@@ -0,0 +1,193 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumGeometry/Transforms.h"
+#include "CesiumGeoreference.h"
+#include "CesiumGeospatial/Ellipsoid.h"
+#include "CesiumGeospatial/GlobeTransforms.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumRuntime.h"
+#include "CesiumTestHelpers.h"
+#include "CesiumTilesetTransformComponent.h"
+#include "Misc/AutomationTest.h"
+#include "VecMath.h"
+#include <glm/gtc/matrix_transform.hpp>
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCesiumOriginShiftUpdate,
+    "Cesium.Performance.Tileset.OriginShift",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::PerfFilter)
+
+namespace {
+
+// Roughly the visible primitives of a dense city tileset.
+const int32 TileCount = 2000;
+const int32 PrimitivesPerTile = 8;
+const int32 Shifts = 50;
+
+// Flips the Y axis of a primitive's vertices back, as the glTF loader does.
+const glm::dmat4 yInvertMatrix(
+    glm::dvec4(1.0, 0.0, 0.0, 0.0),
+    glm::dvec4(0.0, -1.0, 0.0, 0.0),
+    glm::dvec4(0.0, 0.0, 1.0, 0.0),
+    glm::dvec4(0.0, 0.0, 0.0, 1.0));
+
+/**
+ * Creates the transform of a primitive of a tile at the given ECEF position,
+ * as the loader computes it for a city tile: the tile's east-north-up frame,
+ * the glTF Y-up to Z-up conversion, a node with a rotation about the up axis
+ * and an offset, and the loader's Y inversion.
+ */
+glm::dmat4 createNodeTransform(const glm::dvec3& tileEcef, int32 primitive) {
+  const glm::dmat4 enuToEcef =
+      CesiumGeospatial::GlobeTransforms::eastNorthUpToFixedFrame(
+          tileEcef,
+          CesiumGeospatial::Ellipsoid::WGS84);
+  const glm::dmat4 node = glm::rotate(
+      glm::translate(
+          glm::dmat4(1.0),
+          glm::dvec3(double(primitive) * 3.0, double(primitive), 0.0)),
+      glm::radians(double(primitive) * 40.0),
+      glm::dvec3(0.0, 1.0, 0.0));
+  return enuToEcef * CesiumGeometry::Transforms::Y_UP_TO_Z_UP * node *
+         yInvertMatrix;
+}
+
+AActor* createTiles(
+    UWorld* pWorld,
+    const FVector& originEcef,
+    const glm::dmat4& cesiumToUnreal,
+    bool sharedTransform) {
+  AActor* pActor = pWorld->SpawnActor<AActor>();
+  USceneComponent* pRoot = NewObject<USceneComponent>(pActor);
+  pRoot->SetMobility(EComponentMobility::Movable);
+  pActor->SetRootComponent(pRoot);
+  pRoot->RegisterComponent();
+
+  USceneComponent* pParent = pRoot;
+  if (sharedTransform) {
+    UCesiumTilesetTransformComponent* pTransform =
+        NewObject<UCesiumTilesetTransformComponent>(pActor);
+    pTransform->SetMobility(EComponentMobility::Movable);
+    pTransform->SetupAttachment(pRoot);
+    pTransform->RegisterComponent();
+    pTransform->UpdateTransformFromCesium(cesiumToUnreal);
+    pParent = pTransform;
+  }
+
+  const glm::dmat4 gltfTransform =
+      sharedTransform ? glm::dmat4(1.0) : cesiumToUnreal;
+  for (int32 i = 0; i < TileCount; ++i) {
+    UCesiumGltfComponent* pGltf = NewObject<UCesiumGltfComponent>(pActor);
+    pGltf->SetMobility(EComponentMobility::Movable);
+    pGltf->SetupAttachment(pParent);
+    pGltf->RegisterComponent();
+
+    // Tiles spread over a few kilometers, in ECEF meters.
+    const glm::dvec3 tileEcef =
+        VecMath::createVector3D(originEcef) +
+        glm::dvec3(double(i % 50) * 50.0, double(i / 50) * 50.0, 0.0);
+    for (int32 j = 0; j < PrimitivesPerTile; ++j) {
+      UCesiumGltfPrimitiveComponent* pPrimitive =
+          NewObject<UCesiumGltfPrimitiveComponent>(pGltf);
+      pPrimitive->SetMobility(EComponentMobility::Movable);
+      pPrimitive->HighPrecisionNodeTransform =
+          createNodeTransform(tileEcef, j);
+      pPrimitive->UpdateTransformFromCesium(gltfTransform);
+      pPrimitive->SetupAttachment(pGltf);
+      pPrimitive->RegisterComponent();
+    }
+  }
+
+  return pActor;
+}
+
+} // namespace
+
+bool FCesiumOriginShiftUpdate::RunTest(const FString& Parameters) {
+  UWorld* pWorld = CesiumTestHelpers::getGlobalWorldContext();
+  ACesiumGeoreference* pGeoreference =
+      pWorld->SpawnActor<ACesiumGeoreference>();
+  pGeoreference->SetOriginLongitudeLatitudeHeight(
+      FVector(-105.25737, 39.736401, 2250.0));
+  const FVector originEcef = pGeoreference->GetOriginEarthCenteredEarthFixed();
+
+  auto getCesiumToUnreal = [pGeoreference]() {
+    return VecMath::createMatrix4D(
+        pGeoreference->ComputeEarthCenteredEarthFixedToUnrealTransformation());
+  };
+
+  AActor* pPerPrimitive =
+      createTiles(pWorld, originEcef, getCesiumToUnreal(), false);
+  AActor* pShared = createTiles(pWorld, originEcef, getCesiumToUnreal(), true);
+
+  UCesiumTilesetTransformComponent* pTransform =
+      pShared->FindComponentByClass<UCesiumTilesetTransformComponent>();
+
+  double perPrimitiveSeconds = 0.0;
+  double sharedSeconds = 0.0;
+  for (int32 i = 0; i < Shifts; ++i) {
+    // Shift back and forth by a kilometer, as a flight would.
+    pGeoreference->SetOriginEarthCenteredEarthFixed(
+        originEcef + FVector(double(i % 2) * 1000.0, 0.0, 0.0));
+    const glm::dmat4 cesiumToUnreal = getCesiumToUnreal();
+
+    // This is what a tileset does without a shared transform.
+    double start = FPlatformTime::Seconds();
+    TArray<UCesiumGltfComponent*> gltfComponents;
+    pPerPrimitive->GetComponents<UCesiumGltfComponent>(gltfComponents);
+    for (UCesiumGltfComponent* pGltf : gltfComponents) {
+      pGltf->UpdateTransformFromCesium(cesiumToUnreal);
+    }
+    perPrimitiveSeconds += FPlatformTime::Seconds() - start;
+
+    start = FPlatformTime::Seconds();
+    pTransform->UpdateTransformFromCesium(cesiumToUnreal);
+    sharedSeconds += FPlatformTime::Seconds() - start;
+  }
+
+  UE_LOG(
+      LogCesium,
+      Display,
+      TEXT(
+          "Origin shift of %d primitives: per primitive %.3f ms, shared tileset transform %.3f ms."),
+      TileCount * PrimitivesPerTile,
+      perPrimitiveSeconds * 1000.0 / Shifts,
+      sharedSeconds * 1000.0 / Shifts);
+
+  // Both ways must put the primitives in the same place, with the same
+  // orientation and the same mirroring.
+  TArray<UCesiumGltfPrimitiveComponent*> perPrimitiveComponents;
+  pPerPrimitive->GetComponents<UCesiumGltfPrimitiveComponent>(
+      perPrimitiveComponents);
+  TArray<UCesiumGltfPrimitiveComponent*> sharedComponents;
+  pShared->GetComponents<UCesiumGltfPrimitiveComponent>(sharedComponents);
+  TestEqual(
+      "Primitive count",
+      perPrimitiveComponents.Num(),
+      sharedComponents.Num());
+  for (int32 i = 0;
+       i < FMath::Min(perPrimitiveComponents.Num(), sharedComponents.Num());
+       i += 97) {
+    const FTransform& perPrimitive =
+        perPrimitiveComponents[i]->GetComponentTransform();
+    const FTransform& shared = sharedComponents[i]->GetComponentTransform();
+    TestTrue(
+        FString::Printf(TEXT("Primitive %d location"), i),
+        perPrimitive.GetLocation().Equals(shared.GetLocation(), 0.01));
+    // A mirrored transform can be decomposed into different rotations and
+    // scales, so the orientation is compared as a matrix.
+    TestTrue(
+        FString::Printf(TEXT("Primitive %d orientation"), i),
+        perPrimitive.ToMatrixWithScale().Equals(
+            shared.ToMatrixWithScale(),
+            0.01));
+  }
+
+  pPerPrimitive->Destroy();
+  pShared->Destroy();
+  pGeoreference->Destroy();
+
+  return true;
+}
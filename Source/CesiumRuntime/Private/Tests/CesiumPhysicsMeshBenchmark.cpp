@@ -0,0 +1,211 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumPhysicsMeshes.h"
+#include "CesiumRuntime.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCesiumPhysicsMeshCook,
+    "Cesium.Performance.PhysicsMeshes.Cook",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::PerfFilter)
+
+namespace {
+
+const int32 Iterations = 10;
+
+/**
+ * @brief The triangles of a terrain tile, as a glTF would provide them.
+ */
+struct SourceTile {
+  const TCHAR* name;
+  TArray<FVector3f> positions;
+  TArray<uint32> indices;
+  // Whether the static mesh duplicates the vertices of every triangle, as it
+  // does to generate flat normals.
+  bool duplicated;
+};
+
+SourceTile createTile(const TCHAR* name, int32 size, bool duplicated) {
+  SourceTile tile{name, {}, {}, duplicated};
+  tile.positions.Reserve((size + 1) * (size + 1));
+  for (int32 y = 0; y <= size; ++y) {
+    for (int32 x = 0; x <= size; ++x) {
+      tile.positions.Add(FVector3f(
+          float(x),
+          float(y),
+          FMath::Sin(float(x) * 0.1f) * FMath::Cos(float(y) * 0.1f)));
+    }
+  }
+  tile.indices.Reserve(6 * size * size);
+  for (int32 y = 0; y < size; ++y) {
+    for (int32 x = 0; x < size; ++x) {
+      const uint32 corner = uint32(y * (size + 1) + x);
+      const uint32 above = corner + uint32(size + 1);
+      tile.indices.Append({corner, corner + 1, above + 1});
+      tile.indices.Append({corner, above + 1, above});
+    }
+  }
+  return tile;
+}
+
+using ParticleVecType = Chaos::FTriangleMeshImplicitObject::ParticleVecType;
+
+bool isTriangleDegenerate(
+    const ParticleVecType& a,
+    const ParticleVecType& b,
+    const ParticleVecType& c) {
+  ParticleVecType normal = ParticleVecType::CrossProduct(b - a, c - a);
+  return normal.SafeNormalize() < 1.e-8f;
+}
+
+// The previous cooker: positions are copied out of the static mesh, whose
+// vertices may be duplicated, each triangle is normalized to test whether it
+// is degenerate, and the face remap is copied into the mesh.
+template <typename TIndex>
+CesiumPhysicsMeshes::TriangleMeshPtr
+cookPreviously(
+    const TArray<FVector3f>& positions,
+    const TArray<uint32>& indices) {
+  Chaos::TParticles<Chaos::FRealSingle, 3> vertices;
+  vertices.AddParticles(positions.Num());
+  for (int32 i = 0; i < positions.Num(); ++i) {
+    vertices.X(i) = positions[i];
+  }
+
+  const int32 triangleCount = indices.Num() / 3;
+  TArray<Chaos::TVector<TIndex, 3>> triangles;
+  triangles.Reserve(triangleCount);
+  TArray<int32> faceRemap;
+  faceRemap.Reserve(triangleCount);
+  for (int32 i = 0; i < triangleCount; ++i) {
+    const int32 vIndex0 = indices[3 * i + 1];
+    const int32 vIndex1 = indices[3 * i];
+    const int32 vIndex2 = indices[3 * i + 2];
+    if (!isTriangleDegenerate(
+            vertices.X(vIndex0),
+            vertices.X(vIndex1),
+            vertices.X(vIndex2))) {
+      triangles.Add(Chaos::TVector<TIndex, 3>(
+          TIndex(vIndex0),
+          TIndex(vIndex1),
+          TIndex(vIndex2)));
+      faceRemap.Add(i);
+    }
+  }
+
+  TUniquePtr<TArray<int32>> pFaceRemap = MakeUnique<TArray<int32>>(faceRemap);
+  TArray<uint16> materials;
+  materials.SetNum(triangles.Num());
+
+  return MakeShared<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>(
+      MoveTemp(vertices),
+      MoveTemp(triangles),
+      MoveTemp(materials),
+      MoveTemp(pFaceRemap),
+      nullptr,
+      false);
+}
+
+struct Measurement {
+  double milliseconds = 0.0;
+  int64 retainedBytesPerTile = 0;
+  int32 triangleCount = 0;
+};
+
+// Cooks the tile several times, keeping every result, and measures the time
+// per cook and the memory each cooked tile holds on to once it is cooked. The
+// memory is that of the whole process, so it also counts the bounding volume
+// hierarchies, but not the temporary allocations made while cooking.
+template <typename TCook>
+Measurement measure(TCook&& cook) {
+  TArray<TArray<CesiumPhysicsMeshes::TriangleMeshPtr>> results;
+  results.Reserve(Iterations);
+
+  const uint64 usedBefore = FPlatformMemory::GetStats().UsedPhysical;
+  const double start = FPlatformTime::Seconds();
+  for (int32 i = 0; i < Iterations; ++i) {
+    results.Add(cook());
+  }
+  const double seconds = FPlatformTime::Seconds() - start;
+  const uint64 usedAfter = FPlatformMemory::GetStats().UsedPhysical;
+
+  Measurement result;
+  result.milliseconds = seconds * 1000.0 / double(Iterations);
+  result.retainedBytesPerTile =
+      (int64(usedAfter) - int64(usedBefore)) / int64(Iterations);
+  for (const CesiumPhysicsMeshes::TriangleMeshPtr& pMesh : results[0]) {
+    result.triangleCount += pMesh->Elements().GetNumTriangles();
+  }
+  return result;
+}
+
+} // namespace
+
+bool FCesiumPhysicsMeshCook::RunTest(const FString& Parameters) {
+  // Terrain tiles of typical and large sizes, with and without normals.
+  const SourceTile tiles[] = {
+      createTile(TEXT("Indexed, 8K triangles"), 64, false),
+      createTile(TEXT("Flat-shaded, 8K triangles"), 64, true),
+      createTile(TEXT("Indexed, 131K triangles"), 256, false),
+      createTile(TEXT("Flat-shaded, 131K triangles"), 256, true)};
+
+  for (const SourceTile& tile : tiles) {
+    // The previous cooker read the static mesh, in which flat-shaded tiles
+    // have three vertices per triangle.
+    TArray<FVector3f> meshPositions;
+    TArray<uint32> meshIndices;
+    if (tile.duplicated) {
+      meshPositions.SetNumUninitialized(tile.indices.Num());
+      meshIndices.SetNumUninitialized(tile.indices.Num());
+      for (int32 i = 0; i < tile.indices.Num(); ++i) {
+        meshPositions[i] = tile.positions[tile.indices[i]];
+        meshIndices[i] = uint32(i);
+      }
+    } else {
+      meshPositions = tile.positions;
+      meshIndices = tile.indices;
+    }
+
+    const Measurement previous = measure([&]() {
+      TArray<CesiumPhysicsMeshes::TriangleMeshPtr> meshes;
+      meshes.Add(
+          meshPositions.Num() < TNumericLimits<uint16>::Max()
+              ? cookPreviously<uint16>(meshPositions, meshIndices)
+              : cookPreviously<int32>(meshPositions, meshIndices));
+      return meshes;
+    });
+
+    const Measurement current = measure([&]() {
+      Chaos::TParticles<Chaos::FRealSingle, 3> vertices;
+      vertices.AddParticles(tile.positions.Num());
+      for (int32 i = 0; i < tile.positions.Num(); ++i) {
+        vertices.X(i) = tile.positions[i];
+      }
+      return CesiumPhysicsMeshes::buildTriangleMeshes(
+          MoveTemp(vertices),
+          tile.indices);
+    });
+
+    // Both cookers must leave out the same degenerate triangles for the
+    // comparison to be fair.
+    TestEqual(
+        FString::Printf(TEXT("%s triangles"), tile.name),
+        current.triangleCount,
+        previous.triangleCount);
+
+    UE_LOG(
+        LogCesium,
+        Display,
+        TEXT(
+            "%s: previous cooker %.2f ms and %lld bytes retained per tile, current cooker %.2f ms and %lld bytes retained per tile."),
+        tile.name,
+        previous.milliseconds,
+        previous.retainedBytesPerTile,
+        current.milliseconds,
+        current.retainedBytesPerTile);
+  }
+
+  return true;
+}
@@ -0,0 +1,201 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumPhysicsMeshCache.h"
+#include "Cesium3DTileset.h"
+#include "CesiumCollisionInterestComponent.h"
+#include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumRuntime.h"
+#include "CesiumTestHelpers.h"
+#include "CesiumTilesetTransformComponent.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumPhysicsMeshCacheSpec,
+    "Cesium.Unit.PhysicsMeshCache",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+TObjectPtr<AActor> pActor;
+TSharedPtr<FCesiumPhysicsMeshCache, ESPMode::ThreadSafe> pCache;
+TArray<UCesiumGltfPrimitiveComponent*> primitives;
+
+/**
+ * Creates a primitive with a single-triangle physics mesh source, whose
+ * bounds are centered the given distance along +X from the interest volume.
+ */
+UCesiumGltfPrimitiveComponent* createPrimitive(double distance) {
+  UCesiumGltfPrimitiveComponent* pPrimitive =
+      NewObject<UCesiumGltfPrimitiveComponent>();
+  CesiumPhysicsMeshes::TriangleSource source;
+  source.positions = {
+      FVector3f(0.0f, 0.0f, 0.0f),
+      FVector3f(1.0f, 0.0f, 0.0f),
+      FVector3f(0.0f, 1.0f, 0.0f)};
+  source.indices = {0, 1, 2};
+  pPrimitive->pPhysicsMeshSource =
+      MakeShared<CesiumPhysicsMeshes::TriangleSource, ESPMode::ThreadSafe>(
+          MoveTemp(source));
+  moveTo(pPrimitive, distance);
+  return pPrimitive;
+}
+
+void moveTo(UCesiumGltfPrimitiveComponent* pPrimitive, double distance) {
+  pPrimitive->Bounds =
+      FBoxSphereBounds(FVector(distance, 0.0, 0.0), FVector(1.0), 1.0);
+}
+
+void update(int32 maximumBuildsPerFrame, int32 maximumCachedMeshes) {
+  pCache->update(
+      CesiumTestHelpers::getGlobalWorldContext(),
+      primitives,
+      maximumBuildsPerFrame,
+      maximumCachedMeshes);
+}
+
+void waitForBuilds() {
+  while (pCache->getBuildingMeshCount() > 0) {
+    getAsyncSystem().dispatchMainThreadTasks();
+  }
+}
+
+END_DEFINE_SPEC(FCesiumPhysicsMeshCacheSpec)
+
+void FCesiumPhysicsMeshCacheSpec::Define() {
+  BeforeEach([this]() {
+    UWorld* pWorld = CesiumTestHelpers::getGlobalWorldContext();
+    pActor = pWorld->SpawnActor<AActor>();
+    UCesiumCollisionInterestComponent* pInterest =
+        Cast<UCesiumCollisionInterestComponent>(pActor->AddComponentByClass(
+            UCesiumCollisionInterestComponent::StaticClass(),
+            false,
+            FTransform::Identity,
+            false));
+    pInterest->Radius = 10000.0;
+
+    pCache = MakeShared<FCesiumPhysicsMeshCache, ESPMode::ThreadSafe>();
+    primitives.Reset();
+    for (double distance : {400.0, 100.0, 300.0, 200.0}) {
+      primitives.Add(createPrimitive(distance));
+    }
+  });
+
+  AfterEach([this]() {
+    pCache->reset();
+    pCache.Reset();
+    primitives.Reset();
+    pActor->Destroy();
+    pActor = nullptr;
+  });
+
+  It("builds the closest meshes first within the budget", [this]() {
+    update(2, 0);
+    bool building = false;
+    TestTrue("closest", pCache->isCached(primitives[1], &building));
+    TestTrue("closest is building", building);
+    TestTrue("second closest", pCache->isCached(primitives[3]));
+    TestFalse("third closest", pCache->isCached(primitives[2]));
+    TestFalse("farthest", pCache->isCached(primitives[0]));
+
+    waitForBuilds();
+    TestEqual("built", pCache->getCachedMeshCount(), 2);
+    TestTrue("closest", pCache->isCached(primitives[1], &building));
+    TestFalse("closest is built", building);
+
+    update(2, 0);
+    TestTrue("third closest", pCache->isCached(primitives[2]));
+    TestTrue("farthest", pCache->isCached(primitives[0]));
+    waitForBuilds();
+    TestEqual("built", pCache->getCachedMeshCount(), 4);
+  });
+
+  It("ignores primitives outside of the interest volumes", [this]() {
+    moveTo(primitives[0], 1.0e6);
+    update(0, 0);
+    waitForBuilds();
+    TestEqual("built", pCache->getCachedMeshCount(), 3);
+    TestFalse("outside", pCache->isCached(primitives[0]));
+  });
+
+  It("evicts the meshes that were needed least recently", [this]() {
+    update(0, 0);
+    waitForBuilds();
+    TestEqual("built", pCache->getCachedMeshCount(), 4);
+
+    moveTo(primitives[0], 1.0e6);
+    update(0, 0);
+    moveTo(primitives[2], 1.0e6);
+    update(0, 2);
+
+    TestEqual("kept", pCache->getCachedMeshCount(), 2);
+    TestFalse("needed longest ago", pCache->isCached(primitives[0]));
+    TestFalse("needed last frame", pCache->isCached(primitives[2]));
+    TestTrue("needed", pCache->isCached(primitives[1]));
+    TestTrue("needed", pCache->isCached(primitives[3]));
+  });
+
+  It("evicts only as many meshes as needed", [this]() {
+    update(0, 0);
+    waitForBuilds();
+
+    moveTo(primitives[0], 1.0e6);
+    update(0, 0);
+    moveTo(primitives[2], 1.0e6);
+    update(0, 3);
+
+    TestEqual("kept", pCache->getCachedMeshCount(), 3);
+    TestFalse("needed longest ago", pCache->isCached(primitives[0]));
+    TestTrue("needed last frame", pCache->isCached(primitives[2]));
+  });
+
+  It("never evicts meshes needed in this frame", [this]() {
+    update(0, 0);
+    waitForBuilds();
+
+    update(0, 1);
+    TestEqual("kept", pCache->getCachedMeshCount(), 4);
+    for (UCesiumGltfPrimitiveComponent* pPrimitive : primitives) {
+      TestTrue("needed", pCache->isCached(pPrimitive));
+    }
+  });
+
+  It("ignores the meshes built before a reset", [this]() {
+    update(0, 0);
+    pCache->reset();
+    TestEqual("cached after reset", pCache->getCachedMeshCount(), 0);
+    TestEqual("building after reset", pCache->getBuildingMeshCount(), 0);
+
+    // The builds started before the reset still complete, but must not be
+    // kept. They are not tracked anymore, so give them time to finish.
+    const double end = FPlatformTime::Seconds() + 1.0;
+    while (FPlatformTime::Seconds() < end) {
+      getAsyncSystem().dispatchMainThreadTasks();
+    }
+    TestEqual("cached after builds", pCache->getCachedMeshCount(), 0);
+
+    update(0, 0);
+    TestEqual("building", pCache->getBuildingMeshCount(), 4);
+    waitForBuilds();
+    TestEqual("built", pCache->getCachedMeshCount(), 4);
+  });
+
+  It("traces lines against a tileset without tiles", [this]() {
+    UWorld* pWorld = CesiumTestHelpers::getGlobalWorldContext();
+    ACesium3DTileset* pTileset = pWorld->SpawnActor<ACesium3DTileset>();
+    pTileset->SetUseSharedTilesetTransform(true);
+
+    FHitResult hit;
+    TestFalse(
+        "hit",
+        pTileset->LineTraceTiles(
+            FVector(0.0, 0.0, 1000.0),
+            FVector(0.0, 0.0, -1000.0),
+            hit));
+
+    // The query must not create the component that tiles are attached to.
+    TestNull(
+        "shared transform",
+        pTileset->FindComponentByClass<UCesiumTilesetTransformComponent>());
+
+    pTileset->Destroy();
+  });
+}
@@ -0,0 +1,183 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumPhysicsMeshes.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumPhysicsMeshesSpec,
+    "Cesium.Unit.PhysicsMeshes",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+// Two unit squares, one at z = 0 and one at z = 10, with a degenerate triangle
+// in between.
+CesiumPhysicsMeshes::TriangleSource CreateSource() {
+  CesiumPhysicsMeshes::TriangleSource source;
+  for (float z : {0.0f, 10.0f}) {
+    source.positions.Add(FVector3f(0.0f, 0.0f, z));
+    source.positions.Add(FVector3f(1.0f, 0.0f, z));
+    source.positions.Add(FVector3f(1.0f, 1.0f, z));
+    source.positions.Add(FVector3f(0.0f, 1.0f, z));
+  }
+  source.indices = {0, 1, 2, 0, 2, 3, 0, 1, 1, 4, 5, 6, 4, 6, 7};
+  return source;
+}
+
+END_DEFINE_SPEC(FCesiumPhysicsMeshesSpec)
+
+void FCesiumPhysicsMeshesSpec::Define() {
+  Describe("buildTriangleMeshes", [this]() {
+    It("leaves out degenerate triangles", [this]() {
+      TArray<CesiumPhysicsMeshes::TriangleMeshPtr> meshes =
+          CesiumPhysicsMeshes::buildTriangleMeshes(CreateSource());
+      if (!TestEqual("meshes", meshes.Num(), 1)) {
+        return;
+      }
+
+      TestEqual("triangles", meshes[0]->Elements().GetNumTriangles(), 4);
+      TestEqual("face 1", meshes[0]->GetExternalFaceIndexFromInternal(1), 1);
+      TestEqual("face 2", meshes[0]->GetExternalFaceIndexFromInternal(2), 3);
+    });
+
+    It("leaves out the same slivers as the previous cooker", [this]() {
+      // Slivers of decreasing height along edges of several lengths, so that
+      // the cross products of their edges span many orders of magnitude.
+      CesiumPhysicsMeshes::TriangleSource source;
+      for (float length : {1.0f, 100.0f, 10000.0f}) {
+        for (float height :
+             {1.0f, 1.0e-1f, 1.0e-3f, 1.0e-5f, 1.0e-7f, 1.0e-9f, 0.0f}) {
+          const uint32 first = uint32(source.positions.Num());
+          source.positions.Add(FVector3f(0.0f, 0.0f, 0.0f));
+          source.positions.Add(FVector3f(length, 0.0f, 0.0f));
+          source.positions.Add(FVector3f(0.5f * length, height, 0.0f));
+          source.indices.Append({first, first + 1, first + 2});
+        }
+      }
+
+      // The test of the previous cooker.
+      using ParticleVecType =
+          Chaos::FTriangleMeshImplicitObject::ParticleVecType;
+      TArray<int32> expected;
+      for (int32 i = 0; i < source.indices.Num() / 3; ++i) {
+        const FVector3f& a = source.positions[source.indices[3 * i]];
+        const FVector3f& b = source.positions[source.indices[3 * i + 1]];
+        const FVector3f& c = source.positions[source.indices[3 * i + 2]];
+        ParticleVecType normal = ParticleVecType::CrossProduct(b - a, c - a);
+        if (normal.SafeNormalize() >= 1.e-8f) {
+          expected.Add(i);
+        }
+      }
+      TestTrue("keeps some", expected.Num() > 0);
+      TestTrue("leaves out some", expected.Num() < source.indices.Num() / 3);
+
+      TArray<CesiumPhysicsMeshes::TriangleMeshPtr> meshes =
+          CesiumPhysicsMeshes::buildTriangleMeshes(source);
+      if (!TestEqual("meshes", meshes.Num(), 1) ||
+          !TestEqual(
+              "triangles",
+              meshes[0]->Elements().GetNumTriangles(),
+              expected.Num())) {
+        return;
+      }
+      for (int32 i = 0; i < expected.Num(); ++i) {
+        TestEqual(
+            "face",
+            meshes[0]->GetExternalFaceIndexFromInternal(i),
+            expected[i]);
+      }
+    });
+
+    It("returns no meshes without triangles", [this]() {
+      CesiumPhysicsMeshes::TriangleSource source;
+      TestEqual(
+          "meshes",
+          CesiumPhysicsMeshes::buildTriangleMeshes(source).Num(),
+          0);
+    });
+
+    It("splits large meshes", [this]() {
+      // A grid of 200 x 200 quads, whose first row is collapsed onto a line.
+      const int32 size = 200;
+      CesiumPhysicsMeshes::TriangleSource source;
+      for (int32 y = 0; y <= size; ++y) {
+        for (int32 x = 0; x <= size; ++x) {
+          source.positions.Add(
+              FVector3f(float(x), float(FMath::Max(y, 1)), 0.0f));
+        }
+      }
+      for (int32 y = 0; y < size; ++y) {
+        for (int32 x = 0; x < size; ++x) {
+          const uint32 corner = uint32(y * (size + 1) + x);
+          const uint32 above = corner + uint32(size + 1);
+          source.indices.Append({corner, corner + 1, above + 1});
+          source.indices.Append({corner, above + 1, above});
+        }
+      }
+
+      TArray<CesiumPhysicsMeshes::TriangleMeshPtr> meshes =
+          CesiumPhysicsMeshes::buildTriangleMeshes(source);
+      TestTrue("meshes", meshes.Num() > 1);
+
+      // The collapsed row is left out, and the rest keep their order.
+      const int32 firstKept = 2 * size;
+      int32 triangleCount = 0;
+      for (const CesiumPhysicsMeshes::TriangleMeshPtr& pMesh : meshes) {
+        const int32 count = pMesh->Elements().GetNumTriangles();
+        for (int32 i = 0; i < count; ++i) {
+          const int32 face = pMesh->GetExternalFaceIndexFromInternal(i);
+          if (face != firstKept + triangleCount + i) {
+            TestEqual("face", face, firstKept + triangleCount + i);
+            return;
+          }
+        }
+        triangleCount += count;
+      }
+      TestEqual("triangles", triangleCount, 2 * size * (size - 1));
+    });
+  });
+
+  Describe("lineTrace", [this]() {
+    It("finds the closest triangle", [this]() {
+      CesiumPhysicsMeshes::TriangleSource source = CreateSource();
+      CesiumPhysicsMeshes::LineTraceHit hit;
+
+      const bool found = CesiumPhysicsMeshes::lineTrace(
+          source,
+          FVector(0.75, 0.25, 20.0),
+          FVector(0.75, 0.25, -20.0),
+          hit);
+      TestTrue("found", found);
+      TestEqual("time", hit.time, 0.25);
+      TestEqual("face", hit.faceIndex, 3);
+      TestEqual("normal", hit.normal, FVector(0.0, 0.0, 1.0));
+    });
+
+    It("faces the normal towards the start", [this]() {
+      CesiumPhysicsMeshes::TriangleSource source = CreateSource();
+      CesiumPhysicsMeshes::LineTraceHit hit;
+
+      const bool found = CesiumPhysicsMeshes::lineTrace(
+          source,
+          FVector(0.25, 0.75, -20.0),
+          FVector(0.25, 0.75, 20.0),
+          hit);
+      TestTrue("found", found);
+      TestEqual("time", hit.time, 0.5);
+      TestEqual("face", hit.faceIndex, 1);
+      TestEqual("normal", hit.normal, FVector(0.0, 0.0, -1.0));
+    });
+
+    It("misses lines that end before the triangles", [this]() {
+      CesiumPhysicsMeshes::TriangleSource source = CreateSource();
+      CesiumPhysicsMeshes::LineTraceHit hit;
+
+      TestFalse(
+          "found",
+          CesiumPhysicsMeshes::lineTrace(
+              source,
+              FVector(0.5, 0.25, 20.0),
+              FVector(0.5, 0.25, 15.0),
+              hit));
+    });
+  });
+}
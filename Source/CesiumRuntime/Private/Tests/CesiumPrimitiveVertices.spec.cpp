@@ -0,0 +1,138 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumPrimitiveVertices.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumPrimitiveVerticesSpec,
+    "Cesium.Unit.PrimitiveVertices",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+/**
+ * Fills the vertices duplicated for the given triangle corners, as the loader
+ * does before generating normals or tangents. glTF vertex i is at (i, 0, 0)
+ * with texture coordinate (i, i), color (i, i, i), and normal +Z.
+ */
+void duplicate(
+    CesiumPrimitiveVertices& vertices,
+    const TArray<uint32>& corners,
+    bool withTangents) {
+  FColorVertexBuffer& colors = vertices.vertexBuffers.ColorVertexBuffer;
+  colors.Init(uint32(corners.Num()), false);
+  if (withTangents) {
+    vertices.allocateTangents();
+  }
+
+  TArray<FVector2f>& texCoords = vertices.texCoords(0);
+  for (int32 i = 0; i < corners.Num(); ++i) {
+    const uint32 source = corners[i];
+    vertices.position(i) = FVector3f(float(source), 0.0f, 0.0f);
+    texCoords[i] = FVector2f(float(source), float(source));
+    colors.VertexColor(uint32(i)) =
+        FColor(uint8(source), uint8(source), uint8(source));
+    vertices.tangentZ[i] = FVector3f(0.0f, 0.0f, 1.0f);
+    if (withTangents) {
+      vertices.tangentX[i] = FVector3f(1.0f, 0.0f, 0.0f);
+      vertices.tangentY[i] = FVector3f(0.0f, 1.0f, 0.0f);
+    }
+  }
+}
+
+void TestIndices(
+    const TArray<uint32>& indices,
+    const TArray<uint32>& expected) {
+  if (!TestEqual("index count", indices.Num(), expected.Num())) {
+    return;
+  }
+  for (int32 i = 0; i < indices.Num(); ++i) {
+    TestEqual("index", int32(indices[i]), int32(expected[i]));
+  }
+}
+
+void TestVertexIsCopyOf(
+    const CesiumPrimitiveVertices& vertices,
+    int32 merged,
+    uint32 source) {
+  const float s = float(source);
+  TestTrue(
+      "position",
+      vertices.position(merged) == FVector3f(s, 0.0f, 0.0f));
+  TestTrue(
+      "texture coordinate",
+      vertices.texCoordSets[0][merged] == FVector2f(s, s));
+  TestTrue(
+      "color",
+      vertices.vertexBuffers.ColorVertexBuffer.VertexColor(uint32(merged)) ==
+          FColor(uint8(source), uint8(source), uint8(source)));
+}
+
+END_DEFINE_SPEC(FCesiumPrimitiveVerticesSpec)
+
+void FCesiumPrimitiveVerticesSpec::Define() {
+  It("welds shared corners with identical normals and tangents", [this]() {
+    TArray<uint32> indices = {0, 1, 2, 2, 1, 3};
+    FStaticMeshVertexBuffers buffers;
+    CesiumPrimitiveVertices vertices(buffers, indices.Num());
+    duplicate(vertices, indices, true);
+
+    TestEqual("removed", vertices.weld(indices, 4), 2);
+    TestEqual("count", vertices.count, 4);
+    TestIndices(indices, {0, 1, 2, 2, 1, 3});
+    TestEqual("tangents", vertices.tangentX.Num(), 4);
+    TestEqual(
+        "positions",
+        int32(buffers.PositionVertexBuffer.GetNumVertices()),
+        4);
+    TestEqual("colors", int32(buffers.ColorVertexBuffer.GetNumVertices()), 4);
+  });
+
+  It("keeps corners whose normals differ", [this]() {
+    TArray<uint32> indices = {0, 1, 2, 2, 1, 3};
+    FStaticMeshVertexBuffers buffers;
+    CesiumPrimitiveVertices vertices(buffers, indices.Num());
+    duplicate(vertices, indices, false);
+
+    // The second triangle is flat-shaded with a different normal, so none of
+    // its corners may be merged into the first triangle's.
+    for (int32 i = 3; i < 6; ++i) {
+      vertices.tangentZ[i] = FVector3f(0.0f, 1.0f, 0.0f);
+    }
+
+    TestEqual("removed", vertices.weld(indices, 4), 0);
+    TestEqual("count", vertices.count, 6);
+    TestIndices(indices, {0, 1, 2, 3, 4, 5});
+  });
+
+  It("keeps corners whose tangents differ", [this]() {
+    TArray<uint32> indices = {0, 1, 2, 2, 1, 3};
+    FStaticMeshVertexBuffers buffers;
+    CesiumPrimitiveVertices vertices(buffers, indices.Num());
+    duplicate(vertices, indices, true);
+    vertices.tangentX[4] = FVector3f(0.0f, 1.0f, 0.0f);
+
+    TestEqual("removed", vertices.weld(indices, 4), 1);
+    TestIndices(indices, {0, 1, 2, 2, 3, 4});
+    TestTrue(
+        "kept tangent",
+        vertices.tangentX[3] == FVector3f(0.0f, 1.0f, 0.0f));
+  });
+
+  It("remaps indices to the compacted vertices", [this]() {
+    // A fan of three triangles around glTF vertex 0. Vertex 4 is never used,
+    // so vertex 5 ends up at index 4.
+    TArray<uint32> indices = {0, 1, 2, 0, 2, 3, 0, 3, 5};
+    FStaticMeshVertexBuffers buffers;
+    CesiumPrimitiveVertices vertices(buffers, indices.Num());
+    duplicate(vertices, indices, false);
+
+    TestEqual("removed", vertices.weld(indices, 6), 4);
+    TestEqual("count", vertices.count, 5);
+    TestIndices(indices, {0, 1, 2, 0, 2, 3, 0, 3, 4});
+
+    const uint32 sources[] = {0, 1, 2, 3, 5};
+    for (int32 merged = 0; merged < 5; ++merged) {
+      TestVertexIsCopyOf(vertices, merged, sources[merged]);
+    }
+  });
+}
@@ -836,4 +836,105 @@ void FCesiumPropertyTableSpec::Define() {
       TestTrue("values map is empty", values.IsEmpty());
     });
   });
+
+  Describe("Columns", [this]() {
+    It("exposes numeric properties as strided spans", [this]() {
+      pPropertyTable->classProperty = "testClass";
+      std::string propertyName("testProperty");
+      std::vector<glm::i16vec2> values{
+          glm::i16vec2(1, -2),
+          glm::i16vec2(3, -4),
+          glm::i16vec2(5, -6)};
+      pPropertyTable->count = static_cast<int64_t>(values.size());
+      AddPropertyTablePropertyToModel(
+          model,
+          *pPropertyTable,
+          propertyName,
+          ClassProperty::Type::VEC2,
+          ClassProperty::ComponentType::INT16,
+          values);
+
+      FCesiumPropertyTable propertyTable(model, *pPropertyTable);
+      const FCesiumPropertyTableProperty& property =
+          UCesiumPropertyTableBlueprintLibrary::FindProperty(
+              propertyTable,
+              FString(propertyName.c_str()));
+
+      TCesiumStridedSpan<glm::i16vec2> column =
+          UCesiumPropertyTablePropertyBlueprintLibrary::GetColumnValues<
+              glm::i16vec2>(property);
+      TestEqual<int64>("num", column.Num, static_cast<int64>(values.size()));
+      for (size_t i = 0; i < values.size(); i++) {
+        TestTrue(
+            std::string("value" + std::to_string(i)).c_str(),
+            column[static_cast<int64>(i)] == values[i]);
+      }
+
+      TestTrue(
+          "mismatched type",
+          UCesiumPropertyTablePropertyBlueprintLibrary::GetColumnValues<
+              glm::u16vec2>(property)
+              .IsEmpty());
+      TestTrue(
+          "out-of-range array index",
+          UCesiumPropertyTablePropertyBlueprintLibrary::GetColumnValues<
+              glm::i16vec2>(property, 1)
+              .IsEmpty());
+    });
+
+    It("exposes strings as offsets and values", [this]() {
+      pPropertyTable->classProperty = "testClass";
+      std::string propertyName("testProperty");
+      std::vector<std::string> strings{"Test 1", "", "Third test"};
+      pPropertyTable->count = static_cast<int64_t>(strings.size());
+
+      std::vector<uint8_t> characters;
+      std::vector<uint32_t> offsets{0};
+      for (const std::string& string : strings) {
+        characters.insert(characters.end(), string.begin(), string.end());
+        offsets.push_back(static_cast<uint32_t>(characters.size()));
+      }
+
+      PropertyTableProperty& propertyTableProperty =
+          AddPropertyTablePropertyToModel(
+              model,
+              *pPropertyTable,
+              propertyName,
+              ClassProperty::Type::STRING,
+              std::nullopt,
+              characters);
+
+      Buffer& offsetBuffer = model.buffers.emplace_back();
+      offsetBuffer.cesium.data = GetValuesAsBytes(offsets);
+      offsetBuffer.byteLength =
+          static_cast<int64_t>(offsetBuffer.cesium.data.size());
+      BufferView& offsetBufferView = model.bufferViews.emplace_back();
+      offsetBufferView.buffer = static_cast<int32_t>(model.buffers.size() - 1);
+      offsetBufferView.byteLength = offsetBuffer.byteLength;
+      propertyTableProperty.stringOffsets =
+          static_cast<int32_t>(model.bufferViews.size() - 1);
+      propertyTableProperty.stringOffsetType =
+          PropertyTableProperty::StringOffsetType::UINT32;
+
+      FCesiumPropertyTable propertyTable(model, *pPropertyTable);
+      const FCesiumPropertyTableProperty& property =
+          UCesiumPropertyTableBlueprintLibrary::FindProperty(
+              propertyTable,
+              FString(propertyName.c_str()));
+
+      const FCesiumPropertyTableColumn& column =
+          UCesiumPropertyTablePropertyBlueprintLibrary::GetColumn(property);
+      for (size_t i = 0; i < strings.size(); i++) {
+        TestTrue(
+            std::string("value" + std::to_string(i)).c_str(),
+            column.GetString(static_cast<int64>(i)) == strings[i]);
+      }
+
+      TestTrue(
+          "no strided span",
+          UCesiumPropertyTablePropertyBlueprintLibrary::GetColumnValues<
+              uint8_t>(property)
+              .IsEmpty());
+    });
+  });
 }
@@ -0,0 +1,105 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumGltfSpecUtility.h"
+#include "CesiumPropertyTableProperty.h"
+#include "CesiumRuntime.h"
+#include "Misc/AutomationTest.h"
+#include <vector>
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCesiumPropertyTableBatchedValues,
+    "Cesium.Performance.PropertyTable.BatchedValues",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::PerfFilter)
+
+using namespace CesiumGltf;
+
+namespace {
+
+// Roughly the feature count of a large BIM or city tile.
+const int32 FeatureCount = 1000000;
+
+template <typename TGet> double measure(TGet&& get) {
+  const double start = FPlatformTime::Seconds();
+  get();
+  return (FPlatformTime::Seconds() - start) * 1000.0;
+}
+
+} // namespace
+
+bool FCesiumPropertyTableBatchedValues::RunTest(const FString& Parameters) {
+  PropertyTableProperty propertyTableProperty;
+  ClassProperty classProperty;
+  classProperty.type = ClassProperty::Type::SCALAR;
+  classProperty.componentType = ClassProperty::ComponentType::UINT16;
+  classProperty.normalized = true;
+  classProperty.scale = 100.0;
+
+  std::vector<uint16_t> values(static_cast<size_t>(FeatureCount));
+  for (size_t i = 0; i < values.size(); i++) {
+    values[i] = static_cast<uint16_t>(i * 7919);
+  }
+  std::vector<std::byte> data = GetValuesAsBytes(values);
+
+  PropertyTablePropertyView<uint16_t, true> propertyView(
+      propertyTableProperty,
+      classProperty,
+      static_cast<int64_t>(values.size()),
+      gsl::span<const std::byte>(data.data(), data.size()));
+  FCesiumPropertyTableProperty property(propertyView);
+
+  // Query the features in a scattered order, as picking or analytics would.
+  TArray<int64> featureIDs;
+  featureIDs.SetNumUninitialized(FeatureCount);
+  for (int32 i = 0; i < FeatureCount; i++) {
+    featureIDs[i] = (int64(i) * 7919) % FeatureCount;
+  }
+
+  TArray<double> perFeature;
+  perFeature.SetNumUninitialized(FeatureCount);
+  const double perFeatureMilliseconds = measure([&]() {
+    for (int32 i = 0; i < FeatureCount; i++) {
+      perFeature[i] = UCesiumPropertyTablePropertyBlueprintLibrary::GetFloat64(
+          property,
+          featureIDs[i]);
+    }
+  });
+
+  TArray<double> batched;
+  batched.SetNumUninitialized(FeatureCount);
+  const double batchedMilliseconds = measure([&]() {
+    UCesiumPropertyTablePropertyBlueprintLibrary::GetValues<double>(
+        property,
+        featureIDs,
+        batched);
+  });
+
+  TArray<double> range;
+  range.SetNumUninitialized(FeatureCount);
+  const double rangeMilliseconds = measure([&]() {
+    UCesiumPropertyTablePropertyBlueprintLibrary::GetValues<double>(
+        property,
+        0,
+        range);
+  });
+
+  UE_LOG(
+      LogCesium,
+      Display,
+      TEXT(
+          "Read %d normalized uint16 values: per feature %.2f ms, batched by ID %.2f ms, batched range %.2f ms."),
+      FeatureCount,
+      perFeatureMilliseconds,
+      batchedMilliseconds,
+      rangeMilliseconds);
+
+  TestTrue("Batched values match", perFeature == batched);
+  for (int32 i = 0; i < FeatureCount; i++) {
+    if (range[featureIDs[i]] != perFeature[i]) {
+      AddError(FString::Printf(TEXT("Range value %d does not match."), i));
+      break;
+    }
+  }
+
+  return true;
+}
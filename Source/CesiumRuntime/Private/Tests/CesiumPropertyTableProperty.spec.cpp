@@ -4272,4 +4272,92 @@ void FCesiumPropertyTablePropertySpec::Define() {
       }
     });
   });
+
+  Describe("GetValues", [this]() {
+    It("returns default values for invalid property", [this]() {
+      FCesiumPropertyTableProperty property;
+      const TArray<int64> featureIDs{0, 1};
+      TArray<int32> values;
+      values.Init(-1, featureIDs.Num());
+      UCesiumPropertyTablePropertyBlueprintLibrary::GetValues<int32>(
+          property,
+          featureIDs,
+          values,
+          5);
+      TestEqual("value0", values[0], 5);
+      TestEqual("value1", values[1], 5);
+    });
+
+    It("matches the single-feature getter for feature IDs", [this]() {
+      PropertyTableProperty propertyTableProperty;
+      ClassProperty classProperty;
+      classProperty.type = ClassProperty::Type::SCALAR;
+      classProperty.componentType = ClassProperty::ComponentType::UINT8;
+      classProperty.normalized = true;
+      classProperty.offset = 1.0;
+      classProperty.scale = 2.0;
+
+      std::vector<uint8_t> values{0, 64, 128, 255};
+      std::vector<std::byte> data = GetValuesAsBytes(values);
+
+      PropertyTablePropertyView<uint8_t, true> propertyView(
+          propertyTableProperty,
+          classProperty,
+          static_cast<int64_t>(values.size()),
+          gsl::span<const std::byte>(data.data(), data.size()));
+      FCesiumPropertyTableProperty property(propertyView);
+
+      const TArray<int64> featureIDs{3, -1, 1, 10, 0, 2, 2};
+      TArray<double> batched;
+      batched.SetNum(featureIDs.Num());
+      UCesiumPropertyTablePropertyBlueprintLibrary::GetValues<double>(
+          property,
+          featureIDs,
+          batched,
+          -1.0);
+
+      for (int32 i = 0; i < featureIDs.Num(); i++) {
+        TestEqual(
+            std::string("value" + std::to_string(i)).c_str(),
+            batched[i],
+            UCesiumPropertyTablePropertyBlueprintLibrary::GetFloat64(
+                property,
+                featureIDs[i],
+                -1.0));
+      }
+    });
+
+    It("gets a range of features", [this]() {
+      PropertyTableProperty propertyTableProperty;
+      ClassProperty classProperty;
+      classProperty.type = ClassProperty::Type::VEC2;
+      classProperty.componentType = ClassProperty::ComponentType::INT16;
+
+      std::vector<glm::i16vec2> values{
+          glm::i16vec2(1, 2),
+          glm::i16vec2(-3, 4),
+          glm::i16vec2(5, -6)};
+      std::vector<std::byte> data = GetValuesAsBytes(values);
+
+      PropertyTablePropertyView<glm::i16vec2> propertyView(
+          propertyTableProperty,
+          classProperty,
+          static_cast<int64_t>(values.size()),
+          gsl::span<const std::byte>(data.data(), data.size()));
+      FCesiumPropertyTableProperty property(propertyView);
+
+      // The range extends past the end of the property.
+      TArray<FIntPoint> batched;
+      batched.SetNum(3);
+      UCesiumPropertyTablePropertyBlueprintLibrary::GetValues<FIntPoint>(
+          property,
+          1,
+          batched,
+          FIntPoint(0));
+
+      TestEqual("value0", batched[0], FIntPoint(-3, 4));
+      TestEqual("value1", batched[1], FIntPoint(5, -6));
+      TestEqual("value2", batched[2], FIntPoint(0));
+    });
+  });
 }
@@ -0,0 +1,308 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#if WITH_EDITOR
+
+#include "CesiumAsync/CachingAssetAccessor.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "CesiumAsync/SqliteCache.h"
+#include "CesiumRuntime.h"
+#include "CesiumTieredCacheDatabase.h"
+#include "Containers/Ticker.h"
+#include "HAL/FileManager.h"
+#include "HttpPath.h"
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UnrealAssetAccessor.h"
+#include <spdlog/spdlog.h>
+#include <string>
+#include <vector>
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCesiumRequestCacheFlightReplay,
+    "Cesium.Performance.RequestCache.FlightReplay",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+using namespace CesiumAsync;
+
+namespace {
+
+const uint32 ServerPort = 8787;
+const TCHAR* RoutePrefix = TEXT("/cesium-request-cache-benchmark");
+
+// One entry per frame, each listing the tile paths requested in that frame.
+using FlightPath = std::vector<std::vector<FString>>;
+
+/**
+ * Loads a recorded flight path, if one exists. The file has one frame per
+ * line, and each line lists the whitespace-separated paths of the tiles
+ * requested in that frame, e.g. "14/8120/5230.glb 14/8121/5230.glb".
+ */
+bool loadRecordedFlightPath(const FString& filename, FlightPath& path) {
+  TArray<FString> lines;
+  if (!FFileHelper::LoadFileToStringArray(lines, *filename)) {
+    return false;
+  }
+
+  for (const FString& line : lines) {
+    TArray<FString> tiles;
+    line.ParseIntoArrayWS(tiles);
+    if (tiles.Num() > 0) {
+      path.emplace_back(tiles.GetData(), tiles.GetData() + tiles.Num());
+    }
+  }
+
+  return !path.empty();
+}
+
+/**
+ * Generates a flight that crosses a strip of tiles and then flies back the
+ * same way, so that the second half re-enters recently visited tiles.
+ */
+FlightPath generateFlightPath() {
+  const int32 level = 14;
+  const int32 stripLength = 96;
+  const int32 radius = 3;
+
+  FlightPath path;
+  auto addFrame = [&path](int32 centerX) {
+    std::vector<FString>& frame = path.emplace_back();
+    for (int32 y = -radius; y <= radius; ++y) {
+      for (int32 x = centerX - radius; x <= centerX + radius; ++x) {
+        frame.emplace_back(FString::Printf(TEXT("%d/%d/%d.glb"), level, x, y));
+      }
+      // Coarser parent tiles are requested every frame, too.
+      frame.emplace_back(FString::Printf(
+          TEXT("%d/%d/%d.glb"),
+          level - 2,
+          centerX / 4,
+          y / 4));
+    }
+  };
+
+  for (int32 x = 0; x < stripLength; ++x) {
+    addFrame(x);
+  }
+  for (int32 x = stripLength - 1; x >= 0; --x) {
+    addFrame(x);
+  }
+
+  return path;
+}
+
+/**
+ * Writes a deterministic tile payload for every tile in the flight path into
+ * the directory served by the local file server.
+ */
+void writeTiles(const FString& directory, const FlightPath& path) {
+  TSet<FString> written;
+  for (const std::vector<FString>& frame : path) {
+    for (const FString& tile : frame) {
+      if (written.Contains(tile)) {
+        continue;
+      }
+      written.Add(tile);
+
+      const uint32 hash = GetTypeHash(tile);
+      TArray<uint8> payload;
+      payload.SetNumUninitialized(64 * 1024 + int32(hash % (448 * 1024)));
+      for (int32 i = 0; i < payload.Num(); ++i) {
+        payload[i] = uint8((hash + i * 31) & 0xff);
+      }
+      FFileHelper::SaveArrayToFile(payload, *FPaths::Combine(directory, tile));
+    }
+  }
+}
+
+struct ReplayResult {
+  double seconds = 0.0;
+  int32 requests = 0;
+  int32 failures = 0;
+};
+
+ReplayResult replay(
+    const FlightPath& path,
+    const std::shared_ptr<IAssetAccessor>& pAccessor) {
+  ReplayResult result;
+  const std::string baseUrl =
+      "http://localhost:" + std::to_string(ServerPort) +
+      TCHAR_TO_UTF8(RoutePrefix) + "/";
+
+  const double start = FPlatformTime::Seconds();
+
+  for (const std::vector<FString>& frame : path) {
+    int32 remaining = int32(frame.size());
+    for (const FString& tile : frame) {
+      ++result.requests;
+      pAccessor->get(getAsyncSystem(), baseUrl + TCHAR_TO_UTF8(*tile), {})
+          .thenInMainThread(
+              [&remaining,
+               &result](std::shared_ptr<IAssetRequest>&& pRequest) {
+                const IAssetResponse* pResponse = pRequest->response();
+                if (!pResponse || pResponse->statusCode() != 200) {
+                  ++result.failures;
+                }
+                --remaining;
+              })
+          .catchInMainThread([&remaining, &result](std::exception&&) {
+            ++result.failures;
+            --remaining;
+          });
+    }
+
+    // Like a frame, wait for every request of this frame to complete.
+    while (remaining > 0) {
+      FTSTicker::GetCoreTicker().Tick(0.0f);
+      pAccessor->tick();
+      getAsyncSystem().dispatchMainThreadTasks();
+    }
+  }
+
+  result.seconds = FPlatformTime::Seconds() - start;
+  return result;
+}
+
+} // namespace
+
+bool FCesiumRequestCacheFlightReplay::RunTest(const FString& Parameters) {
+  const FString directory = FPaths::ConvertRelativePathToFull(
+      FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("CesiumCacheBenchmark")));
+  const FString tileDirectory = FPaths::Combine(directory, TEXT("tiles"));
+  IFileManager::Get().DeleteDirectory(*directory, false, true);
+  IFileManager::Get().MakeDirectory(*tileDirectory, true);
+
+  FlightPath path;
+  const FString recordedPath = FPaths::Combine(
+      FPaths::ProjectSavedDir(),
+      TEXT("Cesium"),
+      TEXT("RequestCacheFlightPath.txt"));
+  if (loadRecordedFlightPath(recordedPath, path)) {
+    UE_LOG(
+        LogCesium,
+        Display,
+        TEXT("Replaying recorded flight path %s"),
+        *recordedPath);
+  } else {
+    path = generateFlightPath();
+  }
+  writeTiles(tileDirectory, path);
+
+  // Serve the tiles from a local file server, with headers that allow the
+  // responses to be cached.
+  FHttpServerModule& httpServer = FHttpServerModule::Get();
+  TSharedPtr<IHttpRouter> pRouter = httpServer.GetHttpRouter(ServerPort);
+  if (!TestNotNull("HTTP router", pRouter.Get())) {
+    return false;
+  }
+
+  FHttpRouteHandle routeHandle = pRouter->BindRoute(
+      FHttpPath(RoutePrefix),
+      EHttpServerRequestVerbs::VERB_GET,
+      [tileDirectory](
+          const FHttpServerRequest& request,
+          const FHttpResultCallback& onComplete) {
+        FString relative = request.RelativePath.GetPath();
+        relative.RemoveFromStart(RoutePrefix);
+        relative.RemoveFromStart(TEXT("/"));
+
+        TArray<uint8> content;
+        if (!FFileHelper::LoadFileToArray(
+                content,
+                *FPaths::Combine(tileDirectory, relative))) {
+          onComplete(FHttpServerResponse::Error(
+              EHttpServerResponseCodes::NotFound));
+          return true;
+        }
+
+        TUniquePtr<FHttpServerResponse> pResponse = FHttpServerResponse::Create(
+            MoveTemp(content),
+            TEXT("application/octet-stream"));
+        pResponse->Headers.Add(
+            TEXT("Cache-Control"),
+            {TEXT("max-age=86400")});
+        onComplete(MoveTemp(pResponse));
+        return true;
+      });
+  httpServer.StartAllListeners();
+
+  std::shared_ptr<IAssetAccessor> pUnrealAccessor =
+      std::make_shared<UnrealAssetAccessor>();
+
+  auto runConfiguration =
+      [&](const FString& name,
+          const std::shared_ptr<ICacheDatabase>& pDatabase) {
+    std::shared_ptr<IAssetAccessor> pAccessor =
+        std::make_shared<CachingAssetAccessor>(
+            spdlog::default_logger(),
+            pUnrealAccessor,
+            pDatabase);
+
+    ReplayResult cold = replay(path, pAccessor);
+    ReplayResult warm = replay(path, pAccessor);
+
+    TestEqual(name + " cold failures", cold.failures, 0);
+    TestEqual(name + " warm failures", warm.failures, 0);
+
+    UE_LOG(
+        LogCesium,
+        Display,
+        TEXT(
+            "%s: %d requests, cold replay %.3f secs, warm replay %.3f secs"),
+        *name,
+        cold.requests,
+        cold.seconds,
+        warm.seconds);
+  };
+
+  const std::string sqliteOnlyFile = TCHAR_TO_UTF8(
+      *FPaths::Combine(directory, TEXT("sqlite-only.sqlite")));
+  runConfiguration(
+      TEXT("Sqlite"),
+      std::make_shared<SqliteCache>(
+          spdlog::default_logger(),
+          sqliteOnlyFile,
+          4096));
+
+  const std::string tieredFile =
+      TCHAR_TO_UTF8(*FPaths::Combine(directory, TEXT("tiered.sqlite")));
+  std::shared_ptr<CesiumTieredCacheDatabase> pTiered =
+      std::make_shared<CesiumTieredCacheDatabase>(
+          std::make_shared<SqliteCache>(
+              spdlog::default_logger(),
+              tieredFile,
+              4096),
+          256ULL * 1024 * 1024,
+          64ULL * 1024 * 1024,
+          64);
+  runConfiguration(TEXT("Tiered"), pTiered);
+  pTiered->flush();
+
+  CesiumTieredCacheDatabase::Statistics stats = pTiered->getStatistics();
+  UE_LOG(
+      LogCesium,
+      Display,
+      TEXT(
+          "Tiered cache: %llu memory hits, %llu pending-write hits, %llu disk hits, %llu misses, %.1f us average lookup, %llu writes in %llu batches, %.1f MB in memory"),
+      uint64(stats.memoryHits),
+      uint64(stats.pendingWriteHits),
+      uint64(stats.diskHits),
+      uint64(stats.misses),
+      stats.averageLookupMicroseconds,
+      uint64(stats.completedWrites),
+      uint64(stats.writeBatches),
+      double(stats.memoryBytes) / (1024.0 * 1024.0));
+
+  pTiered.reset();
+
+  pRouter->UnbindRoute(routeHandle);
+  httpServer.StopAllListeners();
+  IFileManager::Get().DeleteDirectory(*directory, false, true);
+
+  return true;
+}
+
+#endif
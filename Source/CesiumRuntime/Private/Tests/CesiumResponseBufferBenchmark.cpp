@@ -0,0 +1,140 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumAsync/IAssetResponse.h"
+#include "CesiumGltfReader/GltfReader.h"
+#include "CesiumResponseBuffer.h"
+#include "CesiumRuntime.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UnrealAssetAccessor.h"
+#include <cstring>
+#include <string>
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCesiumResponseBufferLargeTiles,
+    "Cesium.Performance.ResponseBuffer.LargeFileTiles",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::PerfFilter)
+
+namespace {
+
+void appendUint32(TArray<uint8>& glb, uint32 value) {
+  const int32 offset = glb.AddUninitialized(sizeof(uint32));
+  std::memcpy(glb.GetData() + offset, &value, sizeof(uint32));
+}
+
+/**
+ * Creates a valid GLB whose binary chunk holds a single buffer of the given
+ * size, similar in size to a large photogrammetry b3dm/glb payload.
+ */
+TArray<uint8> createGlb(uint32 binarySize) {
+  std::string json =
+      "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":" +
+      std::to_string(binarySize) + "}]}";
+  while (json.size() % 4 != 0) {
+    json += ' ';
+  }
+  const uint32 paddedBinarySize = (binarySize + 3) & ~3U;
+
+  TArray<uint8> glb;
+  glb.Reserve(12 + 8 + json.size() + 8 + paddedBinarySize);
+
+  appendUint32(glb, 0x46546C67); // "glTF"
+  appendUint32(glb, 2);
+  appendUint32(glb, 12 + 8 + uint32(json.size()) + 8 + paddedBinarySize);
+
+  appendUint32(glb, uint32(json.size()));
+  appendUint32(glb, 0x4E4F534A); // "JSON"
+  glb.Append(reinterpret_cast<const uint8*>(json.data()), json.size());
+
+  appendUint32(glb, paddedBinarySize);
+  appendUint32(glb, 0x004E4942); // "BIN"
+  const int32 binaryOffset = glb.AddZeroed(paddedBinarySize);
+  for (uint32 i = 0; i < binarySize; i += 4096) {
+    glb[binaryOffset + i] = uint8(i / 4096);
+  }
+
+  return glb;
+}
+
+} // namespace
+
+bool FCesiumResponseBufferLargeTiles::RunTest(const FString& Parameters) {
+  const FString directory = FPaths::ConvertRelativePathToFull(FPaths::Combine(
+      FPaths::ProjectSavedDir(),
+      TEXT("CesiumResponseBufferBenchmark")));
+  IFileManager::Get().MakeDirectory(*directory, true);
+
+  UnrealAssetAccessor accessor{};
+  CesiumGltfReader::GltfReader reader{};
+
+  for (uint32 megabytes : {20U, 35U, 50U}) {
+    const FString filename =
+        FPaths::Combine(directory, FString::Printf(TEXT("%u.glb"), megabytes));
+    FFileHelper::SaveArrayToFile(createGlb(megabytes * 1024 * 1024), *filename);
+
+    FString uri = TEXT("file:///") + filename;
+    uri.ReplaceCharInline('\\', '/');
+    uri.ReplaceInline(TEXT(" "), TEXT("%20"));
+
+    const CesiumResponseBuffer::Statistics before =
+        CesiumResponseBuffer::getStatistics();
+    const double fetchStart = FPlatformTime::Seconds();
+
+    std::shared_ptr<CesiumAsync::IAssetRequest> pRequest;
+    accessor.get(getAsyncSystem(), TCHAR_TO_UTF8(*uri), {})
+        .thenInMainThread(
+            [&pRequest](std::shared_ptr<CesiumAsync::IAssetRequest>&& pResult) {
+              pRequest = std::move(pResult);
+            });
+    while (!pRequest) {
+      accessor.tick();
+      getAsyncSystem().dispatchMainThreadTasks();
+    }
+
+    const double fetchEnd = FPlatformTime::Seconds();
+    const CesiumResponseBuffer::Statistics after =
+        CesiumResponseBuffer::getStatistics();
+
+    const CesiumAsync::IAssetResponse* pResponse = pRequest->response();
+    if (!TestNotNull("response", pResponse)) {
+      continue;
+    }
+
+    CesiumGltfReader::GltfReaderResult result =
+        reader.readGltf(pResponse->data());
+    const double parseEnd = FPlatformTime::Seconds();
+
+    TestTrue("parsed", result.model.has_value());
+
+    // The previous file path read the whole file and then copied it into the
+    // response.
+    const double copyStart = FPlatformTime::Seconds();
+    {
+      TArray64<uint8> data;
+      TestTrue("read for copy", FFileHelper::LoadFileToArray(data, *filename));
+      TArray64<uint8> copy(data);
+    }
+    const double copyEnd = FPlatformTime::Seconds();
+
+    UE_LOG(
+        LogCesium,
+        Display,
+        TEXT(
+            "%u MB tile: %llu bytes adopted, %llu bytes mapped, fetch %.2f ms, parse %.2f ms, previous read and copy %.2f ms"),
+        megabytes,
+        uint64(after.adoptedBytes - before.adoptedBytes),
+        uint64(after.mappedBytes - before.mappedBytes),
+        (fetchEnd - fetchStart) * 1000.0,
+        (parseEnd - fetchEnd) * 1000.0,
+        (copyEnd - copyStart) * 1000.0);
+
+    IFileManager::Get().Delete(*filename);
+  }
+
+  IFileManager::Get().DeleteDirectory(*directory, false, true);
+
+  return true;
+}
@@ -0,0 +1,115 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumSubLevelIndex.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumSubLevelIndexSpec,
+    "Cesium.Unit.SubLevelIndex",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+const int32 SubLevelCount = 500;
+
+TArray<FVector> Centers;
+TArray<double> Radii;
+
+// The search that the index replaces.
+int32 FindClosestContainingLinear(const FVector& Position) const {
+  int32 closest = INDEX_NONE;
+  double closestDistance = TNumericLimits<double>::Max();
+  for (int32 i = 0; i < Centers.Num(); ++i) {
+    const double distance = FVector::Distance(Centers[i], Position);
+    if (distance < Radii[i] && distance < closestDistance) {
+      closest = i;
+      closestDistance = distance;
+    }
+  }
+  return closest;
+}
+
+END_DEFINE_SPEC(FCesiumSubLevelIndexSpec)
+
+void FCesiumSubLevelIndexSpec::Define() {
+  BeforeEach([this]() {
+    // Overlapping sub-levels of various sizes, spread around a point on the
+    // Earth's surface.
+    FRandomStream random(42);
+    Centers.Reset();
+    Radii.Reset();
+    for (int32 i = 0; i < SubLevelCount; ++i) {
+      Centers.Add(FVector(
+          6378137.0 + random.FRandRange(-100.0, 100.0),
+          random.FRandRange(-50000.0, 50000.0),
+          random.FRandRange(-50000.0, 50000.0)));
+      Radii.Add(random.FRandRange(100.0, 5000.0));
+    }
+  });
+
+  It("finds nothing when empty", [this]() {
+    FCesiumSubLevelIndex index;
+    index.Build();
+    TestEqual("num", index.Num(), 0);
+    TestEqual(
+        "closest",
+        index.FindClosestContaining(FVector(6378137.0, 0.0, 0.0)),
+        INDEX_NONE);
+  });
+
+  It("finds the same sub-levels as a linear search", [this]() {
+    FCesiumSubLevelIndex index;
+    for (int32 i = 0; i < Centers.Num(); ++i) {
+      TestEqual("index", index.Add(Centers[i], Radii[i]), i);
+    }
+    index.Build();
+
+    FRandomStream random(7);
+    int32 foundCount = 0;
+    for (int32 i = 0; i < 2000; ++i) {
+      const FVector position(
+          6378137.0 + random.FRandRange(-1000.0, 1000.0),
+          random.FRandRange(-55000.0, 55000.0),
+          random.FRandRange(-55000.0, 55000.0));
+      const int32 expected = FindClosestContainingLinear(position);
+      TestEqual(
+          FString::Printf(TEXT("position %d"), i),
+          index.FindClosestContaining(position),
+          expected);
+      foundCount += expected != INDEX_NONE ? 1 : 0;
+    }
+    TestTrue("some inside", foundCount > 0);
+    TestTrue("some outside", foundCount < 2000);
+  });
+
+  It("excludes positions exactly on the load radius", [this]() {
+    FCesiumSubLevelIndex index;
+    index.Add(FVector(0.0, 0.0, 0.0), 10.0);
+    index.Build();
+    TestEqual(
+        "on radius",
+        index.FindClosestContaining(FVector(10.0, 0.0, 0.0)),
+        INDEX_NONE);
+    TestEqual(
+        "inside",
+        index.FindClosestContaining(FVector(9.0, 0.0, 0.0)),
+        0);
+  });
+
+  It("can be rebuilt", [this]() {
+    FCesiumSubLevelIndex index;
+    index.Add(FVector(0.0, 0.0, 0.0), 10.0);
+    index.Build();
+    index.Reset();
+    index.Add(FVector(100.0, 0.0, 0.0), 10.0);
+    index.Build();
+    TestEqual(
+        "old sub-level",
+        index.FindClosestContaining(FVector(0.0, 0.0, 0.0)),
+        INDEX_NONE);
+    TestEqual(
+        "new sub-level",
+        index.FindClosestContaining(FVector(100.0, 0.0, 0.0)),
+        0);
+  });
+}
@@ -0,0 +1,160 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTieredCacheDatabase.h"
+#include "Misc/AutomationTest.h"
+#include <future>
+#include <map>
+
+using namespace CesiumAsync;
+
+namespace {
+
+/**
+ * @brief An in-memory stand-in for the Sqlite cache, whose reads can be held
+ * up to interleave them with other calls.
+ */
+class FakeDiskCache : public ICacheDatabase {
+public:
+  virtual std::optional<CacheItem>
+  getEntry(const std::string& key) const override {
+    if (this->holdReads) {
+      this->readStarted.set_value();
+      this->readReleased.get_future().wait();
+    }
+
+    std::scoped_lock<std::mutex> lock(this->mutex);
+    auto it = this->items.find(key);
+    if (it == this->items.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override {
+    std::scoped_lock<std::mutex> lock(this->mutex);
+    this->items.insert_or_assign(
+        key,
+        CacheItem(
+            expiryTime,
+            CacheRequest(requestHeaders, requestMethod, url),
+            CacheResponse(
+                statusCode,
+                responseHeaders,
+                std::vector<std::byte>(
+                    responseData.begin(),
+                    responseData.end()))));
+    ++this->writes;
+    return true;
+  }
+
+  virtual bool prune() override { return true; }
+
+  virtual bool clearAll() override {
+    std::scoped_lock<std::mutex> lock(this->mutex);
+    this->items.clear();
+    return true;
+  }
+
+  bool holdReads = false;
+  mutable std::promise<void> readStarted;
+  mutable std::promise<void> readReleased;
+  int32 writes = 0;
+
+private:
+  mutable std::mutex mutex;
+  std::map<std::string, CacheItem> items;
+};
+
+void store(ICacheDatabase& cache, const std::string& key, char value) {
+  const std::byte data[] = {std::byte(value)};
+  cache.storeEntry(
+      key,
+      std::time(nullptr) + 3600,
+      "https://example.com/" + key,
+      "GET",
+      HttpHeaders(),
+      200,
+      HttpHeaders(),
+      gsl::span<const std::byte>(data));
+}
+
+char read(const ICacheDatabase& cache, const std::string& key) {
+  std::optional<CacheItem> item = cache.getEntry(key);
+  if (!item || item->cacheResponse.data.empty()) {
+    return 0;
+  }
+  return char(item->cacheResponse.data[0]);
+}
+
+} // namespace
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTieredCacheDatabaseSpec,
+    "Cesium.Unit.TieredCacheDatabase",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumTieredCacheDatabaseSpec)
+
+void FCesiumTieredCacheDatabaseSpec::Define() {
+  It("does not promote a read older than a concurrent store", [this]() {
+    auto pDisk = std::make_shared<FakeDiskCache>();
+    store(*pDisk, "tile", 'a');
+
+    CesiumTieredCacheDatabase cache(pDisk, 1024 * 1024, 1024 * 1024, 16);
+    pDisk->holdReads = true;
+    std::future<char> staleRead = std::async(std::launch::async, [&cache]() {
+      return read(cache, "tile");
+    });
+
+    // Store a newer version while the lookup is reading the old one.
+    pDisk->readStarted.get_future().wait();
+    store(cache, "tile", 'b');
+    pDisk->readReleased.set_value();
+    TestEqual("concurrent read", staleRead.get(), 'a');
+
+    pDisk->holdReads = false;
+    TestEqual("read after the store", read(cache, "tile"), 'b');
+    cache.flush();
+    TestEqual("read after the write", read(cache, "tile"), 'b');
+  });
+
+  It("does not promote a read older than a clear", [this]() {
+    auto pDisk = std::make_shared<FakeDiskCache>();
+    store(*pDisk, "tile", 'a');
+
+    CesiumTieredCacheDatabase cache(pDisk, 1024 * 1024, 1024 * 1024, 16);
+    pDisk->holdReads = true;
+    std::future<char> staleRead = std::async(std::launch::async, [&cache]() {
+      return read(cache, "tile");
+    });
+
+    pDisk->readStarted.get_future().wait();
+    cache.clearAll();
+    pDisk->readReleased.set_value();
+    staleRead.get();
+
+    pDisk->holdReads = false;
+    TestEqual("read after the clear", read(cache, "tile"), char(0));
+  });
+
+  It("writes stores synchronously after flushAndStop", [this]() {
+    auto pDisk = std::make_shared<FakeDiskCache>();
+    CesiumTieredCacheDatabase cache(pDisk, 1024 * 1024, 1024 * 1024, 16);
+
+    store(cache, "queued", 'a');
+    cache.flushAndStop();
+    TestEqual("queued store written", pDisk->writes, 1);
+
+    store(cache, "direct", 'b');
+    TestEqual("later store written", pDisk->writes, 2);
+    TestEqual("later store read", read(*pDisk, "direct"), 'b');
+  });
+}
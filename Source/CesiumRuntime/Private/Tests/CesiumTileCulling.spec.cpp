@@ -0,0 +1,86 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTileCulling.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTileCullingSpec,
+    "Cesium.Unit.TileCulling",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+// Not a multiple of the vector width, so that the scalar tail is tested too.
+const int32 TileCount = 103;
+
+FCesiumTileBoundsBatch CreateBounds() {
+  FRandomStream random(42);
+  FCesiumTileBoundsBatch bounds;
+  for (int32 i = 0; i < TileCount; ++i) {
+    const FVector center(
+        random.FRandRange(-1000.0, 1000.0),
+        random.FRandRange(-1000.0, 1000.0),
+        random.FRandRange(-1000.0, 1000.0));
+    const FVector extent(
+        random.FRandRange(1.0, 200.0),
+        random.FRandRange(1.0, 200.0),
+        random.FRandRange(1.0, 200.0));
+    bounds.Add(FBoxSphereBounds(center, extent, extent.Size()));
+  }
+  return bounds;
+}
+
+END_DEFINE_SPEC(FCesiumTileCullingSpec)
+
+void FCesiumTileCullingSpec::Define() {
+  It("stores bounds as boxes", [this]() {
+    FCesiumTileBoundsBatch bounds;
+    const FBoxSphereBounds tile(
+        FVector(1.0, 2.0, 3.0),
+        FVector(4.0, 5.0, 6.0),
+        10.0);
+    TestEqual("index", bounds.Add(tile), 0);
+    TestEqual("num", bounds.Num(), 1);
+    TestEqual("center", bounds.GetCenter(0), tile.Origin);
+    TestEqual("extent", bounds.GetExtent(0), tile.BoxExtent);
+    TestEqual("box", bounds.GetBox(0), tile.GetBox());
+
+    bounds.Reset();
+    TestEqual("num after reset", bounds.Num(), 0);
+  });
+
+  It("culls the same tiles as FBox::Intersect", [this]() {
+    const FCesiumTileBoundsBatch bounds = CreateBounds();
+    const FBox box(
+        FVector(-300.0, -200.0, -100.0),
+        FVector(300.0, 400.0, 500.0));
+
+    TArray<bool> culled;
+    culled.Init(false, bounds.Num());
+    CesiumTileCulling::cullOutsideBox(bounds, box, culled);
+
+    int32 culledCount = 0;
+    for (int32 i = 0; i < bounds.Num(); ++i) {
+      TestEqual(
+          FString::Printf(TEXT("tile %d"), i),
+          culled[i],
+          !box.Intersect(bounds.GetBox(i)));
+      culledCount += culled[i] ? 1 : 0;
+    }
+    TestTrue("some culled", culledCount > 0);
+    TestTrue("some kept", culledCount < bounds.Num());
+  });
+
+  It("keeps tiles that are already culled", [this]() {
+    const FCesiumTileBoundsBatch bounds = CreateBounds();
+    const FBox everything(FVector(-1.0e6), FVector(1.0e6));
+
+    TArray<bool> culled;
+    culled.Init(true, bounds.Num());
+    CesiumTileCulling::cullOutsideBox(bounds, everything, culled);
+
+    for (int32 i = 0; i < bounds.Num(); ++i) {
+      TestTrue(FString::Printf(TEXT("tile %d"), i), culled[i]);
+    }
+  });
+}
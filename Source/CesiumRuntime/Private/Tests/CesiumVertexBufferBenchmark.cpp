@@ -0,0 +1,205 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumGltf/Model.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumGltfReader/GltfReader.h"
+#include "CesiumGltfSpecUtility.h"
+#include "CesiumRuntime.h"
+#include "CreateGltfOptions.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include <glm/glm.hpp>
+#include <optional>
+#include <vector>
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCesiumVertexBufferStaging,
+    "Cesium.Performance.GltfComponent.VertexBufferStaging",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::PerfFilter)
+
+using namespace CesiumGltf;
+
+namespace {
+
+const int32 Iterations = 20;
+const int32 GridSize = 256;
+
+struct BenchmarkModel {
+  FString name;
+  Model model;
+  bool alwaysIncludeTangents = false;
+};
+
+/**
+ * Creates a single-primitive model with a GridSize x GridSize grid of
+ * vertices, roughly a photogrammetry tile. Without normals, the loader
+ * generates flat normals; with tangents requested but not given, it
+ * generates them.
+ */
+Model createGridModel(bool withNormals, bool withTangents, bool withColors) {
+  std::vector<glm::vec3> positions;
+  std::vector<glm::vec3> normals;
+  std::vector<glm::vec4> tangents;
+  std::vector<glm::vec2> texCoords;
+  std::vector<glm::vec4> colors;
+  for (int32 y = 0; y < GridSize; ++y) {
+    for (int32 x = 0; x < GridSize; ++x) {
+      const float u = float(x) / float(GridSize - 1);
+      const float v = float(y) / float(GridSize - 1);
+      positions.emplace_back(u, v, 0.1f * glm::sin(10.0f * u) * glm::cos(v));
+      normals.emplace_back(0.0f, glm::sin(u), glm::cos(u));
+      tangents.emplace_back(1.0f, 0.0f, 0.0f, 1.0f);
+      texCoords.emplace_back(u, v);
+      colors.emplace_back(u, v, 0.0f, 1.0f);
+    }
+  }
+
+  std::vector<uint32_t> indices;
+  for (int32 y = 0; y < GridSize - 1; ++y) {
+    for (int32 x = 0; x < GridSize - 1; ++x) {
+      const uint32_t i = uint32_t(y * GridSize + x);
+      indices.insert(
+          indices.end(),
+          {i, i + 1, i + GridSize, i + 1, i + GridSize + 1, i + GridSize});
+    }
+  }
+
+  Model model;
+  MeshPrimitive& primitive =
+      model.meshes.emplace_back().primitives.emplace_back();
+  CreateAttributeForPrimitive(
+      model,
+      primitive,
+      "POSITION",
+      AccessorSpec::Type::VEC3,
+      AccessorSpec::ComponentType::FLOAT,
+      positions);
+  model.accessors[primitive.attributes["POSITION"]].min = {0.0, 0.0, -0.1};
+  model.accessors[primitive.attributes["POSITION"]].max = {1.0, 1.0, 0.1};
+  if (withNormals) {
+    CreateAttributeForPrimitive(
+        model,
+        primitive,
+        "NORMAL",
+        AccessorSpec::Type::VEC3,
+        AccessorSpec::ComponentType::FLOAT,
+        normals);
+  }
+  if (withTangents) {
+    CreateAttributeForPrimitive(
+        model,
+        primitive,
+        "TANGENT",
+        AccessorSpec::Type::VEC4,
+        AccessorSpec::ComponentType::FLOAT,
+        tangents);
+  }
+  CreateAttributeForPrimitive(
+      model,
+      primitive,
+      "TEXCOORD_0",
+      AccessorSpec::Type::VEC2,
+      AccessorSpec::ComponentType::FLOAT,
+      texCoords);
+  if (withColors) {
+    CreateAttributeForPrimitive(
+        model,
+        primitive,
+        "COLOR_0",
+        AccessorSpec::Type::VEC4,
+        AccessorSpec::ComponentType::FLOAT,
+        colors);
+  }
+  CreateIndicesForPrimitive(
+      model,
+      primitive,
+      AccessorSpec::ComponentType::UNSIGNED_INT,
+      indices);
+
+  model.nodes.emplace_back().mesh = 0;
+  model.scenes.emplace_back().nodes.push_back(0);
+  model.scene = 0;
+  return model;
+}
+
+/**
+ * Reads the binary glTF given with -CesiumVertexBufferBenchmarkModel=<path>
+ * on the command line, if any.
+ */
+std::optional<Model> readModelFromCommandLine(FString& filename) {
+  if (!FParse::Value(
+          FCommandLine::Get(),
+          TEXT("CesiumVertexBufferBenchmarkModel="),
+          filename)) {
+    return std::nullopt;
+  }
+
+  TArray<uint8> data;
+  if (!FFileHelper::LoadFileToArray(data, *filename)) {
+    UE_LOG(LogCesium, Warning, TEXT("Could not read %s."), *filename);
+    return std::nullopt;
+  }
+
+  CesiumGltfReader::GltfReader reader{};
+  CesiumGltfReader::GltfReaderResult result =
+      reader.readGltf(gsl::span<const std::byte>(
+          reinterpret_cast<const std::byte*>(data.GetData()),
+          size_t(data.Num())));
+  return std::move(result.model);
+}
+
+} // namespace
+
+bool FCesiumVertexBufferStaging::RunTest(const FString& Parameters) {
+  // Representative primitives: an indexed photogrammetry tile, a tile without
+  // normals that is de-indexed for flat normals, a BIM primitive with
+  // tangents and vertex colors, and a primitive whose tangents are generated
+  // and then welded. A real model can be added from the command line.
+  std::vector<BenchmarkModel> models;
+  models.push_back(
+      {TEXT("Photogrammetry"), createGridModel(true, false, false)});
+  models.push_back(
+      {TEXT("Flat-shaded"), createGridModel(false, false, false)});
+  models.push_back(
+      {TEXT("Tangents and colors"), createGridModel(true, true, true)});
+  models.push_back(
+      {TEXT("Generated tangents"), createGridModel(true, false, false), true});
+
+  FString filename;
+  std::optional<Model> maybeFileModel = readModelFromCommandLine(filename);
+  if (maybeFileModel) {
+    models.push_back(
+        {FPaths::GetCleanFilename(filename), std::move(*maybeFileModel)});
+  }
+
+  for (const BenchmarkModel& benchmarkModel : models) {
+    double seconds = 0.0;
+    for (int32 i = 0; i < Iterations; ++i) {
+      // The loader may modify the model, so every iteration gets a copy.
+      Model model = benchmarkModel.model;
+      CreateGltfOptions::CreateModelOptions options;
+      options.pModel = &model;
+      options.alwaysIncludeTangents = benchmarkModel.alwaysIncludeTangents;
+
+      const double start = FPlatformTime::Seconds();
+      TUniquePtr<UCesiumGltfComponent::HalfConstructed> pResult =
+          UCesiumGltfComponent::CreateOffGameThread(glm::dmat4x4(1.0), options);
+      seconds += FPlatformTime::Seconds() - start;
+
+      TestTrue("loaded", pResult.IsValid());
+    }
+
+    UE_LOG(
+        LogCesium,
+        Display,
+        TEXT("%s: %.2f ms per load."),
+        *benchmarkModel.name,
+        seconds * 1000.0 / double(Iterations));
+  }
+
+  return true;
+}
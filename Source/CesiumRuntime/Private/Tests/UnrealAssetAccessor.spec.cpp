@@ -1,4 +1,5 @@
 #include "Async/Async.h"
+#include "Cesium3tzSpecUtility.h"
 #include "CesiumAsync/IAssetResponse.h"
 #include "CesiumRuntime.h"
 #include "HAL/PlatformFileManager.h"
@@ -6,6 +7,7 @@
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "UnrealAssetAccessor.h"
+#include <cstring>
 
 BEGIN_DEFINE_SPEC(
     FUnrealAssetAccessorSpec,
@@ -17,10 +19,14 @@ FString Filename;
 std::string randomText = "Some random text.";
 IPlatformFile* FileManager;
 
-void TestAccessorRequest(const FString& Uri, const std::string& expectedData) {
+void TestAccessorRequest(
+    const FString& Uri,
+    const std::string& expectedData,
+    bool useMemoryMapping = false) {
   bool done = false;
 
   UnrealAssetAccessor accessor{};
+  accessor.setUseMemoryMappedFiles(useMemoryMapping);
   accessor.get(getAsyncSystem(), TCHAR_TO_UTF8(*Uri), {})
       .thenInMainThread(
           [&](std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest) {
@@ -44,6 +50,60 @@ void TestAccessorRequest(const FString& Uri, const std::string& expectedData) {
   }
 }
 
+/**
+ * Requests the given URLs, which must be on a host that refuses connections,
+ * and returns the order in which they completed. Only one request is in flight
+ * at a time, so this is the order in which they were sent. The first URL is
+ * sent right away; `reorder` is called while the others are queued behind it.
+ */
+template <typename Func>
+std::vector<std::string>
+getCompletionOrder(const std::vector<std::string>& urls, Func&& reorder) {
+  UnrealAssetAccessor accessor{};
+  accessor.setMaximumRequestsPerHost(1);
+
+  std::vector<std::string> completed;
+  for (const std::string& url : urls) {
+    accessor.get(getAsyncSystem(), url, {})
+        .thenInMainThread(
+            [&completed, url](std::shared_ptr<CesiumAsync::IAssetRequest>&&) {
+              completed.push_back(url);
+            })
+        .catchInMainThread(
+            [&completed, url](std::exception&&) { completed.push_back(url); });
+  }
+
+  TestEqual(
+      "queued",
+      accessor.getRequestStatistics().queued,
+      int32(urls.size()) - 1);
+  reorder(accessor);
+
+  while (completed.size() < urls.size()) {
+    accessor.tick();
+    getAsyncSystem().dispatchMainThreadTasks();
+  }
+
+  return completed;
+}
+
+FString WriteArchive(bool includeIndex) {
+  std::vector<std::byte> text(randomText.size());
+  std::memcpy(text.data(), randomText.data(), randomText.size());
+
+  const FString ArchiveFilename = Filename + TEXT(".3tz");
+  FFileHelper::SaveArrayToFile(
+      Create3tzArchive(
+          {{"tileset.json", {}}, {"tiles/0/0/0.glb", text}},
+          includeIndex),
+      *ArchiveFilename);
+
+  FString Uri = TEXT("file:///") + ArchiveFilename;
+  Uri.ReplaceCharInline('\\', '/');
+  Uri.ReplaceInline(TEXT(" "), TEXT("%20"));
+  return Uri;
+}
+
 END_DEFINE_SPEC(FUnrealAssetAccessorSpec)
 
 void FUnrealAssetAccessorSpec::Define() {
@@ -58,7 +118,10 @@ void FUnrealAssetAccessorSpec::Define() {
         FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
   });
 
-  AfterEach([this]() { FileManager->DeleteFile(*Filename); });
+  AfterEach([this]() {
+    FileManager->DeleteFile(*Filename);
+    FileManager->DeleteFile(*(Filename + TEXT(".3tz")));
+  });
 
   It("Fails with non-existant file:/// URLs", [this]() {
     FString Uri = TEXT("file:///") + Filename;
@@ -76,4 +139,163 @@ void FUnrealAssetAccessorSpec::Define() {
 
     TestAccessorRequest(Uri, randomText);
   });
+
+  It("Can access file:/// URLs with memory mapping", [this]() {
+    FString Uri = TEXT("file:///") + Filename;
+    Uri.ReplaceCharInline('\\', '/');
+    Uri.ReplaceInline(TEXT(" "), TEXT("%20"));
+
+    TestAccessorRequest(Uri, randomText, true);
+  });
+
+  It("Fails with non-existant file:/// URLs with memory mapping", [this]() {
+    FString Uri = TEXT("file:///") + Filename;
+    Uri.ReplaceCharInline('\\', '/');
+    Uri.ReplaceInline(TEXT(" "), TEXT("%20"));
+    Uri += ".bogusExtension";
+
+    TestAccessorRequest(Uri, "", true);
+  });
+
+  It("Can access files in 3TZ archives", [this]() {
+    const FString ArchiveUri = WriteArchive(true);
+    TestAccessorRequest(ArchiveUri + TEXT("/tiles/0/0/0.glb"), randomText);
+    TestAccessorRequest(ArchiveUri + TEXT("/tileset.json"), "");
+  });
+
+  It("Can access files in 3TZ archives without an index", [this]() {
+    const FString ArchiveUri = WriteArchive(false);
+    TestAccessorRequest(ArchiveUri + TEXT("/tiles/0/0/0.glb"), randomText);
+  });
+
+  It("Fails with files missing from 3TZ archives", [this]() {
+    const FString ArchiveUri = WriteArchive(true);
+    TestAccessorRequest(ArchiveUri + TEXT("/tiles/0/0/1.glb"), "");
+  });
+
+  It("Can cancel queued requests", [this]() {
+    UnrealAssetAccessor accessor{};
+    accessor.setMaximumRequestsPerHost(1);
+
+    // Nothing listens on this port, so the first request eventually fails,
+    // and the second one stays queued behind it until then.
+    const std::string first = "http://localhost:1/first";
+    const std::string second = "http://localhost:1/second";
+
+    bool firstDone = false;
+    bool secondCancelled = false;
+
+    accessor.get(getAsyncSystem(), first, {})
+        .thenInMainThread(
+            [&](std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest) {
+              firstDone = true;
+            })
+        .catchInMainThread([&](std::exception&& e) { firstDone = true; });
+    accessor.get(getAsyncSystem(), second, {})
+        .thenInMainThread(
+            [&](std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest) {})
+        .catchInMainThread([&](std::exception&& e) {
+          secondCancelled = std::string(e.what()) == "Request cancelled.";
+        });
+
+    UnrealAssetAccessor::RequestStatistics before =
+        accessor.getRequestStatistics();
+    TestEqual("queued before cancel", before.queued, 1);
+    TestEqual("in flight before cancel", before.inFlight, 1);
+
+    TestEqual("cancelled requests", accessor.cancelRequest(second), 1);
+
+    while (!firstDone) {
+      accessor.tick();
+      getAsyncSystem().dispatchMainThreadTasks();
+    }
+    getAsyncSystem().dispatchMainThreadTasks();
+
+    TestTrue("second request was cancelled", secondCancelled);
+
+    UnrealAssetAccessor::RequestStatistics after =
+        accessor.getRequestStatistics();
+    TestEqual("queued after cancel", after.queued, 0);
+    TestEqual("in flight after cancel", after.inFlight, 0);
+    TestEqual("cancelled", after.cancelled, int64(1));
+    TestEqual("completed", after.completed, int64(1));
+  });
+
+  It("Completes requests that fail to start", [this]() {
+    UnrealAssetAccessor accessor{};
+    accessor.setMaximumRequestsPerHost(1);
+
+    // An empty URL is rejected by ProcessRequest before anything is sent.
+    bool failed = false;
+    accessor.get(getAsyncSystem(), "", {})
+        .thenInMainThread(
+            [&](std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest) {})
+        .catchInMainThread([&](std::exception&& e) { failed = true; });
+
+    while (!failed) {
+      accessor.tick();
+      getAsyncSystem().dispatchMainThreadTasks();
+    }
+
+    UnrealAssetAccessor::RequestStatistics statistics =
+        accessor.getRequestStatistics();
+    TestEqual("queued", statistics.queued, 0);
+    TestEqual("in flight", statistics.inFlight, 0);
+    TestEqual("completed", statistics.completed, int64(1));
+  });
+
+  It("Sends queued requests in the order of their priority", [this]() {
+    const std::vector<std::string> urls{
+        "http://localhost:1/first",
+        "http://localhost:1/a",
+        "http://localhost:1/b",
+        "http://localhost:1/c"};
+
+    // Requests issued in the same frame are sent in the order they were
+    // issued.
+    std::vector<std::string> order =
+        getCompletionOrder(urls, [](UnrealAssetAccessor&) {});
+    TestTrue("issue order", order == urls);
+
+    order = getCompletionOrder(urls, [](UnrealAssetAccessor& accessor) {
+      accessor.setRequestPriority("http://localhost:1/c", 1.0e9);
+    });
+    TestTrue(
+        "raised priority",
+        order == std::vector<std::string>{
+                     "http://localhost:1/first",
+                     "http://localhost:1/c",
+                     "http://localhost:1/a",
+                     "http://localhost:1/b"});
+
+    order = getCompletionOrder(urls, [](UnrealAssetAccessor& accessor) {
+      // Applied on the next tick, before the queued requests are sent.
+      accessor.setPriorityFunction(
+          [](const std::string& url, double) -> std::optional<double> {
+            if (url == "http://localhost:1/a") {
+              return 1.0;
+            }
+            if (url == "http://localhost:1/b") {
+              return 3.0;
+            }
+            return 2.0;
+          });
+    });
+    TestTrue(
+        "priority function",
+        order == std::vector<std::string>{
+                     "http://localhost:1/first",
+                     "http://localhost:1/b",
+                     "http://localhost:1/c",
+                     "http://localhost:1/a"});
+  });
+
+  It("Ignores URLs of hosts that were never requested", [this]() {
+    UnrealAssetAccessor accessor{};
+    accessor.setRequestPriority("http://localhost:1/unknown", 1.0);
+    TestEqual(
+        "cancelled requests",
+        accessor.cancelRequest("http://localhost:1/unknown"),
+        0);
+  });
 }
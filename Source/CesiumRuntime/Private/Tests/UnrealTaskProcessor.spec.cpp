@@ -0,0 +1,153 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "Misc/AutomationTest.h"
+#include "UnrealTaskProcessor.h"
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+BEGIN_DEFINE_SPEC(
+    FUnrealTaskProcessorSpec,
+    "Cesium.Unit.UnrealTaskProcessor",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+void WaitFor(const std::atomic<int32>& counter, int32 expected) {
+  const double timeout = FPlatformTime::Seconds() + 10.0;
+  while (counter.load() < expected && FPlatformTime::Seconds() < timeout) {
+    FPlatformProcess::Sleep(0.001f);
+  }
+}
+
+END_DEFINE_SPEC(FUnrealTaskProcessorSpec)
+
+void FUnrealTaskProcessorSpec::Define() {
+  It("Runs every task", [this]() {
+    UnrealTaskProcessor processor(4);
+    TestEqual("thread count", processor.getThreadCount(), 4);
+
+    std::atomic<int32> completed = 0;
+    for (int32 i = 0; i < 1000; ++i) {
+      processor.startTask([&completed]() { ++completed; });
+    }
+    WaitFor(completed, 1000);
+
+    TestEqual("completed", completed.load(), 1000);
+  });
+
+  It("Runs tasks in the lane of the thread that started them", [this]() {
+    UnrealTaskProcessor processor(2);
+
+    std::atomic<int32> completed = 0;
+    std::atomic<int32> lowLaneTasks = 0;
+    {
+      UnrealTaskProcessor::ScopedLane lane(UnrealTaskProcessor::Lane::Low);
+      processor.startTask([&]() {
+        // A continuation started from within the task stays in its lane.
+        processor.startTask([&]() {
+          if (UnrealTaskProcessor::getCurrentLane() ==
+              UnrealTaskProcessor::Lane::Low) {
+            ++lowLaneTasks;
+          }
+          ++completed;
+        });
+        ++completed;
+      });
+    }
+    TestTrue(
+        "lane is restored",
+        UnrealTaskProcessor::getCurrentLane() ==
+            UnrealTaskProcessor::Lane::Normal);
+
+    WaitFor(completed, 2);
+    processor.shutdown();
+    TestEqual("low-lane continuations", lowLaneTasks.load(), 1);
+
+    UnrealTaskProcessor::LaneStatistics low =
+        processor.getLaneStatistics(UnrealTaskProcessor::Lane::Low);
+    TestEqual("low-lane completed", low.completed, int64(2));
+    TestEqual("low-lane queued", low.queued, 0);
+  });
+
+  It("Runs high-priority tasks ahead of queued low-priority tasks", [this]() {
+    UnrealTaskProcessor processor(1);
+
+    // Keep the only worker busy while the other tasks are queued.
+    std::atomic<bool> release = false;
+    std::atomic<int32> started = 0;
+    processor.startTask([&]() {
+      ++started;
+      while (!release.load()) {
+        FPlatformProcess::Sleep(0.001f);
+      }
+    });
+    WaitFor(started, 1);
+
+    std::mutex mutex;
+    std::vector<UnrealTaskProcessor::Lane> order;
+    auto record = [&]() {
+      std::lock_guard<std::mutex> lock(mutex);
+      order.push_back(UnrealTaskProcessor::getCurrentLane());
+    };
+
+    {
+      UnrealTaskProcessor::ScopedLane lane(UnrealTaskProcessor::Lane::Low);
+      for (int32 i = 0; i < 10; ++i) {
+        processor.startTask(record);
+      }
+    }
+    {
+      UnrealTaskProcessor::ScopedLane lane(UnrealTaskProcessor::Lane::High);
+      processor.startTask(record);
+    }
+
+    TestEqual(
+        "queued low-priority tasks",
+        processor.getLaneStatistics(UnrealTaskProcessor::Lane::Low).queued,
+        10);
+
+    release = true;
+    processor.shutdown();
+
+    TestEqual("tasks run", int32(order.size()), 11);
+    if (!order.empty()) {
+      TestTrue(
+          "the high-priority task ran first",
+          order.front() == UnrealTaskProcessor::Lane::High);
+    }
+  });
+
+  It("Rethrows exceptions from parallelFor in the caller", [this]() {
+    UnrealTaskProcessor processor(4);
+
+    std::atomic<int32> calls = 0;
+    bool caught = false;
+    try {
+      processor.parallelFor(100, [&calls](int32 i) {
+        ++calls;
+        if (i == 50) {
+          throw std::runtime_error("failed");
+        }
+      });
+    } catch (const std::runtime_error& e) {
+      caught = std::string(e.what()) == "failed";
+    }
+
+    TestTrue("exception was rethrown", caught);
+    TestEqual("calls", calls.load(), 100);
+  });
+
+  It("Runs queued tasks on shutdown", [this]() {
+    UnrealTaskProcessor processor(1);
+
+    std::atomic<int32> completed = 0;
+    for (int32 i = 0; i < 100; ++i) {
+      processor.startTask([&completed]() { ++completed; });
+    }
+    processor.shutdown();
+
+    TestEqual("completed", completed.load(), 100);
+  });
+}
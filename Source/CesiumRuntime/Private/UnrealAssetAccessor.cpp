@@ -4,10 +4,14 @@
 #include "Async/Async.h"
 #include "Async/AsyncWork.h"
 
+#include "Cesium3tzArchive.h"
 #include "CesiumAsync/AsyncSystem.h"
 #include "CesiumAsync/IAssetRequest.h"
 #include "CesiumAsync/IAssetResponse.h"
+#include "CesiumMappedFile.h"
+#include "CesiumResponseBuffer.h"
 #include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
 #include "HttpManager.h"
 #include "HttpModule.h"
 #include "Interfaces/IHttpRequest.h"
@@ -16,12 +20,33 @@
 #include "Misc/App.h"
 #include "Misc/EngineVersion.h"
 #include "Misc/FileHelper.h"
+#include "UnrealTaskProcessor.h"
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstring>
+#include <functional>
+#include <iterator>
+#include <mutex>
 #include <optional>
 #include <set>
+#include <stdexcept>
+#include <unordered_map>
 #include <uriparser/Uri.h>
 
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Queued Requests"),
+    STAT_CesiumQueuedRequests,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("In-Flight Requests"),
+    STAT_CesiumInFlightRequests,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Cancelled Requests"),
+    STAT_CesiumCancelledRequests,
+    STATGROUP_Cesium);
+
 namespace {
 
 CesiumAsync::HttpHeaders parseHeaders(const TArray<FString>& unrealHeaders) {
@@ -60,9 +85,9 @@ public:
 
   virtual gsl::span<const std::byte> data() const override {
     const TArray<uint8>& content = this->_pResponse->GetContent();
-    return gsl::span(
+    return gsl::span<const std::byte>(
         reinterpret_cast<const std::byte*>(content.GetData()),
-        content.Num());
+        size_t(content.Num()));
   }
 
 private:
@@ -102,8 +127,358 @@ private:
 
 } // namespace
 
+namespace {
+
+using RequestPromise =
+    CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>>;
+
+/**
+ * Set by whichever of the completion delegate or a failed `ProcessRequest`
+ * settles a request first, so that its promise is settled only once.
+ */
+using CompletionFlag = std::shared_ptr<std::atomic<bool>>;
+
+/**
+ * Ends the trace scope of a request that is settled without its completion
+ * delegate being called, because it was cancelled or failed to start.
+ */
+using EndTrace = std::function<void()>;
+
+std::string getHost(const std::string& url) {
+  size_t start = url.find("://");
+  start = start == std::string::npos ? 0 : start + 3;
+  size_t end = url.find_first_of("/?#", start);
+  return url.substr(
+      start,
+      end == std::string::npos ? std::string::npos : end - start);
+}
+
+} // namespace
+
+/**
+ * @brief Queues GET requests per host, sends them in priority order, and
+ * limits the number of requests in flight to each host.
+ */
+class UnrealAssetRequestScheduler {
+public:
+  explicit UnrealAssetRequestScheduler(int32 maximumRequestsPerHost)
+      : _maximumRequestsPerHost(FMath::Max(maximumRequestsPerHost, 1)) {}
+
+  void enqueue(
+      const std::string& host,
+      const std::string& url,
+      const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& pRequest,
+      const RequestPromise& promise,
+      const CompletionFlag& pCompleted,
+      EndTrace&& endTrace) {
+    {
+      std::scoped_lock<std::mutex> lock(this->_mutex);
+      HostQueue& hostQueue = this->_hosts[host];
+      hostQueue.queued.push_back(QueuedRequest{
+          pRequest,
+          url,
+          double(GFrameCounter),
+          this->_nextSequence++,
+          promise,
+          pCompleted,
+          std::move(endTrace)});
+      std::push_heap(
+          hostQueue.queued.begin(),
+          hostQueue.queued.end(),
+          lowerPriority);
+      ++this->_queued;
+      SET_DWORD_STAT(STAT_CesiumQueuedRequests, this->_queued);
+    }
+
+    this->dispatch();
+  }
+
+  void onRequestComplete(const std::string& host) {
+    {
+      std::scoped_lock<std::mutex> lock(this->_mutex);
+      auto it = this->_hosts.find(host);
+      if (it != this->_hosts.end()) {
+        --it->second.inFlight;
+        this->eraseIfIdle(it);
+      }
+      --this->_inFlight;
+      ++this->_completed;
+      SET_DWORD_STAT(STAT_CesiumInFlightRequests, this->_inFlight);
+    }
+
+    this->dispatch();
+  }
+
+  void dispatch() {
+    std::vector<std::pair<std::string, QueuedRequest>> toSend;
+
+    {
+      std::scoped_lock<std::mutex> lock(this->_mutex);
+      for (auto it = this->_hosts.begin(); it != this->_hosts.end();) {
+        HostQueue& hostQueue = it->second;
+        while (hostQueue.inFlight < this->_maximumRequestsPerHost &&
+               !hostQueue.queued.empty()) {
+          std::pop_heap(
+              hostQueue.queued.begin(),
+              hostQueue.queued.end(),
+              lowerPriority);
+          toSend.emplace_back(it->first, std::move(hostQueue.queued.back()));
+          hostQueue.queued.pop_back();
+          ++hostQueue.inFlight;
+          --this->_queued;
+          ++this->_inFlight;
+        }
+
+        // Hosts whose queued requests were all cancelled are removed here.
+        it = this->eraseIfIdle(it);
+      }
+      SET_DWORD_STAT(STAT_CesiumQueuedRequests, this->_queued);
+      SET_DWORD_STAT(STAT_CesiumInFlightRequests, this->_inFlight);
+    }
+
+    // Sending may complete a request synchronously, which re-enters the
+    // scheduler, so this must happen outside the lock. A request that cannot
+    // be sent still counts as in flight until it is completed here.
+    for (auto& [host, request] : toSend) {
+      if (!request.pRequest->ProcessRequest() &&
+          !request.pCompleted->exchange(true)) {
+        request.endTrace();
+        request.promise.reject(std::runtime_error("Request failed to start."));
+        this->onRequestComplete(host);
+      }
+    }
+  }
+
+  void updatePriorities() {
+    std::vector<QueuedRequest> cancelled;
+
+    {
+      std::scoped_lock<std::mutex> lock(this->_mutex);
+      if (!this->_priorityFunction) {
+        return;
+      }
+
+      for (auto& [host, hostQueue] : this->_hosts) {
+        this->reprioritize(
+            hostQueue,
+            [this](const QueuedRequest& request) {
+              return this->_priorityFunction(request.url, request.priority);
+            },
+            cancelled);
+      }
+    }
+
+    rejectCancelled(cancelled);
+  }
+
+  void setRequestPriority(const std::string& url, double priority) {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    auto it = this->_hosts.find(getHost(url));
+    if (it == this->_hosts.end()) {
+      return;
+    }
+
+    std::vector<QueuedRequest> cancelled;
+    this->reprioritize(
+        it->second,
+        [&url, priority](const QueuedRequest& request) {
+          return request.url == url ? priority : request.priority;
+        },
+        cancelled);
+  }
+
+  int32 cancelRequest(const std::string& url) {
+    std::vector<QueuedRequest> cancelled;
+
+    {
+      std::scoped_lock<std::mutex> lock(this->_mutex);
+      auto it = this->_hosts.find(getHost(url));
+      if (it == this->_hosts.end()) {
+        return 0;
+      }
+
+      this->reprioritize(
+          it->second,
+          [&url](const QueuedRequest& request) -> std::optional<double> {
+            if (request.url == url) {
+              return std::nullopt;
+            }
+            return request.priority;
+          },
+          cancelled);
+    }
+
+    rejectCancelled(cancelled);
+    return int32(cancelled.size());
+  }
+
+  void setMaximumRequestsPerHost(int32 maximumRequestsPerHost) {
+    {
+      std::scoped_lock<std::mutex> lock(this->_mutex);
+      this->_maximumRequestsPerHost = FMath::Max(maximumRequestsPerHost, 1);
+    }
+    this->dispatch();
+  }
+
+  void setPriorityFunction(UnrealAssetAccessor::PriorityFunction&& function) {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    this->_priorityFunction = std::move(function);
+  }
+
+  UnrealAssetAccessor::RequestStatistics getStatistics() const {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    UnrealAssetAccessor::RequestStatistics result;
+    result.queued = this->_queued;
+    result.inFlight = this->_inFlight;
+    result.completed = this->_completed;
+    result.cancelled = this->_cancelled;
+    return result;
+  }
+
+private:
+  struct QueuedRequest {
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> pRequest;
+    std::string url;
+    double priority;
+    uint64 sequence;
+    RequestPromise promise;
+    CompletionFlag pCompleted;
+    EndTrace endTrace;
+  };
+
+  struct HostQueue {
+    int32 inFlight = 0;
+    // A max-heap ordered by lowerPriority.
+    std::vector<QueuedRequest> queued;
+  };
+
+  using HostIterator = std::unordered_map<std::string, HostQueue>::iterator;
+
+  /**
+   * Removes the host if it has no queued or in-flight requests, so that the
+   * hosts of past requests are not visited by every dispatch. Returns the
+   * iterator to the next host. Must be called with the lock held.
+   */
+  HostIterator eraseIfIdle(HostIterator it) {
+    if (it->second.inFlight == 0 && it->second.queued.empty()) {
+      return this->_hosts.erase(it);
+    }
+    return std::next(it);
+  }
+
+  static bool lowerPriority(const QueuedRequest& a, const QueuedRequest& b) {
+    if (a.priority != b.priority) {
+      return a.priority < b.priority;
+    }
+    // Among requests of equal priority, the older one goes first.
+    return a.sequence > b.sequence;
+  }
+
+  static void rejectCancelled(std::vector<QueuedRequest>& cancelled) {
+    for (QueuedRequest& request : cancelled) {
+      request.endTrace();
+      request.promise.reject(std::runtime_error("Request cancelled."));
+    }
+  }
+
+  /**
+   * Computes a new priority for each queued request of the host, moves the
+   * requests for which no priority is returned into `cancelled`, and restores
+   * the heap order. Must be called with the lock held.
+   */
+  template <typename Func>
+  void reprioritize(
+      HostQueue& hostQueue,
+      Func&& computePriority,
+      std::vector<QueuedRequest>& cancelled) {
+    size_t kept = 0;
+    for (size_t i = 0; i < hostQueue.queued.size(); ++i) {
+      QueuedRequest& request = hostQueue.queued[i];
+      std::optional<double> priority = computePriority(request);
+      if (!priority) {
+        cancelled.emplace_back(std::move(request));
+        continue;
+      }
+
+      request.priority = *priority;
+      if (kept != i) {
+        hostQueue.queued[kept] = std::move(request);
+      }
+      ++kept;
+    }
+
+    const int32 removed = int32(hostQueue.queued.size() - kept);
+    while (hostQueue.queued.size() > kept) {
+      hostQueue.queued.pop_back();
+    }
+
+    std::make_heap(
+        hostQueue.queued.begin(),
+        hostQueue.queued.end(),
+        lowerPriority);
+
+    if (removed > 0) {
+      this->_queued -= removed;
+      this->_cancelled += removed;
+      SET_DWORD_STAT(STAT_CesiumQueuedRequests, this->_queued);
+      INC_DWORD_STAT_BY(STAT_CesiumCancelledRequests, removed);
+    }
+  }
+
+  mutable std::mutex _mutex;
+  std::unordered_map<std::string, HostQueue> _hosts;
+  int32 _maximumRequestsPerHost;
+  UnrealAssetAccessor::PriorityFunction _priorityFunction;
+  uint64 _nextSequence = 0;
+  int32 _queued = 0;
+  int32 _inFlight = 0;
+  int64 _completed = 0;
+  int64 _cancelled = 0;
+};
+
+/**
+ * The 3D Tiles archives opened by an accessor, by filename. An archive is
+ * opened by the first request for a file within it and then shared by every
+ * later request.
+ */
+class UnrealAssetArchiveCache {
+public:
+  std::shared_ptr<const Cesium3tzArchive>
+  getArchive(const std::string& filename) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    auto it = this->_archives.find(filename);
+    if (it != this->_archives.end()) {
+      return it->second;
+    }
+
+    // Opening is done with the lock held so that concurrent requests for
+    // files in the same archive do not index it more than once. Failures are
+    // not remembered, so an archive may be written after it was first
+    // requested.
+    std::shared_ptr<const Cesium3tzArchive> pArchive =
+        Cesium3tzArchive::open(UTF8_TO_TCHAR(filename.c_str()));
+    if (pArchive) {
+      this->_archives.emplace(filename, pArchive);
+    }
+    return pArchive;
+  }
+
+private:
+  std::mutex _mutex;
+  std::unordered_map<std::string, std::shared_ptr<const Cesium3tzArchive>>
+      _archives;
+};
+
 UnrealAssetAccessor::UnrealAssetAccessor()
-    : _userAgent(), _cesiumRequestHeaders() {
+    : _userAgent(),
+      _cesiumRequestHeaders(),
+      _pScheduler(std::make_shared<UnrealAssetRequestScheduler>(
+          GetDefault<UCesiumRuntimeSettings>()
+              ->MaxSimultaneousRequestsPerHost)),
+      _pArchives(std::make_shared<UnrealAssetArchiveCache>()),
+      _useMemoryMappedFiles(
+          GetDefault<UCesiumRuntimeSettings>()->UseMemoryMappedLocalFiles) {
   FString OsVersion, OsSubVersion;
   FPlatformMisc::GetOSVersions(OsVersion, OsSubVersion);
   OsVersion += " " + FPlatformMisc::GetOSVersion();
@@ -161,52 +536,88 @@ UnrealAssetAccessor::get(
     return getFromFile(asyncSystem, url, headers);
   }
 
-  const FString& userAgent = this->_userAgent;
-  const TMap<FString, FString>& cesiumRequestHeaders =
-      this->_cesiumRequestHeaders;
+  RequestPromise promise =
+      asyncSystem.createPromise<std::shared_ptr<CesiumAsync::IAssetRequest>>();
+  CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>> future =
+      promise.getFuture();
 
-  return asyncSystem.createFuture<std::shared_ptr<CesiumAsync::IAssetRequest>>(
-      [&url, &headers, &userAgent, &cesiumRequestHeaders](const auto& promise) {
-        FHttpModule& httpModule = FHttpModule::Get();
-        TSharedRef<IHttpRequest, ESPMode::ThreadSafe> pRequest =
-            httpModule.CreateRequest();
-        pRequest->SetURL(UTF8_TO_TCHAR(url.c_str()));
+  FHttpModule& httpModule = FHttpModule::Get();
+  TSharedRef<IHttpRequest, ESPMode::ThreadSafe> pRequest =
+      httpModule.CreateRequest();
+  pRequest->SetURL(UTF8_TO_TCHAR(url.c_str()));
 
-        for (const auto& header : headers) {
-          pRequest->SetHeader(
-              UTF8_TO_TCHAR(header.first.c_str()),
-              UTF8_TO_TCHAR(header.second.c_str()));
-        }
+  for (const auto& header : headers) {
+    pRequest->SetHeader(
+        UTF8_TO_TCHAR(header.first.c_str()),
+        UTF8_TO_TCHAR(header.second.c_str()));
+  }
 
-        for (const auto& header : cesiumRequestHeaders) {
-          pRequest->SetHeader(header.Key, header.Value);
-        }
+  for (const auto& header : this->_cesiumRequestHeaders) {
+    pRequest->SetHeader(header.Key, header.Value);
+  }
 
-        pRequest->AppendToHeader(TEXT("User-Agent"), userAgent);
+  pRequest->AppendToHeader(TEXT("User-Agent"), this->_userAgent);
+
+  std::string host = getHost(url);
+  std::weak_ptr<UnrealAssetRequestScheduler> pWeakScheduler =
+      this->_pScheduler;
+  CompletionFlag pCompleted = std::make_shared<std::atomic<bool>>(false);
+
+  // The response is processed in the lane of the work that requested it,
+  // rather than in the lane of the thread that completes the request.
+  const UnrealTaskProcessor::Lane lane = UnrealTaskProcessor::getCurrentLane();
+
+  pRequest->OnProcessRequestComplete().BindLambda(
+      [promise,
+       host,
+       pWeakScheduler,
+       pCompleted,
+       lane,
+       CESIUM_TRACE_LAMBDA_CAPTURE_TRACK()](
+          FHttpRequestPtr pRequest,
+          FHttpResponsePtr pResponse,
+          bool connectedSuccessfully) mutable {
+        if (pCompleted->exchange(true)) {
+          return;
+        }
 
-        pRequest->OnProcessRequestComplete().BindLambda(
-            [promise, CESIUM_TRACE_LAMBDA_CAPTURE_TRACK()](
-                FHttpRequestPtr pRequest,
-                FHttpResponsePtr pResponse,
-                bool connectedSuccessfully) mutable {
-              CESIUM_TRACE_USE_CAPTURED_TRACK();
-              CESIUM_TRACE_END_IN_TRACK("requestAsset");
+        UnrealTaskProcessor::ScopedLane taskLane(lane);
+
+        CESIUM_TRACE_USE_CAPTURED_TRACK();
+        CESIUM_TRACE_END_IN_TRACK("requestAsset");
+
+        if (connectedSuccessfully) {
+          promise.resolve(
+              std::make_unique<UnrealAssetRequest>(pRequest, pResponse));
+        } else {
+          switch (pRequest->GetStatus()) {
+          case EHttpRequestStatus::Failed_ConnectionError:
+            promise.reject(std::runtime_error("Connection failed."));
+            break;
+          default:
+            promise.reject(std::runtime_error("Request failed."));
+          }
+        }
 
-              if (connectedSuccessfully) {
-                promise.resolve(
-                    std::make_unique<UnrealAssetRequest>(pRequest, pResponse));
-              } else {
-                switch (pRequest->GetStatus()) {
-                case EHttpRequestStatus::Failed_ConnectionError:
-                  promise.reject(std::runtime_error("Connection failed."));
-                default:
-                  promise.reject(std::runtime_error("Request failed."));
-                }
-              }
-            });
+        std::shared_ptr<UnrealAssetRequestScheduler> pScheduler =
+            pWeakScheduler.lock();
+        if (pScheduler) {
+          pScheduler->onRequestComplete(host);
+        }
+      });
 
-        pRequest->ProcessRequest();
+  this->_pScheduler->enqueue(
+      host,
+      url,
+      pRequest,
+      promise,
+      pCompleted,
+      [CESIUM_TRACE_LAMBDA_CAPTURE_TRACK()]() mutable {
+        CESIUM_TRACE_USE_CAPTURED_TRACK();
+        CESIUM_TRACE_END_IN_TRACK("requestAsset");
       });
+
+  return future;
 }
 
 CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
@@ -250,11 +661,21 @@ UnrealAssetAccessor::request(
             reinterpret_cast<const uint8*>(contentPayload.data()),
             contentPayload.size()));
 
+        CompletionFlag pCompleted = std::make_shared<std::atomic<bool>>(false);
+        const UnrealTaskProcessor::Lane lane =
+            UnrealTaskProcessor::getCurrentLane();
+
         pRequest->OnProcessRequestComplete().BindLambda(
-            [promise](
+            [promise, pCompleted, lane](
                 FHttpRequestPtr pRequest,
                 FHttpResponsePtr pResponse,
                 bool connectedSuccessfully) {
+              if (pCompleted->exchange(true)) {
+                return;
+              }
+
+              UnrealTaskProcessor::ScopedLane taskLane(lane);
+
               if (connectedSuccessfully) {
                 promise.resolve(
                     std::make_unique<UnrealAssetRequest>(pRequest, pResponse));
@@ -262,19 +683,57 @@ UnrealAssetAccessor::request(
                 switch (pRequest->GetStatus()) {
                 case EHttpRequestStatus::Failed_ConnectionError:
                   promise.reject(std::runtime_error("Connection failed."));
+                  break;
                 default:
                   promise.reject(std::runtime_error("Request failed."));
                 }
               }
             });
 
-        pRequest->ProcessRequest();
+        if (!pRequest->ProcessRequest() && !pCompleted->exchange(true)) {
+          promise.reject(std::runtime_error("Request failed to start."));
+        }
       });
 }
 
 void UnrealAssetAccessor::tick() noexcept {
+  // Requests completed by the HTTP manager immediately send the next queued
+  // ones, so the priorities are updated first.
+  this->_pScheduler->updatePriorities();
+
   FHttpManager& manager = FHttpModule::Get().GetHttpManager();
   manager.Tick(0.0f);
+
+  this->_pScheduler->dispatch();
+}
+
+void UnrealAssetAccessor::setMaximumRequestsPerHost(
+    int32 maximumRequestsPerHost) {
+  this->_pScheduler->setMaximumRequestsPerHost(maximumRequestsPerHost);
+}
+
+void UnrealAssetAccessor::setUseMemoryMappedFiles(bool useMemoryMappedFiles) {
+  this->_useMemoryMappedFiles = useMemoryMappedFiles;
+}
+
+void UnrealAssetAccessor::setPriorityFunction(
+    PriorityFunction priorityFunction) {
+  this->_pScheduler->setPriorityFunction(std::move(priorityFunction));
+}
+
+void UnrealAssetAccessor::setRequestPriority(
+    const std::string& url,
+    double priority) {
+  this->_pScheduler->setRequestPriority(url, priority);
+}
+
+int32 UnrealAssetAccessor::cancelRequest(const std::string& url) {
+  return this->_pScheduler->cancelRequest(url);
+}
+
+UnrealAssetAccessor::RequestStatistics
+UnrealAssetAccessor::getRequestStatistics() const {
+  return this->_pScheduler->getStatistics();
 }
 
 namespace {
@@ -285,8 +744,10 @@ public:
   UnrealFileAssetRequestResponse(
       std::string&& url,
       uint16_t statusCode,
-      TArray64<uint8>&& data)
-      : _url(std::move(url)), _statusCode(statusCode), _data(data) {}
+      CesiumResponseBuffer&& body)
+      : _url(std::move(url)),
+        _statusCode(statusCode),
+        _body(std::move(body)) {}
 
   virtual const std::string& method() const { return getMethod; }
 
@@ -305,9 +766,7 @@ public:
   virtual std::string contentType() const override { return std::string(); }
 
   virtual gsl::span<const std::byte> data() const override {
-    return gsl::span<const std::byte>(
-        reinterpret_cast<const std::byte*>(this->_data.GetData()),
-        size_t(this->_data.Num()));
+    return this->_body.span();
   }
 
 private:
@@ -316,7 +775,7 @@ private:
 
   std::string _url;
   uint16_t _statusCode;
-  TArray64<uint8> _data;
+  CesiumResponseBuffer _body;
 };
 
 const std::string UnrealFileAssetRequestResponse::getMethod = "GET";
@@ -348,8 +807,13 @@ class FCesiumReadFileWorker : public FNonAbandonableTask {
 public:
   FCesiumReadFileWorker(
       const std::string& url,
-      const CesiumAsync::AsyncSystem& asyncSystem)
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::shared_ptr<UnrealAssetArchiveCache>& pArchives,
+      bool useMemoryMapping)
       : _url(url),
+        _pArchives(pArchives),
+        _useMemoryMapping(useMemoryMapping),
+        _lane(UnrealTaskProcessor::getCurrentLane()),
         _promise(
             asyncSystem
                 .createPromise<std::shared_ptr<CesiumAsync::IAssetRequest>>()) {
@@ -366,24 +830,66 @@ public:
   }
 
   void DoWork() {
-    FString filename =
-        UTF8_TO_TCHAR(convertFileUriToFilename(this->_url).c_str());
+    UnrealTaskProcessor::ScopedLane taskLane(this->_lane);
+
+    const std::string utf8Filename = convertFileUriToFilename(this->_url);
+
+    std::string archiveFilename;
+    std::string pathInArchive;
+    if (Cesium3tzArchive::splitArchivePath(
+            utf8Filename,
+            archiveFilename,
+            pathInArchive)) {
+      std::shared_ptr<const Cesium3tzArchive> pArchive =
+          this->_pArchives->getArchive(archiveFilename);
+      if (pArchive) {
+        std::optional<CesiumResponseBuffer> maybeBody =
+            pArchive->read(pathInArchive);
+        const uint16_t statusCode = maybeBody ? 200 : 404;
+        this->_promise.resolve(std::make_shared<UnrealFileAssetRequestResponse>(
+            std::move(this->_url),
+            statusCode,
+            maybeBody ? std::move(*maybeBody) : CesiumResponseBuffer()));
+        return;
+      }
+      // A directory whose name ends in .3tz is read like any other.
+    }
+
+    FString filename = UTF8_TO_TCHAR(utf8Filename.c_str());
+
+    if (this->_useMemoryMapping) {
+      std::shared_ptr<const CesiumMappedFile> pMapped =
+          CesiumMappedFile::open(filename);
+      if (pMapped) {
+        gsl::span<const std::byte> range = pMapped->span();
+        this->_promise.resolve(std::make_shared<UnrealFileAssetRequestResponse>(
+            std::move(this->_url),
+            200,
+            CesiumResponseBuffer(std::move(pMapped), range)));
+        return;
+      }
+      // Empty files and platforms without mapping support are read instead.
+    }
+
     TArray64<uint8> data;
     if (FFileHelper::LoadFileToArray(data, *filename)) {
       this->_promise.resolve(std::make_shared<UnrealFileAssetRequestResponse>(
           std::move(this->_url),
           200,
-          std::move(data)));
+          CesiumResponseBuffer(std::move(data))));
     } else {
       this->_promise.resolve(std::make_shared<UnrealFileAssetRequestResponse>(
           std::move(this->_url),
           404,
-          TArray64<uint8>()));
+          CesiumResponseBuffer()));
     }
   }
 
 private:
   std::string _url;
+  std::shared_ptr<UnrealAssetArchiveCache> _pArchives;
+  bool _useMemoryMapping;
+  UnrealTaskProcessor::Lane _lane;
   CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>> _promise;
 };
 
@@ -396,8 +902,11 @@ UnrealAssetAccessor::getFromFile(
     const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
   check(!url.empty());
 
-  auto pTaskOwner =
-      std::make_unique<FAsyncTask<FCesiumReadFileWorker>>(url, asyncSystem);
+  auto pTaskOwner = std::make_unique<FAsyncTask<FCesiumReadFileWorker>>(
+      url,
+      asyncSystem,
+      this->_pArchives,
+      this->_useMemoryMappedFiles.load());
 
   FAsyncTask<FCesiumReadFileWorker>* pTask = pTaskOwner.get();
 
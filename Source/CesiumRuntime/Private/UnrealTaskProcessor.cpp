@@ -2,11 +2,472 @@
 
 #include "UnrealTaskProcessor.h"
 #include "Async/Async.h"
+#include "CesiumRuntime.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
 #include "Misc/QueuedThreadPool.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("High-Priority Queued Tasks"),
+    STAT_CesiumHighPriorityQueuedTasks,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Normal-Priority Queued Tasks"),
+    STAT_CesiumNormalPriorityQueuedTasks,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Low-Priority Queued Tasks"),
+    STAT_CesiumLowPriorityQueuedTasks,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Running Tasks"),
+    STAT_CesiumRunningTasks,
+    STATGROUP_Cesium);
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("High-Priority Completed Tasks"),
+    STAT_CesiumHighPriorityCompletedTasks,
+    STATGROUP_Cesium);
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Normal-Priority Completed Tasks"),
+    STAT_CesiumNormalPriorityCompletedTasks,
+    STATGROUP_Cesium);
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Low-Priority Completed Tasks"),
+    STAT_CesiumLowPriorityCompletedTasks,
+    STATGROUP_Cesium);
+
+namespace {
+
+using Lane = UnrealTaskProcessor::Lane;
+
+thread_local Lane currentLane = Lane::Normal;
+
+// The pool and index of the worker running on this thread, if any.
+thread_local const UnrealTaskWorkerPool* pCurrentPool = nullptr;
+thread_local size_t currentWorkerIndex = 0;
+
+void adjustQueuedStat(Lane lane, bool queued) {
+  switch (lane) {
+  case Lane::High:
+    if (queued) {
+      INC_DWORD_STAT(STAT_CesiumHighPriorityQueuedTasks);
+    } else {
+      DEC_DWORD_STAT(STAT_CesiumHighPriorityQueuedTasks);
+    }
+    break;
+  case Lane::Normal:
+    if (queued) {
+      INC_DWORD_STAT(STAT_CesiumNormalPriorityQueuedTasks);
+    } else {
+      DEC_DWORD_STAT(STAT_CesiumNormalPriorityQueuedTasks);
+    }
+    break;
+  case Lane::Low:
+    if (queued) {
+      INC_DWORD_STAT(STAT_CesiumLowPriorityQueuedTasks);
+    } else {
+      DEC_DWORD_STAT(STAT_CesiumLowPriorityQueuedTasks);
+    }
+    break;
+  }
+}
+
+void incrementCompletedStat(Lane lane) {
+  switch (lane) {
+  case Lane::High:
+    INC_DWORD_STAT(STAT_CesiumHighPriorityCompletedTasks);
+    break;
+  case Lane::Normal:
+    INC_DWORD_STAT(STAT_CesiumNormalPriorityCompletedTasks);
+    break;
+  case Lane::Low:
+    INC_DWORD_STAT(STAT_CesiumLowPriorityCompletedTasks);
+    break;
+  }
+}
+
+void runInLaneScope(Lane lane, const std::function<void()>& f) {
+  // Separate scopes so that Unreal Insights shows each lane's tasks apart.
+  switch (lane) {
+  case Lane::High: {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::HighPriorityTask)
+    f();
+    break;
+  }
+  case Lane::Normal: {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::NormalPriorityTask)
+    f();
+    break;
+  }
+  case Lane::Low: {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LowPriorityTask)
+    f();
+    break;
+  }
+  }
+}
+
+} // namespace
+
+/**
+ * A fixed-size pool of worker threads with one work-stealing queue per worker
+ * and lane. A worker pushes the tasks it starts onto its own queues and takes
+ * the newest of them first, which keeps a tile's chain of continuations on
+ * one thread. Other threads' tasks are distributed round-robin. An idle
+ * worker steals the oldest task of another worker.
+ */
+class UnrealTaskWorkerPool {
+public:
+  explicit UnrealTaskWorkerPool(int32 threadCount)
+      : _workers(), _lanes(), _pendingTasks(0), _nextWorker(0), _stop(false) {
+    this->_workers.reserve(size_t(threadCount));
+    for (int32 i = 0; i < threadCount; ++i) {
+      this->_workers.emplace_back(std::make_unique<Worker>());
+    }
+
+    // Start the threads only once every worker exists, because they steal
+    // from each other.
+    for (int32 i = 0; i < threadCount; ++i) {
+      Worker& worker = *this->_workers[size_t(i)];
+      worker.pRunnable = MakeUnique<WorkerRunnable>(*this, size_t(i));
+      worker.pThread.Reset(FRunnableThread::Create(
+          worker.pRunnable.Get(),
+          *FString::Printf(TEXT("CesiumWorker %d"), i),
+          0,
+          TPri_BelowNormal));
+    }
+  }
+
+  ~UnrealTaskWorkerPool() noexcept { this->shutdown(); }
+
+  /**
+   * Queues a task, unless the pool has been shut down.
+   *
+   * @return Whether the task was queued. If not, `f` is left unchanged.
+   */
+  bool push(std::function<void()>& f, Lane lane) {
+    {
+      std::lock_guard<std::mutex> lock(this->_sleepMutex);
+      if (this->_stop) {
+        return false;
+      }
+      ++this->_pendingTasks;
+    }
+
+    const size_t workerIndex =
+        pCurrentPool == this
+            ? currentWorkerIndex
+            : this->_nextWorker.fetch_add(1, std::memory_order_relaxed) %
+                  this->_workers.size();
+    Worker& worker = *this->_workers[workerIndex];
+    LaneCounters& counters = this->_lanes[size_t(lane)];
+
+    counters.queued.fetch_add(1, std::memory_order_relaxed);
+    adjustQueuedStat(lane, true);
+    {
+      std::lock_guard<std::mutex> lock(worker.mutex);
+      worker.queues[size_t(lane)].push_back(
+          Task{std::move(f), FPlatformTime::Cycles64()});
+    }
+
+    this->_wakeUp.notify_one();
+    return true;
+  }
+
+  void shutdown() {
+    {
+      std::lock_guard<std::mutex> lock(this->_sleepMutex);
+      if (this->_stop) {
+        return;
+      }
+      this->_stop = true;
+    }
+    this->_wakeUp.notify_all();
+
+    for (std::unique_ptr<Worker>& pWorker : this->_workers) {
+      if (pWorker->pThread) {
+        pWorker->pThread->WaitForCompletion();
+        pWorker->pThread.Reset();
+      }
+    }
+  }
+
+  int32 getThreadCount() const { return int32(this->_workers.size()); }
+
+  UnrealTaskProcessor::LaneStatistics getLaneStatistics(Lane lane) const {
+    const LaneCounters& counters = this->_lanes[size_t(lane)];
+
+    UnrealTaskProcessor::LaneStatistics result;
+    result.queued = counters.queued.load(std::memory_order_relaxed);
+    result.running = counters.running.load(std::memory_order_relaxed);
+    result.completed = counters.completed.load(std::memory_order_relaxed);
+    if (result.completed > 0) {
+      result.averageWaitMilliseconds =
+          FPlatformTime::ToMilliseconds64(
+              counters.waitCycles.load(std::memory_order_relaxed)) /
+          double(result.completed);
+    }
+    return result;
+  }
+
+private:
+  struct Task {
+    std::function<void()> f;
+    uint64 queuedCycles;
+  };
+
+  class WorkerRunnable : public FRunnable {
+  public:
+    WorkerRunnable(UnrealTaskWorkerPool& pool, size_t index)
+        : _pool(pool), _index(index) {}
+
+    virtual uint32 Run() override {
+      this->_pool.workerMain(this->_index);
+      return 0;
+    }
+
+  private:
+    UnrealTaskWorkerPool& _pool;
+    size_t _index;
+  };
+
+  struct Worker {
+    std::mutex mutex;
+    std::array<std::deque<Task>, UnrealTaskProcessor::LaneCount> queues;
+    TUniquePtr<WorkerRunnable> pRunnable;
+    TUniquePtr<FRunnableThread> pThread;
+  };
+
+  struct LaneCounters {
+    std::atomic<int32> queued{0};
+    std::atomic<int32> running{0};
+    std::atomic<int64> completed{0};
+    std::atomic<uint64> waitCycles{0};
+  };
+
+  void workerMain(size_t index) {
+    pCurrentPool = this;
+    currentWorkerIndex = index;
+
+    for (;;) {
+      Task task;
+      Lane lane;
+      if (this->takeTask(index, task, lane)) {
+        this->runTask(task, lane);
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(this->_sleepMutex);
+      if (this->_pendingTasks == 0) {
+        // Queued tasks are still run after a shutdown is requested.
+        if (this->_stop) {
+          break;
+        }
+        this->_wakeUp.wait(lock, [this]() {
+          return this->_pendingTasks > 0 || this->_stop;
+        });
+      }
+    }
+
+    pCurrentPool = nullptr;
+  }
+
+  bool takeTask(size_t index, Task& task, Lane& lane) {
+    const size_t workerCount = this->_workers.size();
+
+    for (int32 i = 0; i < UnrealTaskProcessor::LaneCount; ++i) {
+      if (this->_lanes[size_t(i)].queued.load(std::memory_order_relaxed) ==
+          0) {
+        continue;
+      }
+
+      for (size_t offset = 0; offset < workerCount; ++offset) {
+        const bool own = offset == 0;
+        Worker& worker = *this->_workers[(index + offset) % workerCount];
+
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        std::deque<Task>& queue = worker.queues[size_t(i)];
+        if (queue.empty()) {
+          continue;
+        }
+
+        if (own) {
+          task = std::move(queue.back());
+          queue.pop_back();
+        } else {
+          task = std::move(queue.front());
+          queue.pop_front();
+        }
+        lane = Lane(i);
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  void runTask(Task& task, Lane lane) {
+    LaneCounters& counters = this->_lanes[size_t(lane)];
+    {
+      std::lock_guard<std::mutex> lock(this->_sleepMutex);
+      --this->_pendingTasks;
+    }
+    counters.queued.fetch_sub(1, std::memory_order_relaxed);
+    adjustQueuedStat(lane, false);
+    counters.running.fetch_add(1, std::memory_order_relaxed);
+    INC_DWORD_STAT(STAT_CesiumRunningTasks);
+    counters.waitCycles.fetch_add(
+        FPlatformTime::Cycles64() - task.queuedCycles,
+        std::memory_order_relaxed);
+
+    // Continuations started by this task stay in its lane.
+    currentLane = lane;
+    runInLaneScope(lane, task.f);
+    task.f = nullptr;
+
+    counters.running.fetch_sub(1, std::memory_order_relaxed);
+    DEC_DWORD_STAT(STAT_CesiumRunningTasks);
+    counters.completed.fetch_add(1, std::memory_order_relaxed);
+    incrementCompletedStat(lane);
+  }
+
+  std::vector<std::unique_ptr<Worker>> _workers;
+  std::array<LaneCounters, UnrealTaskProcessor::LaneCount> _lanes;
+
+  // Guards _pendingTasks and _stop, so that workers cannot miss a wake-up
+  // and do not stop while tasks are still queued.
+  std::mutex _sleepMutex;
+  std::condition_variable _wakeUp;
+  int64 _pendingTasks;
+
+  std::atomic<size_t> _nextWorker;
+  bool _stop;
+};
+
+UnrealTaskProcessor::ScopedLane::ScopedLane(Lane lane) noexcept
+    : _previousLane(currentLane) {
+  currentLane = lane;
+}
+
+UnrealTaskProcessor::ScopedLane::~ScopedLane() noexcept {
+  currentLane = this->_previousLane;
+}
+
+UnrealTaskProcessor::UnrealTaskProcessor(int32 threadCount)
+    : _pPool(std::make_shared<UnrealTaskWorkerPool>(
+          threadCount > 0
+              ? threadCount
+              : FMath::Max(FPlatformMisc::NumberOfWorkerThreadsToSpawn(), 1))) {
+}
+
+UnrealTaskProcessor::~UnrealTaskProcessor() noexcept = default;
 
 void UnrealTaskProcessor::startTask(std::function<void()> f) {
+  if (this->_pPool->push(f, currentLane)) {
+    return;
+  }
+
   AsyncTask(ENamedThreads::Type::AnyBackgroundThreadNormalTask, [f]() {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::AsyncTask)
     f();
   });
 }
+
+namespace {
+
+/**
+ * The state shared by the calling thread and the helper tasks of
+ * UnrealTaskProcessor::parallelFor. Each of them claims indices until none
+ * are left. A helper task that starts after all indices have been claimed
+ * does nothing, so the caller only waits for the calls, not for the helpers.
+ * A call that throws still counts as completed, and the first exception is
+ * rethrown on the calling thread once every call has completed.
+ */
+struct ParallelForState {
+  ParallelForState(int32 count_, const std::function<void(int32)>& body_)
+      : count(count_), body(body_), nextIndex(0), completed(0) {}
+
+  void run() {
+    int32 index;
+    while ((index = this->nextIndex.fetch_add(1)) < this->count) {
+      try {
+        this->body(index);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (!this->pException) {
+          this->pException = std::current_exception();
+        }
+      }
+      if (this->completed.fetch_add(1) + 1 == this->count) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->done.notify_all();
+      }
+    }
+  }
+
+  void wait() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->done.wait(lock, [this]() {
+      return this->completed.load() == this->count;
+    });
+  }
+
+  const int32 count;
+  // Only called while indices remain, which is before the caller returns.
+  const std::function<void(int32)>& body;
+  std::atomic<int32> nextIndex;
+  std::atomic<int32> completed;
+  std::mutex mutex;
+  std::condition_variable done;
+  // Guarded by mutex.
+  std::exception_ptr pException;
+};
+
+} // namespace
+
+void UnrealTaskProcessor::parallelFor(
+    int32 count,
+    const std::function<void(int32)>& body) {
+  if (count <= 0) {
+    return;
+  }
+
+  auto pState = std::make_shared<ParallelForState>(count, body);
+
+  const int32 helperCount =
+      FMath::Min(count - 1, this->_pPool->getThreadCount());
+  for (int32 i = 0; i < helperCount; ++i) {
+    this->startTask([pState]() { pState->run(); });
+  }
+
+  pState->run();
+  pState->wait();
+
+  if (pState->pException) {
+    std::rethrow_exception(pState->pException);
+  }
+}
+
+void UnrealTaskProcessor::shutdown() { this->_pPool->shutdown(); }
+
+int32 UnrealTaskProcessor::getThreadCount() const {
+  return this->_pPool->getThreadCount();
+}
+
+UnrealTaskProcessor::LaneStatistics
+UnrealTaskProcessor::getLaneStatistics(Lane lane) const {
+  return this->_pPool->getLaneStatistics(lane);
+}
+
+/*static*/ UnrealTaskProcessor::Lane
+UnrealTaskProcessor::getCurrentLane() noexcept {
+  return currentLane;
+}
@@ -10,6 +10,7 @@
 #include "CesiumFeaturesMetadataComponent.h"
 #include "CesiumGeoreference.h"
 #include "CesiumPointCloudShading.h"
+#include "CesiumTileCulling.h"
 #include "CoreMinimal.h"
 #include "CustomDepthParameters.h"
 #include "Engine/EngineTypes.h"
@@ -19,8 +20,10 @@
 #include <PhysicsEngine/BodyInstance.h>
 #include <atomic>
 #include <chrono>
+#include <deque>
 #include <glm/mat4x4.hpp>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include "Cesium3DTileset.generated.h"
 
@@ -28,6 +31,10 @@ class UMaterialInterface;
 class ACesiumCartographicSelection;
 class ACesiumCameraManager;
 class UCesiumBoundingVolumePoolComponent;
+class UCesiumTilesetTransformComponent;
+class UCesiumGltfComponent;
+class UCesiumGltfPrimitiveComponent;
+class FCesiumPhysicsMeshCache;
 class CesiumViewExtension;
 struct FCesiumCamera;
 
@@ -237,6 +244,13 @@ private:
       Meta = (AllowPrivateAccess))
   UCesiumBoundingVolumePoolComponent* BoundingVolumePoolComponent = nullptr;
 
+  /**
+   * The component that glTF components are attached to when
+   * UseSharedTilesetTransform is enabled.
+   */
+  UPROPERTY(Transient)
+  UCesiumTilesetTransformComponent* TilesetTransformComponent = nullptr;
+
   /**
    * The custom view extension this tileset uses to pull renderer view
    * information.
@@ -413,6 +427,58 @@ public:
       meta = (ClampMin = 0))
   int32 LoadingDescendantLimit = 20;
 
+  /**
+   * The maximum time, in milliseconds, to spend each frame on the game thread
+   * creating the Unreal components of newly loaded tiles.
+   *
+   * A tile with many primitives may be created over several frames. It is
+   * only shown once all of its primitives exist. At least one primitive is
+   * created every frame, so loading always makes progress. Set this to 0 to
+   * create all loaded tiles as soon as possible.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading",
+      meta = (ClampMin = 0.0))
+  float MainThreadLoadingTimeLimit = 5.0f;
+
+  /**
+   * The maximum number of tiles whose Unreal components are completed each
+   * frame, or 0 for no limit.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading",
+      meta = (ClampMin = 0))
+  int32 MaximumTilesCreatedPerFrame = 0;
+
+  /**
+   * The maximum number of glTF primitives whose Unreal components are created
+   * each frame, or 0 for no limit.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading",
+      meta = (ClampMin = 0))
+  int32 MaximumPrimitivesCreatedPerFrame = 0;
+
+  /**
+   * The frame rate that tile creation on the game thread should try to
+   * preserve, or 0 to always use the full MainThreadLoadingTimeLimit.
+   *
+   * When the recent frame rate drops below this value, the time limit is
+   * scaled down proportionally, to as little as a quarter of its value.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading",
+      meta = (ClampMin = 0.0))
+  float MainThreadLoadingTargetFrameRate = 0.0f;
+
   /**
    * Whether to cull tiles that are outside the frustum.
    *
@@ -650,6 +716,23 @@ public:
   UFUNCTION(BlueprintImplementableEvent, Category = "Cesium|Tile Culling")
   bool CustomIsTileCulled(const FVector& Center, const FVector& Extent);
 
+  /**
+   * A function that culls a whole batch of tiles at once. It receives the
+   * world bounds of every tile that is about to be rendered, and sets the flag
+   * of each tile that should be culled instead.
+   */
+  using FNativeTileCullingCallback = TFunction<void(
+      const FCesiumTileBoundsBatch& Bounds,
+      TArray<bool>& Culled)>;
+
+  /**
+   * Sets the function used for custom tile culling when
+   * EvaluateCustomTileCulling is true. While a function is set, it replaces
+   * the per-tile CustomIsTileCulled event, which is then only used when no
+   * function is set. Pass an empty function to go back to the event.
+   */
+  void SetNativeTileCullingCallback(FNativeTileCullingCallback Callback);
+
   UPROPERTY(
     EditAnywhere,
     BlueprintReadWrite,
@@ -783,6 +866,55 @@ private:
       Category = "Cesium|Physics")
   bool CreatePhysicsMeshes = true;
 
+  /**
+   * Whether to build the physics meshes of tiles only when they are near a
+   * Cesium Collision Interest component, such as one attached to a Pawn or
+   * vehicle, instead of as soon as the tiles are loaded.
+   *
+   * The triangles of every tile are still kept, so that building a physics
+   * mesh later does not require loading the tile again, and so that
+   * LineTraceTiles can trace against tiles without a physics mesh. Tiles
+   * without a physics mesh do not collide with anything else.
+   *
+   * Like all collision of a tileset, these meshes only collide while their
+   * tiles are rendered. Tiles that are culled, for example because they are
+   * behind the camera, get no physics mesh even near an interest component.
+   * Disable EnableFrustumCulling, and any custom tile culling, if objects
+   * must collide with tiles outside of the view.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetCreatePhysicsMeshesOnDemand,
+      BlueprintSetter = SetCreatePhysicsMeshesOnDemand,
+      Category = "Cesium|Physics",
+      meta = (EditCondition = "CreatePhysicsMeshes"))
+  bool CreatePhysicsMeshesOnDemand = false;
+
+  /**
+   * The maximum number of physics meshes that start building each frame when
+   * they are created on demand, or 0 for no limit. The tiles closest to a
+   * collision interest component are built first.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Physics",
+      meta = (EditCondition = "CreatePhysicsMeshesOnDemand", ClampMin = 0))
+  int32 MaximumPhysicsMeshBuildsPerFrame = 4;
+
+  /**
+   * The maximum number of physics meshes kept when they are created on
+   * demand, or 0 for no limit. When there are more, the meshes of the tiles
+   * that have been away from all collision interest components the longest
+   * are released.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Physics",
+      meta = (EditCondition = "CreatePhysicsMeshesOnDemand", ClampMin = 0))
+  int32 MaximumCachedPhysicsMeshes = 256;
+
   /**
    * Whether to generate navigation collisions for this tileset.
    *
@@ -836,6 +968,24 @@ private:
       Category = "Cesium|Rendering")
   bool GenerateSmoothNormals = false;
 
+  /**
+   * Whether to weld vertices back together after generating flat normals or
+   * tangents for a tile.
+   *
+   * Generating flat normals or MikkTSpace tangents requires a separate vertex
+   * for every triangle corner. When this property is true, the corners of a
+   * glTF vertex that end up with identical normals and tangents share a single
+   * vertex again, so only the vertices along creases and UV seams remain
+   * duplicated. This adds a little load time, but can greatly reduce the
+   * vertex count and GPU memory of tiles that lack normals or tangents.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetWeldGeneratedVertices,
+      BlueprintSetter = SetWeldGeneratedVertices,
+      Category = "Cesium|Rendering")
+  bool WeldGeneratedVertices = true;
+
   /**
    * Whether to request and render the water mask.
    *
@@ -868,6 +1018,27 @@ private:
       meta = (DisplayName = "Ignore KHR_materials_unlit"))
   bool IgnoreKhrMaterialsUnlit = false;
 
+  /**
+   * Whether the tiles of this tileset share a single transform from the
+   * tileset's coordinate system to Unreal.
+   *
+   * By default, every glTF primitive combines that transform with its own
+   * transform, so every georeference or origin change recomputes the
+   * transform of each primitive in double precision. When this is enabled,
+   * the primitives keep their fixed, double-precision transform within the
+   * tileset instead, and such a change sets the transform of one shared
+   * parent component. Unreal still propagates the new transform to every
+   * attached primitive, so the cost of an origin shift still grows with the
+   * number of primitives, but each primitive is cheaper to update.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetUseSharedTilesetTransform,
+      BlueprintSetter = SetUseSharedTilesetTransform,
+      Category = "Cesium|Rendering",
+      AdvancedDisplay)
+  bool UseSharedTilesetTransform = false;
+
   /**
    * A custom Material to use to render opaque elements in this tileset, in
    * order to implement custom visual effects.
@@ -1013,6 +1184,28 @@ public:
   UFUNCTION(BlueprintSetter, Category = "Cesium|Physics")
   void SetCreatePhysicsMeshes(bool bCreatePhysicsMeshes);
 
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Physics")
+  bool GetCreatePhysicsMeshesOnDemand() const {
+    return CreatePhysicsMeshesOnDemand;
+  }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Physics")
+  void SetCreatePhysicsMeshesOnDemand(bool bCreatePhysicsMeshesOnDemand);
+
+  /**
+   * Traces a line against the visible tiles of this tileset, including the
+   * tiles whose physics meshes have not been built because they are created
+   * on demand. Only tiles that have collision enabled are considered.
+   *
+   * @param Start The start of the line, in Unreal world coordinates.
+   * @param End The end of the line, in Unreal world coordinates.
+   * @param OutHit The closest hit, if any.
+   * @return Whether the line hits a tile.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Physics")
+  bool
+  LineTraceTiles(const FVector& Start, const FVector& End, FHitResult& OutHit);
+
   UFUNCTION(BlueprintGetter, Category = "Cesium|Navigation")
   bool GetCreateNavCollision() const { return CreateNavCollision; }
 
@@ -1031,6 +1224,12 @@ public:
   UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
   void SetGenerateSmoothNormals(bool bGenerateSmoothNormals);
 
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetWeldGeneratedVertices() const { return WeldGeneratedVertices; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetWeldGeneratedVertices(bool bWeldGeneratedVertices);
+
   UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
   bool GetEnableWaterMask() const { return EnableWaterMask; }
 
@@ -1042,6 +1241,14 @@ public:
   UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
   void SetIgnoreKhrMaterialsUnlit(bool bIgnoreKhrMaterialsUnlit);
 
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetUseSharedTilesetTransform() const {
+    return UseSharedTilesetTransform;
+  }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetUseSharedTilesetTransform(bool bUseSharedTilesetTransform);
+
   UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
   UMaterialInterface* GetMaterial() const { return Material; }
 
@@ -1104,6 +1311,23 @@ public:
    */
   const glm::dmat4& GetCesiumTilesetToUnrealRelativeWorldTransform() const;
 
+  /**
+   * This method is not supposed to be called by clients. Gets the
+   * transformation that glTF primitives apply after their
+   * HighPrecisionNodeTransform, relative to the component returned by
+   * {@link GetGltfAttachParent}.
+   *
+   * This is the identity if UseSharedTilesetTransform is enabled, and
+   * {@link GetCesiumTilesetToUnrealRelativeWorldTransform} otherwise.
+   */
+  const glm::dmat4& GetCesiumTilesetToGltfTransform() const;
+
+  /**
+   * This method is not supposed to be called by clients. Gets the component
+   * that glTF components are attached to, creating it if necessary.
+   */
+  USceneComponent* GetGltfAttachParent();
+
   Cesium3DTilesSelection::Tileset* GetTileset() {
     return this->_pTileset.Get();
   }
@@ -1205,6 +1429,45 @@ private:
   void
   showTilesToRender(const std::vector<Cesium3DTilesSelection::Tile*>& tiles);
 
+  /**
+   * Continues creating the Unreal components of loaded tiles, within the
+   * per-frame limits of the tile loading properties.
+   */
+  void createPendingTiles();
+
+  /**
+   * Replaces the tiles to render whose primitives are still being created
+   * with their nearest ancestor that has been created completely, so that
+   * they do not leave holes until they can be shown.
+   *
+   * The substitutes are removed from the tiles fading out. The tiles they
+   * replace, and the substitutes of the last frame that are no longer
+   * needed, are collected in _tilesReplacedBySubstitutes.
+   *
+   * @param result The result of the view update to change.
+   */
+  void
+  substituteIncompleteTiles(Cesium3DTilesSelection::ViewUpdateResult& result);
+
+  /**
+   * Queues a visibility change for the given glTF, to be applied by
+   * {@link flushTileRenderStates}.
+   */
+  void queueTileVisibility(UCesiumGltfComponent* pGltf, bool visible);
+
+  /**
+   * Queues an update of the LOD transition fade of the given tile, to be
+   * applied by {@link flushTileRenderStates}.
+   */
+  void queueTileFade(Cesium3DTilesSelection::Tile* pTile, bool fadingIn);
+
+  /**
+   * Applies all queued visibility and fade changes at once. Only the last
+   * queued state of each glTF is applied, and only if it differs from the
+   * current one.
+   */
+  void flushTileRenderStates();
+
   /**
    * Will be called after the tileset is loaded or spawned, to register
    * a delegate that calls OnFocusEditorViewportOnThis when this
@@ -1277,8 +1540,73 @@ private:
   // tilesToHideThisFrame may be hidden immediately.
   std::vector<Cesium3DTilesSelection::Tile*> _tilesToHideNextFrame;
 
+  // The tiles rendered this frame, used to remove them from
+  // _tilesToHideNextFrame. It is kept between frames to avoid reallocating.
+  std::unordered_set<Cesium3DTilesSelection::Tile*> _tilesRenderedThisFrame;
+
+  // The actor collision settings that were last applied to the tiles. The
+  // version changes whenever they do, and each tile records the version it
+  // was last updated to.
+  ECollisionChannel _appliedCollisionObjectType = ECC_WorldStatic;
+  FCollisionResponseContainer _appliedCollisionResponses;
+  uint32 _collisionSettingsVersion = 0;
+
+  // The glTFs whose primitives are still being created, in the order their
+  // tiles were loaded, and the recent average frame time used to adapt the
+  // time spent creating them.
+  std::deque<TWeakObjectPtr<UCesiumGltfComponent>> _pendingGltfCreations;
+  float _averageFrameSeconds = 0.0f;
+
+  // The ancestors rendered this frame and the last frame in place of tiles
+  // that are still being created, and the tiles that they replace this frame.
+  // The substitutes of the last frame that are no longer needed, and the
+  // replaced tiles, are hidden in the next frame.
+  std::unordered_set<Cesium3DTilesSelection::Tile*> _substituteTiles;
+  std::unordered_set<Cesium3DTilesSelection::Tile*> _previousSubstituteTiles;
+  std::vector<Cesium3DTilesSelection::Tile*> _tilesReplacedBySubstitutes;
+
+  // The visibility and fade changes queued during a tick. They are applied
+  // together at its end, so that a tile hidden and shown again in the same
+  // tick is not touched at all.
+  struct PendingTileRenderState {
+    UCesiumGltfComponent* pGltf = nullptr;
+    bool hasVisible = false;
+    bool visible = false;
+    bool hasFade = false;
+    float fadePercentage = 1.0f;
+    bool fadingIn = true;
+  };
+  std::vector<PendingTileRenderState> _pendingTileRenderStates;
+  std::unordered_map<UCesiumGltfComponent*, size_t>
+      _pendingTileRenderStateIndices;
+
+  PendingTileRenderState&
+  getPendingTileRenderState(UCesiumGltfComponent* pGltf);
+
   int32 _tilesetsBeingDestroyed;
 
+  // The state of the custom tile culling pass. It is kept between frames so
+  // that the pass does not need to allocate.
+  FNativeTileCullingCallback _nativeTileCullingCallback;
+  std::vector<Cesium3DTilesSelection::Tile*> _tileCullingCandidates;
+  FCesiumTileBoundsBatch _tileCullingBounds;
+  TArray<bool> _tileCullingHasRenderContent;
+  TArray<bool> _tileCullingCulled;
+
+  // The physics meshes built on demand, and the primitives shown this frame
+  // that may need one. The array is kept between frames to avoid
+  // reallocating.
+  TSharedPtr<FCesiumPhysicsMeshCache, ESPMode::ThreadSafe> _pPhysicsMeshCache;
+  TArray<UCesiumGltfPrimitiveComponent*> _physicsMeshCandidates;
+
+  /**
+   * Updates the physics meshes built on demand for the primitives of the
+   * given tiles. Only rendered tiles are given, because the primitives of
+   * other tiles have their collision disabled anyway.
+   */
+  void updatePhysicsMeshCache(
+      const std::vector<Cesium3DTilesSelection::Tile*>& tiles);
+
   friend class UnrealResourcePreparer;
   friend class UCesiumGltfPointsComponent;
 };
@@ -0,0 +1,64 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Components/SceneComponent.h"
+#include "CoreMinimal.h"
+#include "CesiumCollisionInterestComponent.generated.h"
+
+/**
+ * A volume in which tilesets that create physics meshes on demand make sure
+ * the tiles can be collided with. Attach it to the Pawns, vehicles, and other
+ * objects that need to collide with tiles, or place it along the corridor of
+ * frequent traces.
+ *
+ * The volume is a capsule: a sphere of the given Radius, swept from the
+ * component's location along its forward (+X) axis by the given Length.
+ *
+ * @see ACesium3DTileset::CreatePhysicsMeshesOnDemand
+ */
+UCLASS(ClassGroup = "Cesium", Meta = (BlueprintSpawnableComponent))
+class CESIUMRUNTIME_API UCesiumCollisionInterestComponent
+    : public USceneComponent {
+  GENERATED_BODY()
+
+public:
+  UCesiumCollisionInterestComponent();
+
+  /**
+   * The radius of the volume, in Unreal units.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 0.0))
+  double Radius = 10000.0;
+
+  /**
+   * The distance over which the volume extends along the component's forward
+   * axis, in Unreal units. A length of zero makes the volume a sphere.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 0.0))
+  double Length = 0.0;
+
+  /**
+   * @brief Whether the volume intersects the given world-space sphere.
+   */
+  bool Intersects(const FVector& Center, double SphereRadius) const;
+
+  /**
+   * @brief Gets the registered interest components in the given world.
+   */
+  static void GetInterestComponents(
+      const UWorld* World,
+      TArray<const UCesiumCollisionInterestComponent*>& OutComponents);
+
+protected:
+  virtual void OnRegister() override;
+  virtual void OnUnregister() override;
+};
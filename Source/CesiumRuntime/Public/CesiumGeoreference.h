@@ -541,6 +541,150 @@ public:
       const FRotator& EastSouthUpRotator,
       const FVector& UnrealLocation) const;
 
+  /**
+   * Transforms each of the given longitude-latitude-height positions into
+   * Unreal coordinates, like
+   * {@link TransformLongitudeLatitudeHeightPositionToUnreal}. Large arrays are
+   * converted in parallel.
+   */
+  UFUNCTION(
+      BlueprintPure,
+      Category = "Cesium",
+      meta = (ReturnDisplayName = "UnrealPositions"))
+  TArray<FVector> TransformLongitudeLatitudeHeightPositionsToUnreal(
+      const TArray<FVector>& LongitudeLatitudeHeights) const;
+
+  /**
+   * Transforms each of the given positions in Unreal coordinates into
+   * longitude-latitude-height, like
+   * {@link TransformUnrealPositionToLongitudeLatitudeHeight}. Large arrays are
+   * converted in parallel.
+   */
+  UFUNCTION(
+      BlueprintPure,
+      Category = "Cesium",
+      meta = (ReturnDisplayName = "LongitudeLatitudeHeights"))
+  TArray<FVector> TransformUnrealPositionsToLongitudeLatitudeHeight(
+      const TArray<FVector>& UnrealPositions) const;
+
+  /**
+   * Transforms each of the given Earth-Centered, Earth-Fixed positions into
+   * Unreal coordinates, like
+   * {@link TransformEarthCenteredEarthFixedPositionToUnreal}. Large arrays are
+   * converted in parallel.
+   */
+  UFUNCTION(
+      BlueprintPure,
+      Category = "Cesium",
+      meta = (ReturnDisplayName = "UnrealPositions"))
+  TArray<FVector> TransformEarthCenteredEarthFixedPositionsToUnreal(
+      const TArray<FVector>& EarthCenteredEarthFixedPositions) const;
+
+  /**
+   * Transforms each of the given positions in Unreal coordinates into
+   * Earth-Centered, Earth-Fixed coordinates, like
+   * {@link TransformUnrealPositionToEarthCenteredEarthFixed}. Large arrays are
+   * converted in parallel.
+   */
+  UFUNCTION(
+      BlueprintPure,
+      Category = "Cesium",
+      meta = (ReturnDisplayName = "EarthCenteredEarthFixedPositions"))
+  TArray<FVector> TransformUnrealPositionsToEarthCenteredEarthFixed(
+      const TArray<FVector>& UnrealPositions) const;
+
+  /**
+   * Transforms each of the given Rotators from Unreal coordinates into the
+   * East-South-Up frame centered at the location with the same index, like
+   * {@link TransformUnrealRotatorToEastSouthUp}. Large arrays are converted in
+   * parallel.
+   *
+   * If the arrays have different lengths, an empty array is returned.
+   */
+  UFUNCTION(
+      BlueprintPure,
+      Category = "Cesium",
+      meta = (ReturnDisplayName = "EastSouthUpRotators"))
+  TArray<FRotator> TransformUnrealRotatorsToEastSouthUp(
+      const TArray<FRotator>& UnrealRotators,
+      const TArray<FVector>& UnrealLocations) const;
+
+  /**
+   * Transforms each of the given Rotators from the East-South-Up frame
+   * centered at the location with the same index into Unreal coordinates, like
+   * {@link TransformEastSouthUpRotatorToUnreal}. Large arrays are converted in
+   * parallel.
+   *
+   * If the arrays have different lengths, an empty array is returned.
+   */
+  UFUNCTION(
+      BlueprintPure,
+      Category = "Cesium",
+      meta = (ReturnDisplayName = "UnrealRotators"))
+  TArray<FRotator> TransformEastSouthUpRotatorsToUnreal(
+      const TArray<FRotator>& EastSouthUpRotators,
+      const TArray<FVector>& UnrealLocations) const;
+
+  /**
+   * Transforms longitude-latitude-height positions into Unreal coordinates,
+   * writing the result for each input position to the same index of
+   * `UnrealPositions`. Both views must have the same number of elements, and
+   * may be the same view.
+   */
+  void TransformLongitudeLatitudeHeightPositionsToUnreal(
+      TArrayView<const FVector> LongitudeLatitudeHeights,
+      TArrayView<FVector> UnrealPositions) const;
+
+  /**
+   * Transforms positions in Unreal coordinates into longitude-latitude-height,
+   * writing the result for each input position to the same index of
+   * `LongitudeLatitudeHeights`. Both views must have the same number of
+   * elements, and may be the same view.
+   */
+  void TransformUnrealPositionsToLongitudeLatitudeHeight(
+      TArrayView<const FVector> UnrealPositions,
+      TArrayView<FVector> LongitudeLatitudeHeights) const;
+
+  /**
+   * Transforms Earth-Centered, Earth-Fixed positions into Unreal coordinates,
+   * writing the result for each input position to the same index of
+   * `UnrealPositions`. Both views must have the same number of elements, and
+   * may be the same view.
+   */
+  void TransformEarthCenteredEarthFixedPositionsToUnreal(
+      TArrayView<const FVector> EarthCenteredEarthFixedPositions,
+      TArrayView<FVector> UnrealPositions) const;
+
+  /**
+   * Transforms positions in Unreal coordinates into Earth-Centered,
+   * Earth-Fixed coordinates, writing the result for each input position to the
+   * same index of `EarthCenteredEarthFixedPositions`. Both views must have the
+   * same number of elements, and may be the same view.
+   */
+  void TransformUnrealPositionsToEarthCenteredEarthFixed(
+      TArrayView<const FVector> UnrealPositions,
+      TArrayView<FVector> EarthCenteredEarthFixedPositions) const;
+
+  /**
+   * Transforms Rotators from Unreal coordinates into the East-South-Up frames
+   * centered at the locations with the same indices. All views must have the
+   * same number of elements.
+   */
+  void TransformUnrealRotatorsToEastSouthUp(
+      TArrayView<const FRotator> UnrealRotators,
+      TArrayView<const FVector> UnrealLocations,
+      TArrayView<FRotator> EastSouthUpRotators) const;
+
+  /**
+   * Transforms Rotators from the East-South-Up frames centered at the given
+   * locations into Unreal coordinates. All views must have the same number of
+   * elements.
+   */
+  void TransformEastSouthUpRotatorsToUnreal(
+      TArrayView<const FRotator> EastSouthUpRotators,
+      TArrayView<const FVector> UnrealLocations,
+      TArrayView<FRotator> UnrealRotators) const;
+
   /**
    * Computes the transformation matrix from the Unreal coordinate system to the
    * Earth-Centered, Earth-Fixed (ECEF) coordinate system. The Unreal
@@ -0,0 +1,159 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/ArrayView.h"
+#include "CoreMinimal.h"
+#include <string_view>
+
+namespace CesiumGltf {
+struct Model;
+struct PropertyTableProperty;
+} // namespace CesiumGltf
+
+/**
+ * @brief A read-only view of values of type T that are laid out at a constant
+ * stride in memory. The values are read in place, without being copied or
+ * converted.
+ */
+template <typename T> struct TCesiumStridedSpan {
+  /**
+   * @brief The first byte of the first value.
+   */
+  const uint8* Data = nullptr;
+
+  /**
+   * @brief The number of values.
+   */
+  int64 Num = 0;
+
+  /**
+   * @brief The distance in bytes between the starts of consecutive values.
+   */
+  int64 Stride = sizeof(T);
+
+  bool IsEmpty() const { return Num == 0; }
+
+  const T& operator[](int64 Index) const {
+    check(Index >= 0 && Index < Num);
+    return *reinterpret_cast<const T*>(Data + Index * Stride);
+  }
+};
+
+/**
+ * @brief The raw buffers of a property table property in
+ * EXT_structural_metadata, as stored in the glTF.
+ *
+ * These reference the buffers of the glTF model the property table was
+ * created from, so they are only valid while that model is loaded. Values are
+ * stored exactly as in the buffers: the property's normalization, offset,
+ * scale, "no data" value, and default value are not applied.
+ *
+ * Variable-length arrays and strings are stored as offsets into the values.
+ * The offsets of feature i and i + 1 delimit the data of feature i, so there
+ * is one more offset than there are features. All offsets are in bytes. For
+ * arrays of strings, the array offsets index into the string offsets, which in
+ * turn index into the values.
+ */
+struct CESIUMRUNTIME_API FCesiumPropertyTableColumn {
+  /**
+   * @brief Creates an empty column.
+   */
+  FCesiumPropertyTableColumn() = default;
+
+  /**
+   * @brief Creates a column from the buffer views of the given property table
+   * property. Buffer views that do not exist or are out of bounds result in
+   * empty spans.
+   */
+  FCesiumPropertyTableColumn(
+      const CesiumGltf::Model& Model,
+      const CesiumGltf::PropertyTableProperty& Property);
+
+  /**
+   * @brief The bytes of the values buffer view.
+   */
+  TArrayView<const uint8> Values;
+
+  /**
+   * @brief The bytes of the array offsets buffer view, if the property is a
+   * variable-length array.
+   */
+  TArrayView<const uint8> ArrayOffsets;
+
+  /**
+   * @brief The size in bytes of each array offset.
+   */
+  uint8 ArrayOffsetSize = 4;
+
+  /**
+   * @brief The bytes of the string offsets buffer view, if the property is a
+   * string or an array of strings.
+   */
+  TArrayView<const uint8> StringOffsets;
+
+  /**
+   * @brief The size in bytes of each string offset.
+   */
+  uint8 StringOffsetSize = 4;
+
+  /**
+   * @brief Gets the array offset at the given index.
+   */
+  uint64 GetArrayOffset(int64 Index) const {
+    return GetOffset(ArrayOffsets, ArrayOffsetSize, Index);
+  }
+
+  /**
+   * @brief Gets the string offset at the given index.
+   */
+  uint64 GetStringOffset(int64 Index) const {
+    return GetOffset(StringOffsets, StringOffsetSize, Index);
+  }
+
+  /**
+   * @brief Gets the elements of a feature's variable-length array of numeric
+   * values. T must be the element type of the property.
+   */
+  template <typename T> TArrayView<const T> GetArray(int64 FeatureID) const {
+    const uint64 begin = GetArrayOffset(FeatureID);
+    const uint64 end = GetArrayOffset(FeatureID + 1);
+    check(begin <= end && end <= uint64(Values.Num()));
+    return TArrayView<const T>(
+        reinterpret_cast<const T*>(Values.GetData() + begin),
+        int32((end - begin) / sizeof(T)));
+  }
+
+  /**
+   * @brief Gets the UTF-8 value of a feature's string.
+   */
+  std::string_view GetString(int64 FeatureID) const {
+    return GetStringAt(FeatureID);
+  }
+
+  /**
+   * @brief Gets the number of strings in a feature's array of strings.
+   */
+  int64 GetStringArraySize(int64 FeatureID) const {
+    return int64(
+        (GetArrayOffset(FeatureID + 1) - GetArrayOffset(FeatureID)) /
+        StringOffsetSize);
+  }
+
+  /**
+   * @brief Gets the UTF-8 value of a string in a feature's array of strings.
+   */
+  std::string_view GetStringInArray(int64 FeatureID, int64 Index) const {
+    check(Index >= 0 && Index < GetStringArraySize(FeatureID));
+    return GetStringAt(
+        int64(GetArrayOffset(FeatureID) / StringOffsetSize) + Index);
+  }
+
+private:
+  static uint64 GetOffset(
+      const TArrayView<const uint8>& Offsets,
+      uint8 OffsetSize,
+      int64 Index);
+
+  std::string_view GetStringAt(int64 StringIndex) const;
+};
@@ -7,6 +7,8 @@
 #include "CesiumMetadataValue.h"
 #include "CesiumMetadataValueType.h"
 #include "CesiumPropertyArray.h"
+#include "CesiumPropertyTableColumn.h"
+#include "Containers/ArrayView.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "UObject/ObjectMacros.h"
 #include <any>
@@ -107,6 +109,10 @@ private:
   FCesiumMetadataValueType _valueType;
   bool _normalized;
 
+  // Only set for valid properties of a FCesiumPropertyTable.
+  FCesiumPropertyTableColumn _column;
+
+  friend struct FCesiumPropertyTable;
   friend class UCesiumPropertyTablePropertyBlueprintLibrary;
 };
 
@@ -945,6 +951,108 @@ public:
       UPARAM(ref) const FCesiumPropertyTableProperty& Property,
       int64 FeatureID);
 
+  /**
+   * Retrieves the values of the property for several features at once, as
+   * converted by the single-feature getter for the same type, such as
+   * {@link GetInteger} for int32 or {@link GetVector} for FVector. The type of
+   * the property is resolved once for the whole call rather than once per
+   * feature, so this is much faster than calling the single-feature getter in
+   * a loop.
+   *
+   * This is only available from C++. It is instantiated for bool, uint8,
+   * int32, int64, float, double, FIntPoint, FVector2D, FIntVector, FVector3f,
+   * FVector, FVector4, FMatrix, and FString.
+   *
+   * @param FeatureIDs The IDs of the features.
+   * @param OutValues Receives the value of each feature. Must have the same
+   * number of elements as FeatureIDs.
+   * @param DefaultValue The value for features whose ID is out-of-range, or
+   * whose value cannot be converted.
+   */
+  template <typename T>
+  static void GetValues(
+      const FCesiumPropertyTableProperty& Property,
+      TArrayView<const int64> FeatureIDs,
+      TArrayView<T> OutValues,
+      const T& DefaultValue = T());
+
+  /**
+   * Retrieves the values of the property for a contiguous range of features,
+   * starting at FirstFeatureID. This otherwise behaves like the overload of
+   * {@link GetValues} that takes feature IDs.
+   *
+   * @param FirstFeatureID The ID of the feature whose value is written to the
+   * first element of OutValues.
+   * @param OutValues Receives the value of each feature in the range.
+   * @param DefaultValue The value for features whose ID is out-of-range, or
+   * whose value cannot be converted.
+   */
+  template <typename T>
+  static void GetValues(
+      const FCesiumPropertyTableProperty& Property,
+      int64 FirstFeatureID,
+      TArrayView<T> OutValues,
+      const T& DefaultValue = T());
+
+  /**
+   * Gets the raw buffers of the property, for reading whole columns of values
+   * in place. This is only available from C++, and only for properties of a
+   * FCesiumPropertyTable; for other properties, the buffers are empty.
+   *
+   * See {@link GetColumnValues} for a typed view of numeric properties.
+   */
+  static const FCesiumPropertyTableColumn&
+  GetColumn(const FCesiumPropertyTableProperty& Property);
+
+  /**
+   * Gets the raw values of a numeric scalar, vector, or matrix property as a
+   * strided span over the glTF buffer, indexed by feature ID. T must be the
+   * exact type of the property's values, such as uint16_t for a UINT16
+   * scalar or glm::vec3 for a FLOAT32 VEC3. The values are not normalized,
+   * offset, or scaled; use {@link GetValues} for transformed values.
+   *
+   * For fixed-length array properties, the span contains the element at
+   * ArrayIndex of every feature's array. This is only available from C++.
+   *
+   * If the property is not a property of a FCesiumPropertyTable, if T does not
+   * match its type, or if it is a boolean, string, or variable-length array
+   * property, the returned span is empty. Use {@link GetColumn} for strings
+   * and variable-length arrays.
+   *
+   * @param ArrayIndex The index of the element within fixed-length arrays.
+   * Must be zero for other properties.
+   */
+  template <typename T>
+  static TCesiumStridedSpan<T> GetColumnValues(
+      const FCesiumPropertyTableProperty& Property,
+      int64 ArrayIndex = 0) {
+    FCesiumMetadataValueType valueType = TypeToMetadataValueType<T>();
+    if (Property._status != ECesiumPropertyTablePropertyStatus::Valid ||
+        valueType.Type != Property._valueType.Type ||
+        valueType.ComponentType != Property._valueType.ComponentType ||
+        valueType.Type == ECesiumMetadataType::Boolean ||
+        valueType.Type == ECesiumMetadataType::String) {
+      return TCesiumStridedSpan<T>();
+    }
+
+    const int64 arraySize =
+        Property._valueType.bIsArray ? GetArraySize(Property) : 1;
+    if (ArrayIndex < 0 || ArrayIndex >= arraySize) {
+      // Also excludes variable-length arrays, whose array size is zero.
+      return TCesiumStridedSpan<T>();
+    }
+
+    TCesiumStridedSpan<T> span;
+    span.Stride = arraySize * int64(sizeof(T));
+    span.Num = GetPropertySize(Property);
+    if (span.Num * span.Stride > Property._column.Values.Num()) {
+      return TCesiumStridedSpan<T>();
+    }
+    span.Data =
+        Property._column.Values.GetData() + ArrayIndex * int64(sizeof(T));
+    return span;
+  }
+
   PRAGMA_DISABLE_DEPRECATION_WARNINGS
   /**
    * Retrieves the value of the property for the given feature. This allows the
@@ -4,10 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "Stats/Stats.h"
 #include <memory>
 
 class ACesium3DTileset;
 class UCesiumRasterOverlay;
+class UnrealAssetAccessor;
+class UnrealTaskProcessor;
 
 namespace CesiumAsync {
 class AsyncSystem;
@@ -16,6 +19,7 @@ class ICacheDatabase;
 } // namespace CesiumAsync
 
 DECLARE_LOG_CATEGORY_EXTERN(LogCesium, Log, All);
+DECLARE_STATS_GROUP(TEXT("Cesium"), STATGROUP_Cesium, STATCAT_Advanced);
 
 class FCesiumRuntimeModule : public IModuleInterface {
 public:
@@ -47,8 +51,24 @@ CESIUMRUNTIME_API extern FCesiumRasterOverlayIonTroubleshooting
     OnCesiumRasterOverlayIonTroubleshooting;
 
 CESIUMRUNTIME_API CesiumAsync::AsyncSystem& getAsyncSystem() noexcept;
+
+/**
+ * Gets the task processor that runs the background tasks of
+ * {@link getAsyncSystem}. Use it to query the per-lane task statistics.
+ */
+CESIUMRUNTIME_API const std::shared_ptr<UnrealTaskProcessor>&
+getTaskProcessor();
+
 CESIUMRUNTIME_API const std::shared_ptr<CesiumAsync::IAssetAccessor>&
 getAssetAccessor();
 
+/**
+ * Gets the accessor that performs the actual network and file requests
+ * underneath the caching layers of {@link getAssetAccessor}. Use it to
+ * re-prioritize or cancel queued requests and to query request statistics.
+ */
+CESIUMRUNTIME_API const std::shared_ptr<UnrealAssetAccessor>&
+getUnrealAssetAccessor();
+
 CESIUMRUNTIME_API std::shared_ptr<CesiumAsync::ICacheDatabase>&
 getCacheDatabase();
@@ -74,4 +74,127 @@ public:
       Category = "Cache",
       meta = (ConfigRestartRequired = true))
   int MaxCacheItems = 4096;
+
+  /**
+   * The maximum size, in megabytes, of the in-memory tier that sits in front
+   * of the Sqlite database. Recently used responses are served from memory
+   * without touching the database. Set to 0 to disable the in-memory tier.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Cache",
+      meta = (ConfigRestartRequired = true, ClampMin = 0))
+  int MemoryCacheSizeMegabytes = 256;
+
+  /**
+   * The maximum size, in megabytes, of responses that may wait to be written
+   * to the Sqlite database by the background writer. When this is exceeded,
+   * responses are written synchronously on the thread that stores them.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Cache",
+      meta = (ConfigRestartRequired = true, ClampMin = 0))
+  int MaxPendingCacheWriteMegabytes = 64;
+
+  /**
+   * The maximum number of responses the background writer hands to the
+   * Sqlite database at once.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Cache",
+      meta = (ConfigRestartRequired = true, ClampMin = 1))
+  int CacheWriteBatchSize = 64;
+
+  /**
+   * The maximum number of tile requests that may be in flight to a single
+   * host at once. Further requests wait in a priority queue, so that the
+   * tiles that are needed most urgently are requested first.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Requests",
+      meta = (ConfigRestartRequired = true, ClampMin = 1))
+  int MaxSimultaneousRequestsPerHost = 20;
+
+  /**
+   * Whether tiles loaded from file:/// URLs are memory-mapped instead of read
+   * into memory. This avoids reading and copying each file, and lets the
+   * operating system page tile data in on demand, which lowers peak memory
+   * use when many tiles of a large local tileset load at once. Files must not
+   * be modified while they are mapped.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Requests",
+      meta = (ConfigRestartRequired = true))
+  bool UseMemoryMappedLocalFiles = false;
+
+  /**
+   * The number of threads in Cesium's worker pool, which decodes tiles and
+   * runs the other background work of Cesium tilesets. Lowering it caps the
+   * CPU time Cesium can use, leaving the rest to the engine's own background
+   * work. If zero, the engine's default number of worker threads is used.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Threading",
+      meta = (ConfigRestartRequired = true, ClampMin = 0))
+  int WorkerThreadCount = 0;
+
+  /**
+   * The maximum number of material instances of unloaded tiles that are kept
+   * for reuse by tiles loaded later. Reusing material instances avoids
+   * creating and garbage collecting one for every primitive while streaming.
+   * If zero, material instances are not reused.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Object Pooling",
+      meta = (ClampMin = 0))
+  int MaximumPooledMaterialInstances = 1024;
+
+  /**
+   * The maximum number of pooled material instances of any one base material,
+   * so that a base material that is no longer used does not fill the pool.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Object Pooling",
+      meta = (ClampMin = 0))
+  int MaximumPooledMaterialInstancesPerMaterial = 256;
+
+  /**
+   * The game-thread time, in milliseconds, that may be spent each frame
+   * releasing the textures, meshes, and physics data of unloaded tiles. Any
+   * remaining objects are released in later frames, so that unloading many
+   * tiles at once, for example after a teleport, does not cause a hitch. At
+   * least one object is released per frame.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Object Lifetime",
+      meta = (ClampMin = 0.0))
+  float DestructionTimeBudgetMilliseconds = 1.0f;
+
+  /**
+   * The maximum number of objects of unloaded tiles whose resources are
+   * released each frame. If zero, only the time budget applies.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Object Lifetime",
+      meta = (ClampMin = 0))
+  int MaximumObjectsDestroyedPerFrame = 0;
 };
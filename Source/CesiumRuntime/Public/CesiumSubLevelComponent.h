@@ -404,5 +404,11 @@ private:
    */
   void _invalidateResolvedGeoreference();
 
+  /**
+   * Tells the sub-level switcher, if any, that the origin, load radius, or
+   * enabled state of this sub-level may have changed.
+   */
+  void _invalidateSwitcherIndex() noexcept;
+
   void PlaceOriginAtEcef(const FVector& NewOriginEcef);
 };
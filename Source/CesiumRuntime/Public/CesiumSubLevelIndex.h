@@ -0,0 +1,65 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Math/Vector.h"
+
+/**
+ * @brief A bounding volume hierarchy over the load spheres of sub-levels, in
+ * Earth-Centered, Earth-Fixed coordinates.
+ *
+ * Each sphere is identified by the index at which it was added. The hierarchy
+ * is built once with {@link Build}, after which {@link FindClosestContaining}
+ * only visits the spheres whose bounds contain the queried position.
+ */
+class CESIUMRUNTIME_API FCesiumSubLevelIndex {
+public:
+  /**
+   * @brief Removes all spheres.
+   */
+  void Reset();
+
+  /**
+   * @brief Adds a sphere. The hierarchy is not valid until the next call to
+   * {@link Build}.
+   *
+   * @return The index of the sphere.
+   */
+  int32 Add(const FVector& Center, double Radius);
+
+  /**
+   * @brief Builds the hierarchy over all added spheres.
+   */
+  void Build();
+
+  int32 Num() const { return this->_centers.Num(); }
+
+  /**
+   * @brief Finds the sphere whose center is closest to the given position,
+   * among the spheres that strictly contain it. Ties go to the sphere that was
+   * added first.
+   *
+   * @return The index of the sphere, or `INDEX_NONE` if no sphere contains the
+   * position.
+   */
+  int32 FindClosestContaining(const FVector& Position) const;
+
+private:
+  struct Node {
+    FVector min;
+    FVector max;
+    // For a leaf, the first entry in _order. For an interior node, the index
+    // of the second child; the first child immediately follows the node.
+    int32 index;
+    // The number of spheres in a leaf, or zero for an interior node.
+    int32 count;
+  };
+
+  int32 _build(int32 begin, int32 end);
+
+  TArray<FVector> _centers;
+  TArray<double> _radii;
+  TArray<int32> _order;
+  TArray<Node> _nodes;
+};
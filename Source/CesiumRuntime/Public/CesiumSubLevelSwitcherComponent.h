@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "CesiumSubLevelIndex.h"
 #include "Components/ActorComponent.h"
 #include "CesiumSubLevelSwitcherComponent.generated.h"
 
@@ -60,6 +61,19 @@ public:
   UFUNCTION(BlueprintCallable, Category = "Cesium|Sub-levels")
   void SetTargetSubLevel(ALevelInstance* LevelInstance) noexcept;
 
+  /**
+   * Finds the enabled sub-level whose origin is closest to the given
+   * Earth-Centered, Earth-Fixed position, among those whose load radius
+   * contains it. Returns nullptr if the position is outside all sub-levels.
+   *
+   * The sub-levels are looked up in a spatial index that is only rebuilt after
+   * a sub-level is registered, unregistered, or changed, so this is cheap
+   * enough to call every frame for many positions.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Sub-levels")
+  ALevelInstance*
+  FindClosestSubLevel(const FVector& EarthCenteredEarthFixedPosition) noexcept;
+
 private:
   // To allow the sub-level to register/unregister itself with the functions
   // below.
@@ -78,12 +92,17 @@ private:
    */
   void UnregisterSubLevel(ALevelInstance* pSubLevel) noexcept;
 
+  // Called when the origin, load radius, or enabled state of a registered
+  // sub-level changes.
+  void InvalidateSubLevelIndex() noexcept;
+
   virtual void TickComponent(
       float DeltaTime,
       enum ELevelTick TickType,
       FActorComponentTickFunction* ThisTickFunction) override;
 
   void _updateSubLevelStateGame();
+  void _buildSubLevelIndex();
 #if WITH_EDITOR
   void _updateSubLevelStateEditor();
 #endif
@@ -107,6 +126,11 @@ private:
   UPROPERTY(DuplicateTransient, TextExportTransient)
   TWeakObjectPtr<ALevelInstance> _pTarget = nullptr;
 
+  // The sub-levels in _subLevelIndex, in the order they were added to it.
+  TArray<TWeakObjectPtr<ALevelInstance>> _indexedSubLevels;
+  FCesiumSubLevelIndex _subLevelIndex;
+  bool _subLevelIndexIsValid = false;
+
   bool _doExtraChecksOnNextTick = false;
   bool _isTransitioningSubLevels = false;
 };
@@ -0,0 +1,71 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Math/Box.h"
+#include "Math/BoxSphereBounds.h"
+#include "Math/Vector.h"
+
+/**
+ * @brief The Unreal world bounds of the tiles considered by a tile culling
+ * pass.
+ *
+ * The bounds are stored as axis-aligned boxes in separate arrays per
+ * component, so that culling tests can evaluate several tiles at once. The
+ * arrays keep their allocation across {@link Reset} calls.
+ */
+struct CESIUMRUNTIME_API FCesiumTileBoundsBatch {
+  TArray<double> CenterX;
+  TArray<double> CenterY;
+  TArray<double> CenterZ;
+  TArray<double> ExtentX;
+  TArray<double> ExtentY;
+  TArray<double> ExtentZ;
+
+  /**
+   * @brief Removes all bounds, keeping room for at least the given number.
+   */
+  void Reset(int32 ExpectedNum = 0);
+
+  /**
+   * @brief Appends the box of the given bounds.
+   *
+   * @return The index of the appended bounds.
+   */
+  int32 Add(const FBoxSphereBounds& Bounds);
+
+  int32 Num() const { return CenterX.Num(); }
+
+  FVector GetCenter(int32 Index) const {
+    return FVector(CenterX[Index], CenterY[Index], CenterZ[Index]);
+  }
+
+  FVector GetExtent(int32 Index) const {
+    return FVector(ExtentX[Index], ExtentY[Index], ExtentZ[Index]);
+  }
+
+  FBox GetBox(int32 Index) const {
+    return FBox::BuildAABB(GetCenter(Index), GetExtent(Index));
+  }
+};
+
+/**
+ * @brief Tests a whole {@link FCesiumTileBoundsBatch} at once.
+ *
+ * Each test reads and writes one flag per tile in `culled`, which must have
+ * the same number of elements as the batch. Tiles that fail the test are
+ * flagged as culled; the flags of the other tiles are left unchanged, so that
+ * several tests can be combined.
+ */
+namespace CesiumTileCulling {
+
+/**
+ * @brief Culls the tiles whose bounds do not intersect the given box.
+ */
+CESIUMRUNTIME_API void cullOutsideBox(
+    const FCesiumTileBoundsBatch& bounds,
+    const FBox& box,
+    TArray<bool>& culled);
+
+} // namespace CesiumTileCulling
@@ -6,13 +6,56 @@
 #include "CesiumAsync/IAssetAccessor.h"
 #include "Containers/UnrealString.h"
 #include "HAL/Platform.h"
+#include <atomic>
 #include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+
+class UnrealAssetArchiveCache;
+class UnrealAssetRequestScheduler;
 
 class CESIUMRUNTIME_API UnrealAssetAccessor
     : public CesiumAsync::IAssetAccessor {
 public:
+  /**
+   * @brief A function that computes the new priority of a queued request.
+   *
+   * It receives the URL of the request and its current priority, and returns
+   * the new priority. Requests with a higher priority are sent first. If it
+   * returns `std::nullopt`, the request is no longer wanted and is cancelled;
+   * its future is rejected without the request ever being sent.
+   *
+   * The function is called from {@link tick} while the scheduler is locked,
+   * so it must not call back into the accessor.
+   */
+  using PriorityFunction = std::function<
+      std::optional<double>(const std::string& url, double currentPriority)>;
+
+  /**
+   * @brief A snapshot of the request scheduler counters.
+   */
+  struct RequestStatistics {
+    /** @brief The number of requests waiting to be sent. */
+    int32 queued = 0;
+    /** @brief The number of requests that have been sent but not completed. */
+    int32 inFlight = 0;
+    /** @brief The total number of requests that have completed. */
+    int64 completed = 0;
+    /** @brief The total number of queued requests that were cancelled. */
+    int64 cancelled = 0;
+  };
+
   UnrealAssetAccessor();
 
+  /**
+   * @brief Gets the content at the given URL.
+   *
+   * A file:/// URL with a path segment ending in `.3tz`, such as
+   * `file:///C:/data/city.3tz/tileset.json`, is read from within that 3D
+   * Tiles archive. Each archive is opened and indexed once, and stays
+   * memory-mapped for as long as this accessor exists.
+   */
   virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
   get(const CesiumAsync::AsyncSystem& asyncSystem,
       const std::string& url,
@@ -27,8 +70,59 @@ public:
       const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
       const gsl::span<const std::byte>& contentPayload) override;
 
+  /**
+   * @brief Ticks the HTTP manager, re-evaluates the priorities of queued
+   * requests, and sends as many queued requests as the per-host limit allows.
+   */
   virtual void tick() noexcept override;
 
+  /**
+   * @brief Sets the maximum number of GET requests that may be in flight to a
+   * single host at once. Further requests are queued by priority.
+   */
+  void setMaximumRequestsPerHost(int32 maximumRequestsPerHost);
+
+  /**
+   * @brief Sets whether file:/// URLs are memory-mapped instead of read into
+   * memory. The mapping stays alive for as long as the response does.
+   * Requests that were already issued are not affected.
+   */
+  void setUseMemoryMappedFiles(bool useMemoryMappedFiles);
+
+  /**
+   * @brief Sets the function used to re-prioritize, or cancel, queued
+   * requests every {@link tick}. Pass an empty function to keep priorities
+   * unchanged.
+   *
+   * Until a request is re-prioritized, its priority is the frame number in
+   * which it was issued, so that the newest requests - which are the most
+   * likely to still be in view - are sent first.
+   *
+   * Tilesets do not install a priority function or cancel requests
+   * themselves, because the requests they issue are not mapped back to tiles
+   * here. Applications that know which URLs are still wanted can install one.
+   */
+  void setPriorityFunction(PriorityFunction priorityFunction);
+
+  /**
+   * @brief Sets the priority of all queued requests for the given URL.
+   */
+  void setRequestPriority(const std::string& url, double priority);
+
+  /**
+   * @brief Cancels all queued requests for the given URL. Requests that have
+   * already been sent are not affected.
+   *
+   * @return The number of requests that were cancelled.
+   */
+  int32 cancelRequest(const std::string& url);
+
+  /**
+   * @brief Gets a snapshot of the queue depth, in-flight, completed, and
+   * cancelled request counters.
+   */
+  RequestStatistics getRequestStatistics() const;
+
 private:
   CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>> getFromFile(
       const CesiumAsync::AsyncSystem& asyncSystem,
@@ -37,4 +131,7 @@ private:
 
   FString _userAgent;
   TMap<FString, FString> _cesiumRequestHeaders;
+  std::shared_ptr<UnrealAssetRequestScheduler> _pScheduler;
+  std::shared_ptr<UnrealAssetArchiveCache> _pArchives;
+  std::atomic<bool> _useMemoryMappedFiles;
 };
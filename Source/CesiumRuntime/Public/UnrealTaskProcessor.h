@@ -4,9 +4,110 @@
 
 #include "CesiumAsync/ITaskProcessor.h"
 #include "HAL/Platform.h"
+#include <memory>
 
+class UnrealTaskWorkerPool;
+
+/**
+ * @brief Runs cesium-native's background tasks on a dedicated pool of Cesium
+ * worker threads.
+ *
+ * Each task runs in one of three priority lanes. Idle workers take tasks from
+ * the highest-priority lane that has any, first from their own queue and
+ * then by stealing from other workers. A task runs in the lane that was
+ * current on the thread that started it: {@link ScopedLane} selects the lane
+ * on a thread, and continuations started from within a task stay in that
+ * task's lane. The responses of {@link UnrealAssetAccessor} requests are
+ * processed in the lane the request was made in.
+ */
 class CESIUMRUNTIME_API UnrealTaskProcessor
     : public CesiumAsync::ITaskProcessor {
 public:
+  /**
+   * @brief A task priority lane, from most to least urgent.
+   */
+  enum class Lane : uint8 { High = 0, Normal = 1, Low = 2 };
+
+  /**
+   * @brief The number of lanes.
+   */
+  static constexpr int32 LaneCount = 3;
+
+  /**
+   * @brief A snapshot of the counters of one lane.
+   */
+  struct LaneStatistics {
+    /** @brief The number of tasks waiting for a worker. */
+    int32 queued = 0;
+    /** @brief The number of tasks currently running. */
+    int32 running = 0;
+    /** @brief The total number of tasks that have completed. */
+    int64 completed = 0;
+    /** @brief The average time completed tasks waited for a worker. */
+    double averageWaitMilliseconds = 0.0;
+  };
+
+  /**
+   * @brief Selects the lane of the tasks started on this thread for as long
+   * as it exists.
+   */
+  class CESIUMRUNTIME_API ScopedLane {
+  public:
+    explicit ScopedLane(Lane lane) noexcept;
+    ~ScopedLane() noexcept;
+
+    ScopedLane(const ScopedLane&) = delete;
+    ScopedLane& operator=(const ScopedLane&) = delete;
+
+  private:
+    Lane _previousLane;
+  };
+
+  /**
+   * @brief Creates a task processor and starts its worker threads.
+   *
+   * @param threadCount The number of worker threads. If zero or less, the
+   * engine's default number of worker threads is used.
+   */
+  explicit UnrealTaskProcessor(int32 threadCount = 0);
+  virtual ~UnrealTaskProcessor() noexcept;
+
   virtual void startTask(std::function<void()> f) override;
+
+  /**
+   * @brief Calls `body` once for every index in `[0, count)`, spreading the
+   * calls over the worker threads, and returns when all of them have
+   * completed.
+   *
+   * The calling thread makes calls, too, so this may be used from within a
+   * task without waiting on a busy pool. The helper tasks run in the calling
+   * thread's lane. If any call throws, the first exception is rethrown once
+   * all calls have completed.
+   */
+  void parallelFor(int32 count, const std::function<void(int32)>& body);
+
+  /**
+   * @brief Runs the tasks that are already queued and stops the worker
+   * threads. Tasks started afterward run on the engine's background task
+   * threads instead.
+   */
+  void shutdown();
+
+  /**
+   * @brief Gets the number of worker threads.
+   */
+  int32 getThreadCount() const;
+
+  /**
+   * @brief Gets a snapshot of the counters of the given lane.
+   */
+  LaneStatistics getLaneStatistics(Lane lane) const;
+
+  /**
+   * @brief Gets the lane of the tasks started on the calling thread.
+   */
+  static Lane getCurrentLane() noexcept;
+
+private:
+  std::shared_ptr<UnrealTaskWorkerPool> _pPool;
 };